@@ -19,6 +19,7 @@
 #include <mach/mach_init.h>
 #include <mach/thread_act.h>
 #include <mach/mach_port.h>
+#include <mach/mach_time.h>
 
 #include "common/PrecompiledHeader.h"
 #include "common/PersistentThread.h"
@@ -32,6 +33,12 @@ __forceinline void Threading::Sleep(int ms)
 	usleep(1000 * ms);
 }
 
+void Threading::SleepUntil(u64 ticks)
+{
+	// GetCPUTicks is mach_absolute_time, which is exactly what mach_wait_until takes.
+	mach_wait_until(ticks);
+}
+
 // For use in spin/wait loops, acts as a hint to Intel CPUs and should, in theory
 // improve performance and reduce cpu power consumption.
 __forceinline void Threading::SpinWait()
@@ -121,6 +128,23 @@ void Threading::pxThread::_platform_specific_OnCleanupInThread()
 }
 
 // name can be up to 16 bytes
+// macOS has no way to bind a thread to a processor (thread_policy_set affinity tags are only
+// hints, and are ignored on Apple Silicon), so placement is left to the scheduler.
+std::vector<Threading::CpuTopologyEntry> Threading::GetCpuTopology()
+{
+	return {};
+}
+
+bool Threading::SetCurrentThreadAffinity(const std::vector<u32>& cpus)
+{
+	return false;
+}
+
+int Threading::GetCurrentProcessor()
+{
+	return -1;
+}
+
 void Threading::SetNameOfCurrentThread(const char* name)
 {
 	pthread_setname_np(name);
@@ -202,6 +202,13 @@ namespace HostSys
 
 	extern void Munmap(void* base, size_t size);
 
+	// Maps a whole file into memory, read only.  The mapping stays valid after the file is
+	// closed.  Returns NULL on failure, or if the file is empty.
+	extern void* MapFileReadOnly(const wxString& path, size_t& size);
+
+	// Unmaps a file mapped by MapFileReadOnly
+	extern void UnmapFile(void* base, size_t size);
+
 	template <uint size>
 	void MemProtectStatic(u8 (&arr)[size], const PageProtectionMode& mode)
 	{
@@ -16,7 +16,10 @@
 #if !defined(_WIN32)
 #include <wx/thread.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 #include <signal.h>
+#include <sys/ucontext.h>
 #include <errno.h>
 #include <unistd.h>
 
@@ -30,10 +33,24 @@
 
 extern void SignalExit(int sig);
 
-static const uptr m_pagemask = getpagesize() - 1;
+static uptr GetFaultInstruction(void* context)
+{
+	const ucontext_t* uc = static_cast<const ucontext_t*>(context);
+#if defined(__APPLE__) && defined(__x86_64__)
+	return uc->uc_mcontext->__ss.__rip;
+#elif defined(__APPLE__)
+	return uc->uc_mcontext->__ss.__eip;
+#elif defined(__linux__) && defined(__x86_64__)
+	return uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__linux__)
+	return uc->uc_mcontext.gregs[REG_EIP];
+#else
+	return 0;
+#endif
+}
 
 // Linux implementation of SIGSEGV handler.  Bind it using sigaction().
-static void SysPageFaultSignalFilter(int signal, siginfo_t* siginfo, void*)
+static void SysPageFaultSignalFilter(int signal, siginfo_t* siginfo, void* context)
 {
 	// [TODO] : Add a thread ID filter to the Linux Signal handler here.
 	// Rationale: On windows, the __try/__except model allows per-thread specific behavior
@@ -57,7 +74,7 @@ static void SysPageFaultSignalFilter(int signal, siginfo_t* siginfo, void*)
 	// so for now we lock this exception code unless someone can fix this better...
 	Threading::ScopedLock lock(PageFault_Mutex);
 
-	Source_PageFault->Dispatch(PageFaultInfo((uptr)siginfo->si_addr & ~m_pagemask));
+	Source_PageFault->Dispatch(PageFaultInfo((uptr)siginfo->si_addr, GetFaultInstruction(context)));
 
 	// resumes execution right where we left off (re-executes instruction that
 	// caused the SIGSEGV).
@@ -227,4 +244,32 @@ void HostSys::MemProtect(void* baseaddr, size_t size, const PageProtectionMode&
 				baseaddr, (uptr)baseaddr + size, WX_STR(mode.ToString())));
 	}
 }
+
+void* HostSys::MapFileReadOnly(const wxString& path, size_t& size)
+{
+	const int fd = open(path.ToUTF8(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	void* base = nullptr;
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+	{
+		base = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (base == MAP_FAILED)
+			base = nullptr;
+		else
+			size = st.st_size;
+	}
+
+	close(fd);
+	return base;
+}
+
+void HostSys::UnmapFile(void* base, size_t size)
+{
+	if (!base)
+		return;
+	munmap(base, size);
+}
 #endif
@@ -41,14 +41,16 @@ void InitCPUTicks()
 
 u64 GetTickFrequency()
 {
-	return 1000000; // unix measures in microseconds
+	return 1000000000; // nanoseconds of CLOCK_MONOTONIC
 }
 
+// Monotonic, so that deltas don't jump with the wall clock, and so that Threading::SleepUntil
+// can use the ticks as an absolute deadline.
 u64 GetCPUTicks()
 {
-	struct timeval t;
-	gettimeofday(&t, NULL);
-	return ((u64)t.tv_sec * GetTickFrequency()) + t.tv_usec;
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return ((u64)t.tv_sec * GetTickFrequency()) + t.tv_nsec;
 }
 
 wxString GetOSVersionString()
@@ -17,6 +17,9 @@
 #include <unistd.h>
 #if defined(__linux__)
 #include <sys/prctl.h>
+#include <sched.h>
+#include <time.h>
+#include <cstdio>
 #elif defined(__unix__)
 #include <pthread_np.h>
 #endif
@@ -42,6 +45,18 @@ __forceinline void Threading::Sleep(int ms)
 	usleep(1000 * ms);
 }
 
+void Threading::SleepUntil(u64 ticks)
+{
+	// GetCPUTicks is CLOCK_MONOTONIC in nanoseconds, so it can be handed over as is.  Sleeping
+	// to an absolute time means an interrupted sleep can simply be restarted.
+	struct timespec deadline;
+	deadline.tv_sec = ticks / 1000000000;
+	deadline.tv_nsec = ticks % 1000000000;
+
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+		;
+}
+
 // For use in spin/wait loops,  Acts as a hint to Intel CPUs and should, in theory
 // improve performance and reduce cpu power consumption.
 __forceinline void Threading::SpinWait()
@@ -121,6 +136,106 @@ void Threading::pxThread::_platform_specific_OnCleanupInThread()
 	// Cleanup handles here, which were opened above.
 }
 
+#if defined(__linux__)
+// Returns the first number of a sysfs value, which is enough to identify a cpu list like "0-3,8-11"
+static bool read_sysfs_first_number(const char* path, u32* value)
+{
+	FILE* fp = fopen(path, "r");
+	if (!fp)
+		return false;
+
+	unsigned int number;
+	const bool result = fscanf(fp, "%u", &number) == 1;
+	fclose(fp);
+
+	if (result)
+		*value = number;
+	return result;
+}
+#endif
+
+std::vector<Threading::CpuTopologyEntry> Threading::GetCpuTopology()
+{
+	std::vector<CpuTopologyEntry> topology;
+
+#if defined(__linux__)
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+		return topology;
+
+	char path[128];
+	for (u32 cpu = 0; cpu < CPU_SETSIZE; cpu++)
+	{
+		if (!CPU_ISSET(cpu, &allowed))
+			continue;
+
+		// The first sibling identifies the physical core, core_id alone is only unique per package.
+		CpuTopologyEntry entry = {cpu, cpu, 0};
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", cpu);
+		if (!read_sysfs_first_number(path, &entry.core))
+			continue;
+
+		// Last level cache shared by this cpu, the first cpu sharing it identifies the domain.
+		// Fall back to the package if the cache topology isn't exported.
+		bool found_domain = false;
+		u32 best_level = 0;
+		for (u32 index = 0; index < 8; index++)
+		{
+			u32 level;
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", cpu, index);
+			if (!read_sysfs_first_number(path, &level))
+				break;
+
+			u32 domain;
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu, index);
+			if (level > best_level && read_sysfs_first_number(path, &domain))
+			{
+				entry.domain = domain;
+				best_level = level;
+				found_domain = true;
+			}
+		}
+
+		if (!found_domain)
+		{
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", cpu);
+			read_sysfs_first_number(path, &entry.domain);
+		}
+
+		topology.push_back(entry);
+	}
+#endif
+
+	return topology;
+}
+
+bool Threading::SetCurrentThreadAffinity(const std::vector<u32>& cpus)
+{
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (u32 cpu : cpus)
+	{
+		if (cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &set);
+	}
+
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	return false;
+#endif
+}
+
+int Threading::GetCurrentProcessor()
+{
+#if defined(__linux__)
+	return sched_getcpu();
+#else
+	return -1;
+#endif
+}
+
 void Threading::SetNameOfCurrentThread(const char* name)
 {
 #if defined(__linux__)
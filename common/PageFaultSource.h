@@ -31,10 +31,12 @@
 struct PageFaultInfo
 {
 	uptr addr;
+	uptr pc; // host instruction which faulted, 0 when the platform can't tell
 
-	PageFaultInfo(uptr address)
+	PageFaultInfo(uptr address, uptr instruction)
 	{
 		addr = address;
+		pc = instruction;
 	}
 };
 
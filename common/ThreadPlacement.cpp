@@ -0,0 +1,219 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/Threading.h"
+#include "common/Console.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace Threading;
+
+// --------------------------------------------------------------------------------------
+//  Placement plan
+// --------------------------------------------------------------------------------------
+// Computed once from the topology and the policies, and recomputed when a policy changes.
+// Threads pick their processors from it when they start, so a policy change only affects
+// threads started afterwards.
+
+static const char* const s_role_names[] = {"EE Core", "MTGS", "MTVU", "GS Worker", "IO Reader", "DEV9 RX"};
+static_assert(std::size(s_role_names) == static_cast<size_t>(ThreadRole::Count), "Role names don't match the roles");
+
+static ThreadPinPolicy s_policies[static_cast<size_t>(ThreadRole::Count)] = {
+	ThreadPinPolicy::None, // EECore
+	ThreadPinPolicy::None, // MTGS
+	ThreadPinPolicy::None, // MTVU
+	ThreadPinPolicy::None, // GSWorker
+	ThreadPinPolicy::None, // IOReader
+	ThreadPinPolicy::None, // DEV9Rx
+};
+
+namespace
+{
+	struct PlacementPlan
+	{
+		bool valid = false;
+		u32 domain = 0;
+		// Processors of each role, empty when the role isn't pinned.
+		std::vector<u32> cpus[static_cast<size_t>(ThreadRole::Count)];
+	};
+
+	struct PlacedThread
+	{
+		ThreadRole role;
+		int last_cpu;
+		u32 samples;
+		u32 migrations;
+	};
+} // namespace
+
+static std::mutex s_plan_mutex;
+static PlacementPlan s_plan;
+static thread_local PlacedThread* s_current_thread = nullptr;
+
+static std::string FormatCpuList(const std::vector<u32>& cpus)
+{
+	std::string list;
+	for (u32 cpu : cpus)
+	{
+		if (!list.empty())
+			list += ',';
+		list += std::to_string(cpu);
+	}
+	return list;
+}
+
+static void ComputePlan(PlacementPlan& plan)
+{
+	plan = PlacementPlan();
+	plan.valid = true;
+
+	if (std::all_of(std::begin(s_policies), std::end(s_policies), [](ThreadPinPolicy policy) { return policy == ThreadPinPolicy::None; }))
+		return;
+
+	const std::vector<CpuTopologyEntry> topology = GetCpuTopology();
+	if (topology.size() < 2)
+		return;
+
+	// Logical processors of every physical core, per cache domain.
+	std::map<u32, std::map<u32, std::vector<u32>>> domains;
+	for (const CpuTopologyEntry& entry : topology)
+		domains[entry.domain][entry.core].push_back(entry.cpu);
+
+	// Keep everything inside the domain with the most physical cores, so the threads which
+	// exchange data all hit the same L3.
+	auto best = domains.begin();
+	for (auto it = domains.begin(); it != domains.end(); ++it)
+	{
+		if (it->second.size() > best->second.size())
+			best = it;
+	}
+	plan.domain = best->first;
+	const std::map<u32, std::vector<u32>>& cores = best->second;
+
+	// Critical roles get a physical core each, as long as one is left for everything else.
+	u32 reserved = 0;
+	for (ThreadPinPolicy policy : s_policies)
+		reserved += (policy == ThreadPinPolicy::PhysicalCore) ? 1 : 0;
+	const bool reserve_cores = reserved < cores.size();
+
+	std::vector<u32> shared, all;
+	auto core = cores.begin();
+	for (u32 i = 0; i < static_cast<u32>(ThreadRole::Count); i++)
+	{
+		if (s_policies[i] != ThreadPinPolicy::PhysicalCore || !reserve_cores)
+			continue;
+
+		plan.cpus[i] = core->second;
+		++core;
+	}
+	for (; core != cores.end(); ++core)
+		shared.insert(shared.end(), core->second.begin(), core->second.end());
+	for (const auto& it : cores)
+		all.insert(all.end(), it.second.begin(), it.second.end());
+	std::sort(shared.begin(), shared.end());
+	std::sort(all.begin(), all.end());
+
+	// Workers crowded onto a single core would serialize, give them the whole domain instead.
+	if (shared.size() < 2 || cores.size() - (reserve_cores ? reserved : 0) < 2)
+		shared = all;
+
+	for (u32 i = 0; i < static_cast<u32>(ThreadRole::Count); i++)
+	{
+		if (s_policies[i] == ThreadPinPolicy::CacheDomain ||
+			(s_policies[i] == ThreadPinPolicy::PhysicalCore && !reserve_cores))
+		{
+			plan.cpus[i] = shared;
+		}
+	}
+
+	Console.WriteLn("Threading: %zu processors in %zu cache domains, placing threads in domain %u (%zu cores)",
+		topology.size(), domains.size(), plan.domain, cores.size());
+	if (!reserve_cores)
+		Console.Warning("Threading: Not enough cores for %u dedicated threads, sharing the cache domain instead", reserved);
+}
+
+void Threading::SetThreadPinPolicy(ThreadRole role, ThreadPinPolicy policy)
+{
+	std::unique_lock<std::mutex> lock(s_plan_mutex);
+	if (s_policies[static_cast<size_t>(role)] == policy)
+		return;
+
+	s_policies[static_cast<size_t>(role)] = policy;
+	s_plan.valid = false;
+}
+
+ThreadPinPolicy Threading::GetThreadPinPolicy(ThreadRole role)
+{
+	std::unique_lock<std::mutex> lock(s_plan_mutex);
+	return s_policies[static_cast<size_t>(role)];
+}
+
+void Threading::PlaceCurrentThread(ThreadRole role)
+{
+	std::vector<u32> cpus;
+	{
+		std::unique_lock<std::mutex> lock(s_plan_mutex);
+		if (!s_plan.valid)
+			ComputePlan(s_plan);
+		cpus = s_plan.cpus[static_cast<size_t>(role)];
+	}
+
+	const char* name = s_role_names[static_cast<size_t>(role)];
+	if (!cpus.empty())
+	{
+		if (SetCurrentThreadAffinity(cpus))
+			DevCon.WriteLn("Threading: %s placed on processors %s", name, FormatCpuList(cpus).c_str());
+		else
+			Console.Warning("Threading: Failed to place %s on processors %s", name, FormatCpuList(cpus).c_str());
+	}
+
+	// Placement can be called again when a thread is reused, only the last role counts.
+	delete s_current_thread;
+	s_current_thread = new PlacedThread{role, GetCurrentProcessor(), 0, 0};
+}
+
+void Threading::SampleThreadPlacement()
+{
+	PlacedThread* thread = s_current_thread;
+	if (!thread || thread->last_cpu < 0)
+		return;
+
+	const int cpu = GetCurrentProcessor();
+	thread->samples++;
+	if (cpu != thread->last_cpu)
+	{
+		thread->migrations++;
+		thread->last_cpu = cpu;
+	}
+}
+
+void Threading::ReleaseCurrentThread()
+{
+	PlacedThread* thread = s_current_thread;
+	if (!thread)
+		return;
+
+	if (thread->last_cpu >= 0)
+	{
+		DevCon.WriteLn("Threading: %s migrated %u times over %u samples, last on processor %d",
+			s_role_names[static_cast<size_t>(thread->role)], thread->migrations, thread->samples, thread->last_cpu);
+	}
+
+	delete thread;
+	s_current_thread = nullptr;
+}
@@ -23,6 +23,7 @@
 #include <semaphore.h>
 #include <errno.h> // EBUSY
 #include <pthread.h>
+#include <vector>
 #ifdef __APPLE__
 #include <mach/semaphore.h>
 #endif
@@ -181,6 +182,66 @@ namespace Threading
 	// sleeps the current thread for the given number of milliseconds.
 	extern void Sleep(int ms);
 
+	// sleeps the current thread until GetCPUTicks() reaches the given value.  Wakeups can be
+	// late by the scheduler granularity, callers which need better precision spin the rest.
+	extern void SleepUntil(u64 ticks);
+
+	// One entry per logical processor the process is allowed to run on.
+	struct CpuTopologyEntry
+	{
+		u32 cpu; // logical processor number, as used for the affinity
+		u32 core; // physical core, shared by SMT siblings
+		u32 domain; // last level cache domain, shared by the cores of a CCX/die
+	};
+
+	// Returns the host topology, or an empty list if it can't be discovered.
+	extern std::vector<CpuTopologyEntry> GetCpuTopology();
+
+	// Restricts the calling thread to the given logical processors.
+	extern bool SetCurrentThreadAffinity(const std::vector<u32>& cpus);
+
+	// Logical processor the calling thread is running on, or -1 if unknown.
+	extern int GetCurrentProcessor();
+
+	// --------------------------------------------------------------------------------------
+	//  Thread Placement
+	// --------------------------------------------------------------------------------------
+	// Threads which are sensitive to cache locality register their role when they start, and
+	// get placed according to the policy of that role.  All placed threads share the cache
+	// domain with the most cores, and the critical ones get a physical core each so they
+	// never end up on SMT siblings of each other.  Implemented in ThreadPlacement.cpp.
+
+	enum class ThreadRole
+	{
+		EECore,
+		MTGS,
+		MTVU,
+		GSWorker,
+		IOReader,
+		DEV9Rx,
+		Count
+	};
+
+	enum class ThreadPinPolicy
+	{
+		None, // left to the OS scheduler
+		CacheDomain, // any processor of the cache domain which isn't reserved for a physical core
+		PhysicalCore, // a physical core of its own, inside the cache domain
+	};
+
+	extern void SetThreadPinPolicy(ThreadRole role, ThreadPinPolicy policy);
+	extern ThreadPinPolicy GetThreadPinPolicy(ThreadRole role);
+
+	// Applies the policy of the role to the calling thread, and starts tracking its migrations.
+	extern void PlaceCurrentThread(ThreadRole role);
+
+	// Counts a migration if the calling thread moved since the last sample.  Cheap enough to
+	// call once per wakeup of the placed thread.
+	extern void SampleThreadPlacement();
+
+	// Reports the migrations of the calling thread, and stops tracking it.
+	extern void ReleaseCurrentThread();
+
 // pthread Cond is an evil api that is not suited for Pcsx2 needs.
 // Let's not use it. Use mutexes and semaphores instead to create waits. (Air)
 #if 0
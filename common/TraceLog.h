@@ -139,6 +139,9 @@ public:
 
 	bool WriteV(const char* fmt, va_list list) const
 	{
+		if (DoWriteBinary(fmt, list))
+			return false;
+
 		FastFormatAscii ascii;
 		ApplyPrefix(ascii);
 		ascii.WriteV(fmt, list);
@@ -148,6 +151,10 @@ public:
 
 	virtual void ApplyPrefix(FastFormatAscii& ascii) const {}
 	virtual void DoWrite(const char* fmt) const = 0;
+
+	// Lets the log record the unformatted write instead.  Must not touch the va_list when
+	// returning false, since it is then formatted as text.
+	virtual bool DoWriteBinary(const char* fmt, va_list list) const { return false; }
 };
 
 // --------------------------------------------------------------------------------------
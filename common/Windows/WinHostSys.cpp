@@ -27,7 +27,7 @@ static long DoSysPageFaultExceptionFilter(EXCEPTION_POINTERS* eps)
 	// Source_PageFault is a global variable with its own state information
 	// so for now we lock this exception code unless someone can fix this better...
 	Threading::ScopedLock lock(PageFault_Mutex);
-	Source_PageFault->Dispatch(PageFaultInfo((uptr)eps->ExceptionRecord->ExceptionInformation[1]));
+	Source_PageFault->Dispatch(PageFaultInfo((uptr)eps->ExceptionRecord->ExceptionInformation[1], (uptr)eps->ExceptionRecord->ExceptionAddress));
 	return Source_PageFault->WasHandled() ? EXCEPTION_CONTINUE_EXECUTION : EXCEPTION_CONTINUE_SEARCH;
 }
 
@@ -160,4 +160,36 @@ void HostSys::MemProtect(void* baseaddr, size_t size, const PageProtectionMode&
 		pxFailDev(apiError.FormatDiagnosticMessage());
 	}
 }
+
+void* HostSys::MapFileReadOnly(const wxString& path, size_t& size)
+{
+	HANDLE file = CreateFileW(path.wc_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	void* base = nullptr;
+	LARGE_INTEGER file_size;
+	if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+	{
+		// The view keeps the mapping alive, both handles can go.
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping)
+		{
+			base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (base)
+				size = static_cast<size_t>(file_size.QuadPart);
+			CloseHandle(mapping);
+		}
+	}
+
+	CloseHandle(file);
+	return base;
+}
+
+void HostSys::UnmapFile(void* base, size_t size)
+{
+	if (!base)
+		return;
+	UnmapViewOfFile(base);
+}
 #endif
@@ -24,6 +24,39 @@ __fi void Threading::Sleep(int ms)
 	::Sleep(ms);
 }
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+void Threading::SleepUntil(u64 ticks)
+{
+	const u64 now = GetCPUTicks();
+	if (ticks <= now)
+		return;
+
+	// Waitable timers only take absolute times on the system clock, not the performance counter,
+	// so wait for the remaining duration instead.  High resolution timers (Windows 10 1803+)
+	// aren't bound to the timer period set by EnableHiresScheduler.
+	static thread_local HANDLE timer = []() {
+		HANDLE handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		return handle ? handle : CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+	}();
+
+	const s64 remaining = static_cast<s64>(((ticks - now) * 10000000) / GetTickFrequency());
+	if (timer)
+	{
+		LARGE_INTEGER due;
+		due.QuadPart = -remaining; // negative is relative, in 100ns units
+		if (SetWaitableTimerEx(timer, &due, 0, nullptr, nullptr, nullptr, 0))
+		{
+			WaitForSingleObject(timer, INFINITE);
+			return;
+		}
+	}
+
+	::Sleep(static_cast<DWORD>(remaining / 10000));
+}
+
 // For use in spin/wait loops,  Acts as a hint to Intel CPUs and should, in theory
 // improve performance and reduce cpu power consumption.
 __fi void Threading::SpinWait()
@@ -98,6 +131,92 @@ void Threading::pxThread::_platform_specific_OnCleanupInThread()
 	CloseHandle((HANDLE)m_native_handle);
 }
 
+std::vector<Threading::CpuTopologyEntry> Threading::GetCpuTopology()
+{
+	std::vector<CpuTopologyEntry> topology;
+
+	// Only group 0 is described below, placing threads there would leave the other groups idle.
+	if (GetActiveProcessorGroupCount() > 1)
+	{
+		Console.Warning("Threading: Multiple processor groups, threads won't be placed");
+		return topology;
+	}
+
+	DWORD length = 0;
+	GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+		return topology;
+
+	std::vector<u8> buffer(length);
+	if (!GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data()), &length))
+		return topology;
+
+	DWORD_PTR process_mask, system_mask;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+		return topology;
+
+	// SetThreadAffinityMask only reaches the processor group of the thread, so is everything
+	// we can place on.  Cores and caches are numbered by the first processor in their mask.
+	std::vector<KAFFINITY> cores, caches;
+	for (DWORD pos = 0; pos < length;)
+	{
+		const auto* info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + pos);
+		if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0)
+			cores.push_back(info->Processor.GroupMask[0].Mask);
+		else if (info->Relationship == RelationCache && info->Cache.Level == 3 && info->Cache.GroupMask.Group == 0)
+			caches.push_back(info->Cache.GroupMask.Mask);
+		pos += info->Size;
+	}
+
+	for (u32 cpu = 0; cpu < sizeof(KAFFINITY) * 8; cpu++)
+	{
+		const KAFFINITY bit = static_cast<KAFFINITY>(1) << cpu;
+		if (!(process_mask & bit))
+			continue;
+
+		CpuTopologyEntry entry = {cpu, cpu, 0};
+		for (KAFFINITY mask : cores)
+		{
+			if (mask & bit)
+			{
+				unsigned long first;
+				_BitScanForward64(&first, mask);
+				entry.core = first;
+			}
+		}
+		for (KAFFINITY mask : caches)
+		{
+			if (mask & bit)
+			{
+				unsigned long first;
+				_BitScanForward64(&first, mask);
+				entry.domain = first;
+			}
+		}
+
+		topology.push_back(entry);
+	}
+
+	return topology;
+}
+
+bool Threading::SetCurrentThreadAffinity(const std::vector<u32>& cpus)
+{
+	DWORD_PTR mask = 0;
+	for (u32 cpu : cpus)
+	{
+		if (cpu < sizeof(DWORD_PTR) * 8)
+			mask |= static_cast<DWORD_PTR>(1) << cpu;
+	}
+
+	return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
+int Threading::GetCurrentProcessor()
+{
+	return static_cast<int>(GetCurrentProcessorNumber());
+}
+
 void Threading::SetNameOfCurrentThread(const char* name)
 {
 	// This feature needs Windows headers and MSVC's SEH support:
@@ -17,6 +17,7 @@
 #include "IopCommon.h"
 
 #include <memory>
+#include <future>
 #include <ctype.h>
 #include <wx/datetime.h>
 
@@ -380,32 +381,169 @@ s32 cdvdWriteConfig(const u8* config)
 
 static MutexRecursive Mutex_NewDiskCB;
 
+// Mimic PS2 behavior!
+// Much trial-and-error with changing the ISOFS and BOOT2 contents of an image have shown that
+// the PS2 BIOS performs the peculiar task of *ignoring* the version info from the parsed BOOT2
+// filename *and* the ISOFS, when loading the game's ELF image.  What this means is:
+//
+//   1. a valid PS2 ELF can have any version (ISOFS), and the version need not match the one in SYSTEM.CNF.
+//   2. the version info on the file in the BOOT2 parameter of SYSTEM.CNF can be missing, 10 chars long,
+//      or anything else.  Its all ignored.
+//   3. Games loading their own files do *not* exhibit this behavior; likely due to using newer IOP modules
+//      or lower level filesystem APIs (fortunately that doesn't affect us).
+//
+// FIXME: Properly mimicing this behavior is troublesome since we need to add support for "ignoring"
+// version information when doing file searches.  I'll add this later.  For now, assuming a ;1 should
+// be sufficient (no known games have their ELF binary as anything but version ;1)
+static wxString GetFixedElfName(const wxString& filename)
+{
+	return wxStringTokenizer(filename, L';').GetNextToken() + L";1";
+}
+
+// --------------------------------------------------------------------------------------
+//  Boot ELF preload
+// --------------------------------------------------------------------------------------
+// When an ISO is opened, the ELF named by its SYSTEM.CNF is read and CRC'd by a worker thread
+// while the BIOS boots, instead of on the core thread once the BIOS gets to it.  The worker
+// opens the image on its own, since the CDVD source can only be used from one thread.
+//
+namespace
+{
+	class IsoFSImage : public SectorSource
+	{
+	protected:
+		InputIsoFile& m_iso;
+
+	public:
+		IsoFSImage(InputIsoFile& iso)
+			: m_iso(iso)
+		{
+		}
+
+		int getNumSectors() override { return m_iso.GetBlockCount(); }
+
+		bool readSector(unsigned char* buffer, int lba) override
+		{
+			u8 raw[CD_FRAMESIZE_RAW];
+			if (lba < 0 || static_cast<uint>(lba) >= m_iso.GetBlockCount() || m_iso.ReadSync(raw, lba) < 0)
+				return false;
+
+			// Same layout as the CDVD_MODE_2048 reads of the iso source.
+			memcpy(buffer, raw + 24, 2048);
+			return true;
+		}
+	};
+
+	struct PreloadedElf
+	{
+		wxString filename;
+		std::unique_ptr<ElfObject> elf;
+	};
+} // namespace
+
+// Only held while touching s_ElfPreload, never while waiting on it, so a disc swap can't be
+// held up by a preload.
+static Mutex Mutex_ElfPreload;
+static std::future<PreloadedElf> s_ElfPreload; // guarded by Mutex_ElfPreload
+
+static std::future<PreloadedElf> TakeElfPreload()
+{
+	ScopedLock locker(Mutex_ElfPreload);
+	return std::move(s_ElfPreload);
+}
+
+static PreloadedElf PreloadElf(const wxString isofile)
+{
+	PreloadedElf result;
+	const u64 start = GetCPUTicks();
+
+	try
+	{
+		InputIsoFile iso;
+		iso.Open(isofile);
+		IsoFSImage image(iso);
+
+		wxString elfpath;
+		IsoFile cnf(image, L"SYSTEM.CNF;1");
+		while (!cnf.eof())
+		{
+			const ParsedAssignmentString parts(fromUTF8(cnf.readLine().c_str()));
+			if (parts.lvalue == L"BOOT2")
+				elfpath = parts.rvalue;
+		}
+
+		if (elfpath.IsEmpty())
+			return result;
+
+		const wxString fixedname(GetFixedElfName(elfpath));
+		IsoFile file(image, fixedname);
+		result.elf = std::make_unique<ElfObject>(fixedname, file);
+		result.elf->getCRC();
+		result.filename = fixedname;
+	}
+	catch (Exception::BaseException& ex)
+	{
+		DevCon.Warning(L"(LoadELF) Preloading the boot ELF failed: " + ex.FormatDiagnosticMessage());
+		result.elf.reset();
+		return result;
+	}
+
+	DevCon.WriteLn(Color_Green, L"(LoadELF) Preloaded %s in %u ms", WX_STR(result.filename),
+		static_cast<u32>((GetCPUTicks() - start) * 1000 / GetTickFrequency()));
+	return result;
+}
+
+void cdvdPreloadElf(const wxString& isofile)
+{
+	// Compressed images may write their index files the first time they're opened, leave them
+	// to the CDVD source.
+	if (std::unique_ptr<AsyncFileReader>(CompressedFileReader::GetNewReader(isofile)))
+		return;
+
+	std::future<PreloadedElf> previous(TakeElfPreload());
+	if (previous.valid())
+		previous.wait();
+
+	ScopedLock locker(Mutex_ElfPreload);
+	s_ElfPreload = std::async(std::launch::async, PreloadElf, isofile);
+}
+
+void cdvdDiscardElfPreload()
+{
+	std::future<PreloadedElf> preload(TakeElfPreload());
+	if (preload.valid())
+		preload.get();
+}
+
+// Returns the preloaded ELF if it's the one wanted, waiting for the preload to finish first.
+// Either way the preload is used up.
+static std::unique_ptr<ElfObject> TakePreloadedElf(const wxString& filename)
+{
+	std::future<PreloadedElf> pending(TakeElfPreload());
+	if (!pending.valid())
+		return nullptr;
+
+	PreloadedElf preload(pending.get());
+	if (preload.filename != filename)
+		return nullptr;
+
+	return std::move(preload.elf);
+}
+
 // Sets ElfCRC to the CRC of the game bound to the CDVD source.
 static __fi ElfObject* loadElf(const wxString filename)
 {
 	if (filename.StartsWith(L"host"))
 		return new ElfObject(filename.After(':'), Path::GetFileSize(filename.After(':')));
 
-	// Mimic PS2 behavior!
-	// Much trial-and-error with changing the ISOFS and BOOT2 contents of an image have shown that
-	// the PS2 BIOS performs the peculiar task of *ignoring* the version info from the parsed BOOT2
-	// filename *and* the ISOFS, when loading the game's ELF image.  What this means is:
-	//
-	//   1. a valid PS2 ELF can have any version (ISOFS), and the version need not match the one in SYSTEM.CNF.
-	//   2. the version info on the file in the BOOT2 parameter of SYSTEM.CNF can be missing, 10 chars long,
-	//      or anything else.  Its all ignored.
-	//   3. Games loading their own files do *not* exhibit this behavior; likely due to using newer IOP modules
-	//      or lower level filesystem APIs (fortunately that doesn't affect us).
-	//
-	// FIXME: Properly mimicing this behavior is troublesome since we need to add support for "ignoring"
-	// version information when doing file searches.  I'll add this later.  For now, assuming a ;1 should
-	// be sufficient (no known games have their ELF binary as anything but version ;1)
-
-	const wxString fixedname(wxStringTokenizer(filename, L';').GetNextToken() + L";1");
+	const wxString fixedname(GetFixedElfName(filename));
 
 	if (fixedname != filename)
 		Console.WriteLn(Color_Blue, "(LoadELF) Non-conforming version suffix detected and replaced.");
 
+	if (std::unique_ptr<ElfObject> preloaded = TakePreloadedElf(fixedname))
+		return preloaded.release();
+
 	IsoFSCDVD isofs;
 	IsoFile file(isofs, fixedname);
 	return new ElfObject(fixedname, file);
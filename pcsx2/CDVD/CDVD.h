@@ -173,6 +173,8 @@ extern u8 cdvdRead(u8 key);
 extern void cdvdWrite(u8 key, u8 rt);
 
 extern void cdvdReloadElfInfo(wxString elfoverride = wxEmptyString);
+extern void cdvdPreloadElf(const wxString& isofile);
+extern void cdvdDiscardElfPreload();
 extern s32 cdvdCtrlTrayOpen();
 extern s32 cdvdCtrlTrayClose();
 
@@ -370,6 +370,9 @@ bool DoCDVDopen()
 
 	int cdtype = DoCDVDdetectDiskType();
 
+	if (m_CurrentSourceType == CDVD_SourceType::Iso && (cdtype == CDVD_TYPE_PS2CD || cdtype == CDVD_TYPE_PS2CDDA || cdtype == CDVD_TYPE_PS2DVD))
+		cdvdPreloadElf(fromUTF8(m_SourceFilename[CurrentSourceType]));
+
 	if (!EmuConfig.CdvdDumpBlocks || (cdtype == CDVD_TYPE_NODISC))
 	{
 		blockDumpFile.Close();
@@ -434,6 +437,8 @@ void DoCDVDclose()
 	CheckNullCDVD();
 	//blockDumpFile.Close();
 
+	cdvdDiscardElfPreload();
+
 	if (CDVD->close != NULL)
 		CDVD->close();
 
@@ -528,6 +533,7 @@ s32 DoCDVDdetectDiskType()
 void DoCDVDresetDiskTypeCache()
 {
 	diskTypeCached = -1;
+	IsoFSCDVD::ClearDirectoryCache();
 }
 
 ////////////////////////////////////////////////////////
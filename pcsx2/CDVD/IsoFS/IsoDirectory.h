@@ -15,17 +15,52 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <wx/hashmap.h>
+
 enum IsoFS_Type
 {
 	FStype_ISO9660 = 1,
 	FStype_Joliet = 2,
 };
 
+// Entries of a directory, with their names hashed for lookups.  Listings aren't modified
+// once built, so they can be shared by all the IsoDirectory objects of a directory.
+struct IsoDirectoryListing
+{
+	std::vector<IsoFileDescriptor> files;
+	std::unordered_map<wxString, int, wxStringHash, wxStringEqual> index;
+};
+
+// Directories already parsed from an image, keyed by the lba of their extent.  Sources which
+// read from a disc that doesn't change under them can keep one of these, so the volume
+// descriptors and directories along a path are only read and parsed once.
+class IsoDirectoryCache
+{
+protected:
+	std::mutex m_lock;
+	bool m_hasRoot = false;
+	IsoFileDescriptor m_root;
+	IsoFS_Type m_fstype = FStype_ISO9660;
+	std::unordered_map<u32, std::shared_ptr<const IsoDirectoryListing>> m_listings;
+
+public:
+	bool FindRoot(IsoFileDescriptor& root, IsoFS_Type& fstype);
+	void SetRoot(const IsoFileDescriptor& root, IsoFS_Type fstype);
+
+	std::shared_ptr<const IsoDirectoryListing> Find(u32 lba);
+	void Add(u32 lba, std::shared_ptr<const IsoDirectoryListing> listing);
+
+	void Clear();
+};
+
 class IsoDirectory
 {
 public:
 	SectorSource& internalReader;
-	std::vector<IsoFileDescriptor> files;
+	std::shared_ptr<const IsoDirectoryListing> m_listing;
 	IsoFS_Type m_fstype;
 
 public:
@@ -54,6 +54,13 @@ IsoDirectory::IsoDirectory(SectorSource& r)
 
 	m_fstype = FStype_ISO9660;
 
+	IsoDirectoryCache* cache = internalReader.getDirectoryCache();
+	if (cache && cache->FindRoot(rootDirEntry, m_fstype))
+	{
+		Init(rootDirEntry);
+		return;
+	}
+
 	while (!done)
 	{
 		u8 sector[2048];
@@ -103,6 +110,8 @@ IsoDirectory::IsoDirectory(SectorSource& r)
 			.SetDiagMsg(L"IsoFS could not find the root directory on the ISO image.");
 
 	DevCon.WriteLn(L"(IsoFS) Filesystem is " + FStype_ToString());
+	if (cache)
+		cache->SetRoot(rootDirEntry, m_fstype);
 	Init(rootDirEntry);
 }
 
@@ -116,10 +125,14 @@ IsoDirectory::IsoDirectory(SectorSource& r, IsoFileDescriptor directoryEntry)
 
 void IsoDirectory::Init(const IsoFileDescriptor& directoryEntry)
 {
+	IsoDirectoryCache* cache = internalReader.getDirectoryCache();
+	if (cache && (m_listing = cache->Find(directoryEntry.lba)))
+		return;
+
 	// parse directory sector
 	IsoFile dataStream(internalReader, directoryEntry);
 
-	files.clear();
+	auto listing = std::make_shared<IsoDirectoryListing>();
 
 	uint remainingSize = directoryEntry.size;
 
@@ -138,24 +151,31 @@ void IsoDirectory::Init(const IsoFileDescriptor& directoryEntry)
 
 		dataStream.read(b + 1, b[0] - 1);
 
-		files.push_back(IsoFileDescriptor(b, b[0]));
+		listing->files.push_back(IsoFileDescriptor(b, b[0]));
 	}
 
 	b[0] = 0;
+
+	// The first entry wins if a name is listed twice, like the linear search used to do.
+	listing->index.reserve(listing->files.size());
+	for (uint i = 0; i < listing->files.size(); i++)
+		listing->index.emplace(listing->files[i].name, i);
+
+	m_listing = std::move(listing);
+	if (cache)
+		cache->Add(directoryEntry.lba, m_listing);
 }
 
 const IsoFileDescriptor& IsoDirectory::GetEntry(int index) const
 {
-	return files[index];
+	return m_listing->files[index];
 }
 
 int IsoDirectory::GetIndexOf(const wxString& fileName) const
 {
-	for (unsigned int i = 0; i < files.size(); i++)
-	{
-		if (files[i].name == fileName)
-			return i;
-	}
+	const auto it = m_listing->index.find(fileName);
+	if (it != m_listing->index.end())
+		return it->second;
 
 	throw Exception::FileNotFound(fileName);
 }
@@ -214,6 +234,49 @@ u32 IsoDirectory::GetFileSize(const wxString& filePath) const
 	return FindFile(filePath).size;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// IsoDirectoryCache
+//////////////////////////////////////////////////////////////////////////
+
+bool IsoDirectoryCache::FindRoot(IsoFileDescriptor& root, IsoFS_Type& fstype)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (!m_hasRoot)
+		return false;
+
+	root = m_root;
+	fstype = m_fstype;
+	return true;
+}
+
+void IsoDirectoryCache::SetRoot(const IsoFileDescriptor& root, IsoFS_Type fstype)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_root = root;
+	m_fstype = fstype;
+	m_hasRoot = true;
+}
+
+std::shared_ptr<const IsoDirectoryListing> IsoDirectoryCache::Find(u32 lba)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	const auto it = m_listings.find(lba);
+	return (it != m_listings.end()) ? it->second : nullptr;
+}
+
+void IsoDirectoryCache::Add(u32 lba, std::shared_ptr<const IsoDirectoryListing> listing)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_listings.emplace(lba, std::move(listing));
+}
+
+void IsoDirectoryCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_hasRoot = false;
+	m_listings.clear();
+}
+
 IsoFileDescriptor::IsoFileDescriptor()
 {
 	lba = 0;
@@ -28,4 +28,9 @@ public:
 	virtual bool readSector(unsigned char* buffer, int lba);
 
 	virtual int getNumSectors();
+
+	// All instances read the current CDVD source and share one cache, which has to be
+	// cleared whenever the media changes.
+	virtual IsoDirectoryCache* getDirectoryCache();
+	static void ClearDirectoryCache();
 };
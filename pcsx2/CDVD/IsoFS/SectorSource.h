@@ -15,10 +15,16 @@
 
 #pragma once
 
+class IsoDirectoryCache;
+
 class SectorSource
 {
 public:
 	virtual int getNumSectors() = 0;
 	virtual bool readSector(unsigned char* buffer, int lba) = 0;
+
+	// Directories parsed from this source, or null if the source doesn't keep them.
+	virtual IsoDirectoryCache* getDirectoryCache() { return nullptr; }
+
 	virtual ~SectorSource() = default;
 };
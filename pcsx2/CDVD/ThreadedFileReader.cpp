@@ -59,6 +59,7 @@ size_t ThreadedFileReader::CopyBlocks(void* dst, const void* src, size_t size) c
 void ThreadedFileReader::Loop()
 {
 	Threading::SetNameOfCurrentThread("ISO Decompress");
+	Threading::PlaceCurrentThread(Threading::ThreadRole::IOReader);
 
 	std::unique_lock<std::mutex> lock(m_mtx);
 
@@ -68,7 +69,12 @@ void ThreadedFileReader::Loop()
 			m_condition.wait(lock);
 
 		if (m_quit)
+		{
+			Threading::ReleaseCurrentThread();
 			return;
+		}
+
+		Threading::SampleThreadPlacement();
 
 		u64 requestOffset = m_requestOffset;
 		u32 requestSize = m_requestSize;
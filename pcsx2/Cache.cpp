@@ -98,6 +98,15 @@ namespace
 		}
 	};
 
+	struct CacheStats
+	{
+		u64 hits;
+		u64 misses;
+		u64 writebacks;
+	};
+
+	static CacheStats stats;
+
 	struct CacheLine
 	{
 		CacheTag& tag;
@@ -119,6 +128,7 @@ namespace
 			CACHE_LOG("Write back at %zx", target);
 			*reinterpret_cast<CacheData*>(target) = data;
 			tag.clearDirty();
+			stats.writebacks++;
 		}
 
 		void load(uptr ppf)
@@ -147,6 +157,7 @@ namespace
 	struct Cache
 	{
 		CacheSet sets[64];
+		u8 mru[64]; // way of each set which was used last
 
 		int setIdxFor(u32 vaddr) const
 		{
@@ -161,25 +172,73 @@ namespace
 
 	static Cache cache;
 
+	// Page ranges last marked in cachedPageMap, so they can be cleared cheaply.
+	static std::vector<std::pair<u32, u32>> cachedRanges;
+
 }
 
+alignas(64) u8 cachedPageMap[0x100000];
+
 void resetCache()
 {
 	memzero(cache);
+	memzero(stats);
 }
 
-static bool findInCache(const CacheSet& set, uptr ppf, int* way)
+// Mirrors what the TLB scan in CheckCache used to test: addresses within PageMask bytes of
+// the physical frame of a cached (mode 3) entry, for every entry but the first.
+void updateCachedPages()
 {
-	auto check = [&](int checkWay) -> bool
+	for (const auto& range : cachedRanges)
+		memset(&cachedPageMap[range.first], 0, range.second - range.first + 1);
+	cachedRanges.clear();
+
+	for (int i = 1; i < 48; i++)
 	{
-		if (!set.tags[checkWay].matches(ppf))
-			return false;
+		auto mark = [&](u32 entryLo, u32 pfn) {
+			if (((entryLo & 0x38) >> 3) != 0x3)
+				return;
 
-		*way = checkWay;
-		return true;
-	};
+			const u32 first = pfn >> 12;
+			const u32 last = static_cast<u32>(std::min<u64>(static_cast<u64>(pfn) + tlb[i].PageMask, 0xffffffffull) >> 12);
+			memset(&cachedPageMap[first], 1, last - first + 1);
+			cachedRanges.emplace_back(first, last);
+		};
+
+		mark(tlb[i].EntryLo1, tlb[i].PFN1);
+		mark(tlb[i].EntryLo0, tlb[i].PFN0);
+	}
+}
 
-	return check(0) || check(1);
+void reportCacheStats()
+{
+	const u64 accesses = stats.hits + stats.misses;
+	if (accesses == 0)
+		return;
+
+	DevCon.WriteLn("EE Cache: %llu accesses, %.2f%% hits, %llu misses, %llu writebacks",
+		accesses, 100.0 * stats.hits / accesses, stats.misses, stats.writebacks);
+	memzero(stats);
+}
+
+static bool findInCache(int setIdx, uptr ppf, int* way)
+{
+	const CacheSet& set = cache.sets[setIdx];
+
+	// Most accesses hit the same line as the last one, look at that way first.
+	const int first = cache.mru[setIdx];
+	if (set.tags[first].matches(ppf))
+	{
+		*way = first;
+		return true;
+	}
+	if (set.tags[first ^ 1].matches(ppf))
+	{
+		*way = first ^ 1;
+		cache.mru[setIdx] = first ^ 1;
+		return true;
+	}
+	return false;
 }
 
 static int getFreeCache(u32 mem, int* way)
@@ -193,15 +252,18 @@ static int getFreeCache(u32 mem, int* way)
 	if((cpuRegs.CP0.n.Config & 0x10000) == 0)
 		CACHE_LOG("Cache off!");
 
-	if (findInCache(set, ppf, way))
+	if (findInCache(setIdx, ppf, way))
 	{
+		stats.hits++;
 		if (set.tags[*way].isLocked())
 			CACHE_LOG("Index %x Way %x Locked!!", setIdx, *way);
 	}
 	else
 	{
+		stats.misses++;
 		int newWay = set.tags[0].lrf() ^ set.tags[1].lrf();
 		*way = newWay;
+		cache.mru[setIdx] = newWay;
 		CacheLine line = cache.lineAt(setIdx, newWay);
 
 		line.writeBackIfNeeded();
@@ -318,7 +380,7 @@ void doCacheHitOp(u32 addr, const char* name, Op op)
 	uptr ppf = vmv.assumePtr(addr);
 	int way;
 
-	if (!findInCache(set, ppf, &way))
+	if (!findInCache(index, ppf, &way))
 	{
 		CACHE_LOG("CACHE %s NO HIT addr %x, index %d, tag0 %zx tag1 %zx", name, addr, index, set.tags[0].rawValue, set.tags[1].rawValue);
 		return;
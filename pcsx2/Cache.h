@@ -19,7 +19,13 @@
 #include "Common.h"
 #include "SingleRegisterTypes.h"
 
+// Non zero for the pages (address >> 12) that a TLB entry marks as cached.  Tested by the
+// recompiler before its direct memory accesses, so keep it a plain byte map.
+extern u8 cachedPageMap[0x100000];
+
 void resetCache();
+void updateCachedPages();
+void reportCacheStats();
 void writeCache8(u32 mem, u8 value);
 void writeCache16(u32 mem, u16 value);
 void writeCache32(u32 mem, u32 value);
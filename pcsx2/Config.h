@@ -18,6 +18,7 @@
 #include "common/emitter/tools.h"
 #include "common/General.h"
 #include "common/Path.h"
+#include "common/Threading.h"
 #include <string>
 
 class SettingsInterface;
@@ -184,19 +185,24 @@ struct TraceLogFilters
 	// so I prefer this to help keep them usable.
 	bool Enabled;
 
+	// Records the logs unformatted to emuLog.trace.gz instead of emuLog.txt, which is much
+	// cheaper for the emulation threads.  Convert with tools/tracedecode.
+	bool Binary;
+
 	TraceFiltersEE EE;
 	TraceFiltersIOP IOP;
 
 	TraceLogFilters()
 	{
 		Enabled = false;
+		Binary = false;
 	}
 
 	void LoadSave(SettingsWrapper& ini);
 
 	bool operator==(const TraceLogFilters& right) const
 	{
-		return OpEqu(Enabled) && OpEqu(EE) && OpEqu(IOP);
+		return OpEqu(Enabled) && OpEqu(Binary) && OpEqu(EE) && OpEqu(IOP);
 	}
 
 	bool operator!=(const TraceLogFilters& right) const
@@ -335,6 +341,11 @@ struct Pcsx2Config
 		double FramerateNTSC{59.94};
 		double FrameratePAL{50.00};
 
+		// Upper bound of the busy wait at the end of each limited frame, in microseconds.  The
+		// limiter sleeps up to the deadline minus its measured wakeup lateness and spins the rest,
+		// lower values save CPU at the cost of pacing accuracy.  0 never spins.
+		int FrameLimitMaxSpinUs{1000};
+
 		AspectRatioType AspectRatio{AspectRatioType::R4_3};
 		FMVAspectRatioSwitchType FMVAspectRatioSwitch{FMVAspectRatioSwitchType::Off};
 
@@ -359,6 +370,7 @@ struct Pcsx2Config
 				   OpEqu(LimitScalar) &&
 				   OpEqu(FramerateNTSC) &&
 				   OpEqu(FrameratePAL) &&
+				   OpEqu(FrameLimitMaxSpinUs) &&
 
 				   OpEqu(FramesToDraw) &&
 				   OpEqu(FramesToSkip) &&
@@ -509,6 +521,33 @@ struct Pcsx2Config
 		}
 	};
 
+	// ------------------------------------------------------------------------
+	// Where the emulator threads run on the host, see Threading::PlaceCurrentThread.
+	// Nothing is pinned unless the user asks for it.
+	struct ThreadPlacementOptions
+	{
+		Threading::ThreadPinPolicy EECore{Threading::ThreadPinPolicy::None};
+		Threading::ThreadPinPolicy MTGS{Threading::ThreadPinPolicy::None};
+		Threading::ThreadPinPolicy MTVU{Threading::ThreadPinPolicy::None};
+		Threading::ThreadPinPolicy GSWorker{Threading::ThreadPinPolicy::None};
+		Threading::ThreadPinPolicy IOReader{Threading::ThreadPinPolicy::None};
+		Threading::ThreadPinPolicy DEV9Rx{Threading::ThreadPinPolicy::None};
+
+		void LoadSave(SettingsWrapper& wrap);
+		// Hands the policies to the placement layer, takes effect for threads started afterwards.
+		void Apply() const;
+
+		bool operator==(const ThreadPlacementOptions& right) const
+		{
+			return OpEqu(EECore) && OpEqu(MTGS) && OpEqu(MTVU) && OpEqu(GSWorker) && OpEqu(IOReader) && OpEqu(DEV9Rx);
+		}
+
+		bool operator!=(const ThreadPlacementOptions& right) const
+		{
+			return !this->operator==(right);
+		}
+	};
+
 	// ------------------------------------------------------------------------
 	struct FilenameOptions
 	{
@@ -576,6 +615,7 @@ struct Pcsx2Config
 	ProfilerOptions Profiler;
 	DebugOptions Debugger;
 	FramerateOptions Framerate;
+	ThreadPlacementOptions ThreadPlacement;
 
 	TraceLogFilters Trace;
 
@@ -30,6 +30,7 @@
 
 #include "ps2/HwInternal.h"
 #include "Sio.h"
+#include "Cache.h"
 
 #ifndef DISABLE_RECORDING
 #	include "Recording/InputRecordingControls.h"
@@ -408,9 +409,117 @@ u32 UpdateVSyncRate()
 	return static_cast<u32>(m_iTicks);
 }
 
+// --------------------------------------------------------------------------------------
+//  Frame pacing statistics
+// --------------------------------------------------------------------------------------
+// Histogram of how far each limited frame deviates from the expected frame time, dumped
+// to the dev log about once a minute.  Cheap enough to be always on.
+struct FramePacingStats
+{
+	static constexpr u32 BucketUs = 10;
+	static constexpr u32 BucketCount = 500; // the last bucket collects everything past 5ms
+
+	u32 Jitter[BucketCount];
+	u32 Frames;
+	u32 Late; // frames which took more than a millisecond longer than expected
+	u64 ActualTicks;
+	u64 ExpectedTicks;
+	u64 SpinTicks;
+	u64 LastFrame;
+
+	void Reset()
+	{
+		memzero(Jitter);
+		Frames = 0;
+		Late = 0;
+		ActualTicks = 0;
+		ExpectedTicks = 0;
+		SpinTicks = 0;
+	}
+
+	// Smallest deviation which the given fraction of frames stay within, in microseconds.
+	u32 Percentile(double fraction) const
+	{
+		const u32 target = static_cast<u32>(std::ceil(Frames * fraction));
+		u32 count = 0;
+		for (u32 i = 0; i < BucketCount; i++)
+		{
+			count += Jitter[i];
+			if (count >= target)
+				return (i + 1) * BucketUs;
+		}
+		return BucketCount * BucketUs;
+	}
+
+	void Add(u64 now, u64 expected)
+	{
+		if (LastFrame != 0)
+		{
+			const u64 freq = GetTickFrequency();
+			const u64 actual = now - LastFrame;
+			const u64 deviation = (actual > expected) ? actual - expected : expected - actual;
+			const u64 deviation_us = (deviation * 1000000) / freq;
+
+			Jitter[std::min<u64>(deviation_us / BucketUs, BucketCount - 1)]++;
+			Late += (actual > expected && deviation_us > 1000) ? 1 : 0;
+			Frames++;
+			ActualTicks += actual;
+			ExpectedTicks += expected;
+
+			if (ExpectedTicks >= freq * 60)
+			{
+				Report();
+				Reset();
+			}
+		}
+		LastFrame = now;
+	}
+
+	void Report() const
+	{
+		const double ms_per_tick = 1000.0 / GetTickFrequency();
+		DevCon.WriteLn("Frame pacing: %u frames, %.3f ms avg (%.3f expected), jitter p50 %u us, p95 %u us, p99 %u us, %u late, %.1f us spun per frame",
+			Frames, ActualTicks * ms_per_tick / Frames, ExpectedTicks * ms_per_tick / Frames,
+			Percentile(0.50), Percentile(0.95), Percentile(0.99), Late, SpinTicks * ms_per_tick * 1000.0 / Frames);
+	}
+};
+
+static FramePacingStats s_pacing;
+
+// Average lateness of the limiter's wakeups, the spin tail covers twice that.
+static s64 s_oversleep = 0;
+
 void frameLimitReset()
 {
 	m_iStart = GetCPUTicks();
+
+	// Time spent paused isn't a frame.
+	s_pacing.LastFrame = 0;
+}
+
+// Waits for the deadline by sleeping up to shortly before it, and spinning off the rest since
+// the OS never wakes us up exactly on time.  How early to wake up is calibrated from how late
+// the previous wakeups were, bounded by FrameLimitMaxSpinUs.
+static void frameLimitWait(u64 deadline)
+{
+	const u64 freq = GetTickFrequency();
+	const s64 max_spin = (static_cast<s64>(std::max(EmuConfig.GS.FrameLimitMaxSpinUs, 0)) * freq) / 1000000;
+	const u64 sleep_until = deadline - std::min(s_oversleep * 2, max_spin);
+
+	if (GetCPUTicks() < sleep_until)
+	{
+		Threading::SleepUntil(sleep_until);
+
+		const u64 woke = GetCPUTicks();
+		const s64 oversleep = (woke > sleep_until) ? static_cast<s64>(woke - sleep_until) : 0;
+		s_oversleep += (oversleep - s_oversleep) / 8;
+	}
+
+	const u64 spin_start = GetCPUTicks();
+	while (GetCPUTicks() < deadline)
+		Threading::SpinWait();
+
+	s_pacing.SpinTicks += GetCPUTicks() - spin_start;
 }
 
 // Convenience function to update UI thread and set patches. 
@@ -428,6 +537,7 @@ static __fi void frameLimit()
 	// Framelimiter off in settings? Framelimiter go brrr.
 	if (!EmuConfig.GS.FrameLimitEnable)
 	{
+		s_pacing.LastFrame = 0;
 		frameLimitUpdateCore();
 		return;
 	}
@@ -441,30 +551,17 @@ static __fi void frameLimit()
 	{
 		// ... Fudge the next frame start over a bit. Prevents fast forward zoomies.
 		m_iStart += (sDeltaTime / m_iTicks) * m_iTicks;
+		s_pacing.Add(iEnd, m_iTicks);
 		frameLimitUpdateCore();
 		return;
 	}
 
-	// Conversion of delta from CPU ticks (microseconds) to milliseconds
-	s32 msec = (int) ((sDeltaTime * -1000) / (s64) GetTickFrequency());
-	
-	// If any integer value of milliseconds exists, sleep it off.
-	// Prior comments suggested that 1-2 ms sleeps were inaccurate on some OSes;
-	// further testing suggests instead that this was utter bullshit. 
-	if (msec > 1)
-	{
-		Threading::Sleep(msec - 1);
-	}
-	
-	// Conversion to milliseconds loses some precision; after sleeping off whole milliseconds,
-	// spin the thread without sleeping until we finally reach our expected end time.
-	while (GetCPUTicks() < uExpectedEnd)
-	{
-		// SKREEEEEEEE
-	}
+	if (sDeltaTime < 0)
+		frameLimitWait(uExpectedEnd);
 
 	// Finally, set our next frame start to when this one ends
 	m_iStart = uExpectedEnd;
+	s_pacing.Add(GetCPUTicks(), m_iTicks);
 	frameLimitUpdateCore();
 }
 
@@ -481,6 +578,7 @@ static __fi void VSyncStart(u32 sCycle)
 
 	frameLimit(); // limit FPS
 	gsPostVsyncStart(); // MUST be after framelimit; doing so before causes funk with frame times!
+	eeBootFrame(); // reports the boot time on the game's first frame
 
 	if(EmuConfig.Trace.Enabled && EmuConfig.Trace.EE.m_EnableAll)
 		SysTrace.EE.Counters.Write( "    ================  EE COUNTER VSYNC START (frame: %d)  ================", g_FrameCount );
@@ -558,6 +656,10 @@ static __fi void VSyncEnd(u32 sCycle)
 	if (!(g_FrameCount % 60))
 		sioNextFrame();
 
+	// Shows how the EE cache is doing every few seconds, when it's emulated (dev builds only)
+	if (CHECK_CACHE && !(g_FrameCount % 300))
+		reportCacheStats();
+
 	// This doesn't seem to be needed here.  Games only seem to break with regard to the
 	// vsyncstart irq.
 	//cpuRegs.eCycle[30] = 2;
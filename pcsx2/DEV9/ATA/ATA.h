@@ -21,9 +21,10 @@
 #include <mutex>
 #include <condition_variable>
 #include <ghc/filesystem.h>
-#include <fstream>
+#include <memory>
 
 #include "DEV9/SimpleQueue.h"
+#include "HddImage.h"
 
 class ATA
 {
@@ -35,7 +36,7 @@ public:
 private:
 	const bool lba48Supported = false;
 
-	std::fstream hddImage;
+	std::unique_ptr<HddImage> hddImage;
 	u64 hddImageSize;
 
 	int pioMode;
@@ -101,15 +102,33 @@ private:
 	bool awaitFlush = false;
 	u8* currentWrite; //array
 	u32 currentWriteLength;
+	u32 currentWriteCapacity;
 	u64 currentWriteSectors;
 
 	struct WriteQueueEntry
 	{
 		u8* data;
 		u32 length;
+		u32 capacity;
 		u64 sector;
 	};
-	SimpleQueue<WriteQueueEntry> writeQueue;
+	static constexpr u32 writeQueueSize = 64;
+	SimpleRingQueue<WriteQueueEntry, writeQueueSize> writeQueue;
+
+	//Buffers already written by the io thread, reused for the next writes
+	struct WriteBuffer
+	{
+		u8* data;
+		u32 capacity;
+	};
+	//Big enough for any non LBA48 DMA write
+	static constexpr u32 writeBufferMinSize = 256 * 512;
+	SimpleRingQueue<WriteBuffer, 16> freeWriteBuffers;
+
+	//Stats, reported on close
+	u32 writeCount = 0;
+	u32 writeBufferAllocs = 0;
+	u32 writeQueueMaxDepth = 0;
 
 	std::thread ioThread;
 	bool ioRunning = false;
@@ -122,6 +141,11 @@ private:
 	std::atomic_bool ioClose{false};
 	bool ioWrite;
 	bool ioRead;
+	//Written to hddImage but not flushed yet, only used by the io thread
+	bool ioWriteUnflushed = false;
+	//Scratch space of IO_Write, only used by the io thread
+	WriteQueueEntry ioWriteBatch[writeQueueSize];
+	std::vector<u8> ioWriteMerged;
 	void (ATA::*waitingCmd)() = nullptr;
 	//Write Buffer(s)
 
@@ -171,6 +195,9 @@ public:
 	//ATAwritePIO;
 
 private:
+	//State
+	bool CreateHDDImage(const ghc::filesystem::path& hddPath);
+
 	//Info
 	void CreateHDDinfo(int sizeMb);
 	void CreateHDDinfoCsum();
@@ -203,6 +230,8 @@ private:
 	void IO_Thread();
 	void IO_Read();
 	bool IO_Write();
+	u8* HDD_GetWriteBuffer(u32 length);
+	void HDD_QueueWrite(const WriteQueueEntry& entry);
 	void HDD_ReadAsync(void (ATA::*drqCMD)());
 	void HDD_ReadSync(void (ATA::*drqCMD)());
 	bool HDD_CanAssessOrSetError();
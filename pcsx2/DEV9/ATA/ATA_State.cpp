@@ -34,21 +34,18 @@ int ATA::Open(ghc::filesystem::path hddPath)
 	CreateHDDinfo(config.HddSize);
 
 	//Open File
-	if (!ghc::filesystem::exists(hddPath))
-	{
-		HddCreate hddCreator;
-		hddCreator.filePath = hddPath;
-		hddCreator.neededSize = config.HddSize;
-		hddCreator.Start();
+	if (!ghc::filesystem::exists(hddPath) && !CreateHDDImage(hddPath))
+		return -1;
 
-		if (hddCreator.errored)
-			return -1;
+	hddImage = HddImage::Open(hddPath);
+	if (hddImage == nullptr)
+	{
+		Console.Error("DEV9: ATA: Failed to open HDD image");
+		return -1;
 	}
-	hddImage = ghc::filesystem::fstream(hddPath, std::ios::in | std::ios::out | std::ios::binary);
 
 	//Store HddImage size for later check
-	hddImage.seekg(0, std::ios::end);
-	hddImageSize = hddImage.tellg();
+	hddImageSize = hddImage->GetSize();
 
 	{
 		std::lock_guard ioSignallock(ioMutex);
@@ -86,14 +83,67 @@ void ATA::Close()
 		abort(); //All data must be written at this point
 	}
 
+	WriteBuffer buffer;
+	while (freeWriteBuffers.Dequeue(&buffer))
+		delete[] buffer.data;
+	ioWriteMerged.clear();
+	ioWriteMerged.shrink_to_fit();
+
+	if (writeCount != 0)
+		DevCon.WriteLn("DEV9: ATA: %u writes, %u write buffers allocated, max write queue depth %u",
+			writeCount, writeBufferAllocs, writeQueueMaxDepth);
+	writeCount = 0;
+	writeBufferAllocs = 0;
+	writeQueueMaxDepth = 0;
+
 	//Close File Handle
-	if (hddImage.is_open())
-		hddImage.close();
+	hddImage.reset();
 
 	delete[] readBuffer;
 	readBuffer = nullptr;
 }
 
+//Images with the .sphdd extension are sparse, next to one named hdd.sphdd
+//hdd.base.raw (or .base.sphdd) is used as a read only base
+//Converting an existing hdd.raw takes a while, so that is only done from the DEV9 settings
+bool ATA::CreateHDDImage(const ghc::filesystem::path& hddPath)
+{
+	if (hddPath.extension() != ".sphdd")
+	{
+		HddCreate hddCreator;
+		hddCreator.filePath = hddPath;
+		hddCreator.neededSize = config.HddSize;
+		hddCreator.Start();
+
+		return !hddCreator.errored;
+	}
+
+	for (const char* baseExtension : {".base.raw", ".base.sphdd"})
+	{
+		ghc::filesystem::path basePath = hddPath;
+		basePath.replace_extension(baseExtension);
+		if (!ghc::filesystem::exists(basePath))
+			continue;
+
+		std::unique_ptr<HddImage> base = HddImage::Open(basePath, true);
+		if (base == nullptr)
+			return false;
+
+		Console.WriteLn("DEV9: ATA: Creating overlay over %s", basePath.u8string().c_str());
+		return HddSparseImage::Create(hddPath, base->GetSize(), basePath);
+	}
+
+	ghc::filesystem::path rawPath = hddPath;
+	rawPath.replace_extension(".raw");
+	if (ghc::filesystem::exists(rawPath))
+	{
+		Console.Error("DEV9: ATA: %s needs converting to a sparse image, press OK in the DEV9 settings to convert it", rawPath.u8string().c_str());
+		return false;
+	}
+
+	return HddSparseImage::Create(hddPath, (u64)config.HddSize * 1024 * 1024);
+}
+
 void ATA::ResetBegin()
 {
 	PreCmdExecuteDeviceDiag();
@@ -281,7 +331,7 @@ void ATA::Write16(u32 addr, u16 value)
 
 void ATA::Async(uint cycles)
 {
-	if (!hddImage.is_open())
+	if (hddImage == nullptr)
 		return;
 
 	if ((regStatus & (ATA_STAT_BUSY | ATA_STAT_DRQ)) == 0 ||
@@ -15,6 +15,8 @@
 
 #include "PrecompiledHeader.h"
 
+#include <vector>
+
 #include "ATA.h"
 #include "DEV9/DEV9.h"
 
@@ -73,14 +75,12 @@ void ATA::IO_Read()
 	}
 
 	const u64 pos = lba * 512;
-	hddImage.seekg(pos, std::ios::beg);
-	if (hddImage.fail())
+	if (!hddImage->Read(pos, readBuffer, (u32)nsector * 512))
 	{
 		Console.Error("DEV9: ATA: File read error");
 		pxAssert(false);
 		abort();
 	}
-	hddImage.read((char*)readBuffer, (u64)nsector * 512);
 	{
 		std::lock_guard ioSignallock(ioMutex);
 		ioRead = false;
@@ -89,27 +89,110 @@ void ATA::IO_Read()
 
 bool ATA::IO_Write()
 {
-	WriteQueueEntry entry;
-	if (!writeQueue.Dequeue(&entry))
+	const u32 count = writeQueue.DequeueBatch(ioWriteBatch, writeQueueSize);
+	if (count == 0)
 	{
+		//Queue drained, flush everything written since the last time at once
+		if (ioWriteUnflushed)
+		{
+			if (!hddImage->Flush())
+			{
+				Console.Error("DEV9: ATA: File write error");
+				pxAssert(false);
+				abort();
+			}
+			ioWriteUnflushed = false;
+		}
+
 		std::lock_guard ioSignallock(ioMutex);
 		ioWrite = false;
 		return false;
 	}
 
-	hddImage.seekp(entry.sector * 512, std::ios::beg);
-	hddImage.write((char*)entry.data, entry.length);
-	if (hddImage.fail())
+	//Take everything queued so far, and merge writes to consecutive sectors
+	const WriteQueueEntry* entries = ioWriteBatch;
+	for (u32 i = 0; i < count;)
 	{
-		Console.Error("DEV9: ATA: File write error");
-		pxAssert(false);
-		abort();
+		u32 end = i + 1;
+		u64 length = entries[i].length;
+		while (end < count && entries[end].sector * 512 == entries[i].sector * 512 + length)
+			length += entries[end++].length;
+
+		const u8* data = entries[i].data;
+		if (end - i > 1)
+		{
+			if (ioWriteMerged.size() < length)
+				ioWriteMerged.resize(length);
+			u64 offset = 0;
+			for (u32 j = i; j < end; j++)
+			{
+				memcpy(&ioWriteMerged[offset], entries[j].data, entries[j].length);
+				offset += entries[j].length;
+			}
+			data = ioWriteMerged.data();
+		}
+
+		if (!hddImage->Write(entries[i].sector * 512, data, (u32)length))
+		{
+			Console.Error("DEV9: ATA: File write error");
+			pxAssert(false);
+			abort();
+		}
+
+		//Hand the buffers back for reuse, unless enough are spare already
+		for (u32 j = i; j < end; j++)
+		{
+			if (!freeWriteBuffers.Enqueue({entries[j].data, entries[j].capacity}))
+				delete[] entries[j].data;
+		}
+		i = end;
+	}
+
+	//Don't hold on to the buffer after an unusually large merge
+	if (ioWriteMerged.size() > writeBufferMinSize * writeQueueSize)
+	{
+		ioWriteMerged.clear();
+		ioWriteMerged.shrink_to_fit();
 	}
-	hddImage.flush();
-	delete[] entry.data;
+
+	ioWriteUnflushed = true;
 	return true;
 }
 
+u8* ATA::HDD_GetWriteBuffer(u32 length)
+{
+	WriteBuffer buffer;
+	while (freeWriteBuffers.Dequeue(&buffer))
+	{
+		if (buffer.capacity >= length)
+		{
+			currentWriteCapacity = buffer.capacity;
+			return buffer.data;
+		}
+		delete[] buffer.data;
+	}
+
+	writeBufferAllocs++;
+	currentWriteCapacity = std::max(length, writeBufferMinSize);
+	return new u8[currentWriteCapacity];
+}
+
+void ATA::HDD_QueueWrite(const WriteQueueEntry& entry)
+{
+	writeCount++;
+	while (!writeQueue.Enqueue(entry))
+	{
+		//Queue full, wait for the io thread to catch up
+		{
+			std::lock_guard ioSignallock(ioMutex);
+			ioWrite = true;
+		}
+		ioReady.notify_all();
+		std::this_thread::yield();
+	}
+	writeQueueMaxDepth = std::max(writeQueueMaxDepth, writeQueue.GetDepth());
+}
+
 void ATA::HDD_ReadAsync(void (ATA::*drqCMD)())
 {
 	nsectorLeft = 0;
@@ -49,7 +49,7 @@ void ATA::DRQCmdDMADataFromHost()
 		return;
 
 	nsectorLeft = nsector;
-	currentWrite = new u8[nsector * 512];
+	currentWrite = HDD_GetWriteBuffer(nsector * 512);
 	currentWriteLength = nsector * 512;
 	currentWriteSectors = HDD_GetLBA();
 
@@ -65,10 +65,12 @@ void ATA::PostCmdDMADataFromHost()
 	WriteQueueEntry entry{0};
 	entry.data = currentWrite;
 	entry.length = currentWriteLength;
+	entry.capacity = currentWriteCapacity;
 	entry.sector = currentWriteSectors;
-	writeQueue.Enqueue(entry);
+	HDD_QueueWrite(entry);
 	currentWrite = nullptr;
 	currentWriteLength = 0;
+	currentWriteCapacity = 0;
 	currentWriteSectors = 0;
 	nsectorLeft = 0;
 
@@ -17,6 +17,7 @@
 
 #include <fstream>
 #include "HddCreate.h"
+#include "HddImage.h"
 
 void HddCreate::Start()
 {
@@ -31,10 +32,21 @@ void HddCreate::Start()
 		return;
 	}
 
+	const wxString title = convertPath.empty() ? _("Creating HDD file") : _("Converting HDD file");
+	if (!convertPath.empty())
+	{
+		std::error_code ec;
+		const u64 rawSize = ghc::filesystem::file_size(convertPath, ec);
+		neededSize = ec ? 0 : (int)((rawSize + 1024 * 1024 - 1) / (1024 * 1024));
+	}
+
 	//This creates a modeless dialog
-	progressDialog = new wxProgressDialog(_("Creating HDD file"), _("Creating HDD file"), neededSize, nullptr, wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME);
+	progressDialog = new wxProgressDialog(title, title, neededSize, nullptr, wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME);
 
-	fileThread = std::thread(&HddCreate::WriteImage, this, filePath, neededSize);
+	if (convertPath.empty())
+		fileThread = std::thread(&HddCreate::WriteImage, this, filePath, neededSize);
+	else
+		fileThread = std::thread(&HddCreate::ConvertImage, this, convertPath, filePath);
 
 	//This code was written for a modal dialog, however wxProgressDialog is modeless only
 	//The idea was block here in a ShowModal() call, and have the worker thread update the UI
@@ -138,6 +150,28 @@ void HddCreate::WriteImage(ghc::filesystem::path hddPath, int reqSizeMiB)
 	newImage.close();
 }
 
+void HddCreate::ConvertImage(ghc::filesystem::path rawPath, ghc::filesystem::path hddPath)
+{
+	lastUpdate = std::chrono::steady_clock::now();
+
+	const bool converted = HddSparseImage::Convert(rawPath, hddPath, [&](u64 done, u64 total) {
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUpdate).count() >= 100)
+		{
+			lastUpdate = now;
+			SetFileProgress((int)(done / (1024 * 1024)));
+		}
+		return !canceled.load();
+	});
+
+	if (!converted)
+	{
+		SetError();
+		return;
+	}
+	SetFileProgress(neededSize);
+}
+
 void HddCreate::SetFileProgress(int currentSize)
 {
 	written.store(currentSize);
@@ -29,6 +29,8 @@ class HddCreate
 public:
 	ghc::filesystem::path filePath;
 	int neededSize;
+	//Raw image to convert into a sparse image at filePath, instead of creating an empty image
+	ghc::filesystem::path convertPath;
 
 	std::atomic_bool errored{false};
 
@@ -53,4 +55,5 @@ private:
 	void SetFileProgress(int currentSize);
 	void SetError();
 	void WriteImage(ghc::filesystem::path hddPath, int reqSizeMB);
+	void ConvertImage(ghc::filesystem::path rawPath, ghc::filesystem::path hddPath);
 };
@@ -0,0 +1,408 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+
+#include <algorithm>
+#include "HddImage.h"
+
+constexpr char HddSparseImage::Magic[8];
+
+std::unique_ptr<HddImage> HddImage::Open(const ghc::filesystem::path& path, bool readOnly)
+{
+	std::vector<ghc::filesystem::path> chain;
+	return Open(path, readOnly, chain);
+}
+
+std::unique_ptr<HddImage> HddImage::Open(const ghc::filesystem::path& path, bool readOnly, std::vector<ghc::filesystem::path>& chain)
+{
+	if (HddSparseImage::IsSparseImage(path))
+	{
+		std::unique_ptr<HddSparseImage> image = std::make_unique<HddSparseImage>();
+		if (!image->Open(path, readOnly, chain))
+			return nullptr;
+		return image;
+	}
+	else
+	{
+		std::unique_ptr<HddRawImage> image = std::make_unique<HddRawImage>();
+		if (!image->Open(path, readOnly))
+			return nullptr;
+		return image;
+	}
+}
+
+bool HddRawImage::Open(const ghc::filesystem::path& path, bool readOnly)
+{
+	file = ghc::filesystem::fstream(path, readOnly ? (std::ios::in | std::ios::binary) : (std::ios::in | std::ios::out | std::ios::binary));
+	if (file.fail())
+		return false;
+
+	file.seekg(0, std::ios::end);
+	size = file.tellg();
+	return true;
+}
+
+u64 HddRawImage::GetSize()
+{
+	return size;
+}
+
+bool HddRawImage::Read(u64 offset, u8* data, u32 length)
+{
+	file.seekg(offset, std::ios::beg);
+	if (file.fail())
+		return false;
+
+	file.read((char*)data, length);
+	return !file.fail();
+}
+
+bool HddRawImage::Write(u64 offset, const u8* data, u32 length)
+{
+	file.seekp(offset, std::ios::beg);
+	file.write((const char*)data, length);
+	return !file.fail();
+}
+
+bool HddRawImage::Flush()
+{
+	file.flush();
+	return !file.fail();
+}
+
+bool HddSparseImage::IsSparseImage(const ghc::filesystem::path& path)
+{
+	std::fstream file = ghc::filesystem::fstream(path, std::ios::in | std::ios::binary);
+	char magic[sizeof(Magic)];
+	file.read(magic, sizeof(magic));
+	return !file.fail() && memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+u64 HddSparseImage::GetDataOffset(u32 blockCount)
+{
+	//Keep data blocks aligned to 4KiB
+	const u64 mapEnd = sizeof(Header) + (u64)blockCount * sizeof(u32);
+	return (mapEnd + 4095) & ~4095ull;
+}
+
+bool HddSparseImage::Create(const ghc::filesystem::path& path, u64 size, const ghc::filesystem::path& basePath)
+{
+	if (ghc::filesystem::exists(path))
+		return false;
+
+	Header newHeader;
+	memset(&newHeader, 0, sizeof(newHeader));
+	memcpy(newHeader.magic, Magic, sizeof(Magic));
+	newHeader.version = Version;
+	newHeader.blockSize = BlockSize;
+	newHeader.size = size;
+	newHeader.blockCount = (u32)((size + BlockSize - 1) / BlockSize);
+
+	if (!basePath.empty())
+	{
+		//Stored relative to the overlay, so both can be moved together
+		const std::string base = basePath.parent_path() == path.parent_path() ? basePath.filename().u8string() : basePath.u8string();
+		if (base.size() >= sizeof(newHeader.basePath))
+		{
+			Console.Error("DEV9: ATA: Base image path too long");
+			return false;
+		}
+		strcpy(newHeader.basePath, base.c_str());
+	}
+
+	std::fstream newImage = ghc::filesystem::fstream(path, std::ios::out | std::ios::binary);
+	if (newImage.fail())
+		return false;
+
+	newImage.write((const char*)&newHeader, sizeof(newHeader));
+
+	//Empty block map, plus padding up to the data area
+	const std::vector<char> zero(GetDataOffset(newHeader.blockCount) - sizeof(newHeader), 0);
+	newImage.write(zero.data(), zero.size());
+
+	if (newImage.fail())
+	{
+		newImage.close();
+		ghc::filesystem::remove(path);
+		return false;
+	}
+
+	newImage.close();
+	return true;
+}
+
+bool HddSparseImage::Convert(const ghc::filesystem::path& rawPath, const ghc::filesystem::path& sparsePath,
+	const std::function<bool(u64, u64)>& progress)
+{
+	HddRawImage raw;
+	if (!raw.Open(rawPath, true))
+		return false;
+
+	if (!Create(sparsePath, raw.GetSize()))
+		return false;
+
+	HddSparseImage sparse;
+	if (!sparse.Open(sparsePath, false))
+	{
+		ghc::filesystem::remove(sparsePath);
+		return false;
+	}
+
+	Console.WriteLn("DEV9: ATA: Converting %s to a sparse image", rawPath.u8string().c_str());
+
+	std::vector<u8> block(BlockSize);
+	for (u64 offset = 0; offset < raw.GetSize(); offset += BlockSize)
+	{
+		if (progress && !progress(offset, raw.GetSize()))
+		{
+			Console.WriteLn("DEV9: ATA: Conversion canceled");
+			sparse.file.close();
+			ghc::filesystem::remove(sparsePath);
+			return false;
+		}
+
+		const u32 length = (u32)std::min<u64>(BlockSize, raw.GetSize() - offset);
+		if (!raw.Read(offset, block.data(), length))
+		{
+			sparse.file.close();
+			ghc::filesystem::remove(sparsePath);
+			return false;
+		}
+
+		if (std::all_of(block.begin(), block.begin() + length, [](u8 b) { return b == 0; }))
+			continue;
+
+		if (!sparse.Write(offset, block.data(), length))
+		{
+			sparse.file.close();
+			ghc::filesystem::remove(sparsePath);
+			return false;
+		}
+	}
+
+	if (!sparse.Flush())
+	{
+		sparse.file.close();
+		ghc::filesystem::remove(sparsePath);
+		return false;
+	}
+
+	Console.WriteLn("DEV9: ATA: %u of %u blocks allocated", sparse.allocatedBlocks, sparse.header.blockCount);
+	return true;
+}
+
+bool HddSparseImage::Open(const ghc::filesystem::path& path, bool readOnly)
+{
+	std::vector<ghc::filesystem::path> chain;
+	return Open(path, readOnly, chain);
+}
+
+bool HddSparseImage::Open(const ghc::filesystem::path& path, bool readOnly, std::vector<ghc::filesystem::path>& chain)
+{
+	//Each base is opened recursively, so refuse loops and overly deep chains
+	std::error_code ec;
+	ghc::filesystem::path canonicalPath = ghc::filesystem::weakly_canonical(path, ec);
+	if (ec)
+		canonicalPath = path;
+	if (std::find(chain.begin(), chain.end(), canonicalPath) != chain.end())
+	{
+		Console.Error("DEV9: ATA: Sparse image %s is used as its own base", path.u8string().c_str());
+		return false;
+	}
+	if (chain.size() >= MaxBaseDepth)
+	{
+		Console.Error("DEV9: ATA: More than %u base images stacked, stopping at %s", MaxBaseDepth, path.u8string().c_str());
+		return false;
+	}
+	chain.push_back(canonicalPath);
+
+	this->readOnly = readOnly;
+	file = ghc::filesystem::fstream(path, readOnly ? (std::ios::in | std::ios::binary) : (std::ios::in | std::ios::out | std::ios::binary));
+	if (file.fail())
+		return false;
+
+	file.read((char*)&header, sizeof(header));
+	if (file.fail() || memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+		return false;
+
+	if (header.version != Version || header.blockSize != BlockSize)
+	{
+		Console.Error("DEV9: ATA: Unsupported sparse image version %u, block size %u", header.version, header.blockSize);
+		return false;
+	}
+
+	if (header.blockCount != (header.size + BlockSize - 1) / BlockSize)
+	{
+		Console.Error("DEV9: ATA: Sparse image block count %u doesn't match its size", header.blockCount);
+		return false;
+	}
+
+	file.seekg(0, std::ios::end);
+	const u64 fileLength = file.tellg();
+	dataOffset = GetDataOffset(header.blockCount);
+	if (fileLength < dataOffset)
+	{
+		Console.Error("DEV9: ATA: Sparse image is truncated");
+		return false;
+	}
+
+	blockMap.resize(header.blockCount);
+	file.seekg(sizeof(Header), std::ios::beg);
+	file.read((char*)blockMap.data(), blockMap.size() * sizeof(u32));
+	if (file.fail())
+		return false;
+
+	//Only whole blocks that made it to disk can be mapped
+	const u64 storedBlocks = (fileLength - dataOffset) / BlockSize;
+	allocatedBlocks = 0;
+	for (const u32 entry : blockMap)
+	{
+		if (entry > storedBlocks)
+		{
+			Console.Error("DEV9: ATA: Sparse image maps block %u, but only %llu are stored", entry, (unsigned long long)storedBlocks);
+			return false;
+		}
+		allocatedBlocks = std::max(allocatedBlocks, entry);
+	}
+
+	header.basePath[sizeof(header.basePath) - 1] = 0;
+	if (header.basePath[0] != 0)
+	{
+		ghc::filesystem::path basePath = ghc::filesystem::u8path(header.basePath);
+		if (basePath.is_relative())
+			basePath = path.parent_path() / basePath;
+
+		//The base is shared, never write to it
+		base = HddImage::Open(basePath, true, chain);
+		if (base == nullptr)
+		{
+			Console.Error("DEV9: ATA: Failed to open base image %s", basePath.u8string().c_str());
+			return false;
+		}
+		if (base->GetSize() < header.size)
+		{
+			Console.Error("DEV9: ATA: Base image %s is smaller than the overlay", basePath.u8string().c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+u64 HddSparseImage::GetSize()
+{
+	return header.size;
+}
+
+bool HddSparseImage::ReadUnallocated(u64 offset, u8* data, u32 length)
+{
+	if (base != nullptr)
+		return base->Read(offset, data, length);
+
+	memset(data, 0, length);
+	return true;
+}
+
+bool HddSparseImage::Read(u64 offset, u8* data, u32 length)
+{
+	if (offset + length > header.size)
+		return false;
+
+	while (length > 0)
+	{
+		const u32 block = (u32)(offset / BlockSize);
+		const u32 blockOffset = (u32)(offset % BlockSize);
+		const u32 chunk = std::min(length, BlockSize - blockOffset);
+
+		if (blockMap[block] == Unallocated)
+		{
+			if (!ReadUnallocated(offset, data, chunk))
+				return false;
+		}
+		else
+		{
+			file.seekg(dataOffset + (u64)(blockMap[block] - 1) * BlockSize + blockOffset, std::ios::beg);
+			file.read((char*)data, chunk);
+			if (file.fail())
+				return false;
+		}
+
+		offset += chunk;
+		data += chunk;
+		length -= chunk;
+	}
+
+	return true;
+}
+
+bool HddSparseImage::AllocateBlock(u32 block)
+{
+	//Copy on write, the new block starts with what was visible there before
+	std::vector<u8> contents(BlockSize, 0);
+	const u64 blockStart = (u64)block * BlockSize;
+	if (!ReadUnallocated(blockStart, contents.data(), (u32)std::min<u64>(BlockSize, header.size - blockStart)))
+		return false;
+
+	const u32 entry = allocatedBlocks + 1;
+	file.seekp(dataOffset + (u64)allocatedBlocks * BlockSize, std::ios::beg);
+	file.write((const char*)contents.data(), BlockSize);
+	//Data goes first, so an interrupted write never maps a block to garbage
+	file.flush();
+	if (file.fail())
+		return false;
+
+	file.seekp(sizeof(Header) + (u64)block * sizeof(u32), std::ios::beg);
+	file.write((const char*)&entry, sizeof(entry));
+	if (file.fail())
+		return false;
+
+	blockMap[block] = entry;
+	allocatedBlocks++;
+	return true;
+}
+
+bool HddSparseImage::Write(u64 offset, const u8* data, u32 length)
+{
+	if (readOnly || offset + length > header.size)
+		return false;
+
+	while (length > 0)
+	{
+		const u32 block = (u32)(offset / BlockSize);
+		const u32 blockOffset = (u32)(offset % BlockSize);
+		const u32 chunk = std::min(length, BlockSize - blockOffset);
+
+		if (blockMap[block] == Unallocated && !AllocateBlock(block))
+			return false;
+
+		file.seekp(dataOffset + (u64)(blockMap[block] - 1) * BlockSize + blockOffset, std::ios::beg);
+		file.write((const char*)data, chunk);
+		if (file.fail())
+			return false;
+
+		offset += chunk;
+		data += chunk;
+		length -= chunk;
+	}
+
+	return true;
+}
+
+bool HddSparseImage::Flush()
+{
+	file.flush();
+	return !file.fail();
+}
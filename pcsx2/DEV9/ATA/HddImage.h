@@ -0,0 +1,120 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "ghc/filesystem.h"
+
+//Storage behind the emulated HDD
+class HddImage
+{
+public:
+	virtual ~HddImage() = default;
+
+	//Size in bytes
+	virtual u64 GetSize() = 0;
+	virtual bool Read(u64 offset, u8* data, u32 length) = 0;
+	virtual bool Write(u64 offset, const u8* data, u32 length) = 0;
+	virtual bool Flush() = 0;
+
+	//Opens a raw or sparse image, the format is detected from the file header
+	static std::unique_ptr<HddImage> Open(const ghc::filesystem::path& path, bool readOnly = false);
+
+protected:
+	//chain holds the overlays already opened above this image
+	static std::unique_ptr<HddImage> Open(const ghc::filesystem::path& path, bool readOnly, std::vector<ghc::filesystem::path>& chain);
+};
+
+//Flat image, the offset in the file is the offset on the disk
+class HddRawImage : public HddImage
+{
+private:
+	std::fstream file;
+	u64 size = 0;
+
+public:
+	bool Open(const ghc::filesystem::path& path, bool readOnly);
+
+	virtual u64 GetSize();
+	virtual bool Read(u64 offset, u8* data, u32 length);
+	virtual bool Write(u64 offset, const u8* data, u32 length);
+	virtual bool Flush();
+};
+
+//Block mapped image, only blocks that were written to take space in the file
+//Blocks that were never written are read from the base image if there is one, or as zeros
+//Layout is the header, then the block map, then the data blocks in the order they were allocated
+class HddSparseImage : public HddImage
+{
+public:
+	static const u32 BlockSize = 64 * 1024;
+	static const u32 Version = 1;
+	static constexpr char Magic[8] = {'P', 'S', '2', 'S', 'P', 'H', 'D', 'D'};
+	//Limit on overlays stacked over each other
+	static const u32 MaxBaseDepth = 8;
+
+private:
+#pragma pack(push, 1)
+	struct Header
+	{
+		char magic[8];
+		u32 version;
+		u32 blockSize;
+		u64 size;
+		u32 blockCount;
+		//Image providing the unallocated blocks, relative to the directory of this image, empty for none
+		char basePath[484];
+	};
+#pragma pack(pop)
+	static_assert(sizeof(Header) == 512);
+
+	//0 if unallocated, else index of the block in the data area + 1
+	static const u32 Unallocated = 0;
+
+	std::fstream file;
+	bool readOnly = false;
+	Header header;
+	std::vector<u32> blockMap;
+	u32 allocatedBlocks = 0;
+	u64 dataOffset = 0;
+	std::unique_ptr<HddImage> base;
+
+public:
+	bool Open(const ghc::filesystem::path& path, bool readOnly);
+	bool Open(const ghc::filesystem::path& path, bool readOnly, std::vector<ghc::filesystem::path>& chain);
+
+	virtual u64 GetSize();
+	virtual bool Read(u64 offset, u8* data, u32 length);
+	virtual bool Write(u64 offset, const u8* data, u32 length);
+	virtual bool Flush();
+
+	static bool IsSparseImage(const ghc::filesystem::path& path);
+	//Creates an empty image, or a copy-on-write overlay over basePath when given
+	static bool Create(const ghc::filesystem::path& path, u64 size, const ghc::filesystem::path& basePath = {});
+	//Creates a sparse copy of a raw image, all zero blocks are left unallocated
+	//progress is called with the bytes converted so far and the total, returning false cancels
+	static bool Convert(const ghc::filesystem::path& rawPath, const ghc::filesystem::path& sparsePath,
+		const std::function<bool(u64, u64)>& progress = nullptr);
+
+private:
+	static u64 GetDataOffset(u32 blockCount);
+	//Reads part of a block that isn't in this image
+	bool ReadUnallocated(u64 offset, u8* data, u32 length);
+	bool AllocateBlock(u32 block);
+};
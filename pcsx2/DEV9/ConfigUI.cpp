@@ -389,11 +389,17 @@ void DEV9configure()
 			hddPath = path / hddPath;
 		}
 
-		if (config.hddEnable && !ghc::filesystem::exists(hddPath))
+		//Sparse images are created when the HDD is opened, except when converting an existing raw image
+		ghc::filesystem::path rawPath = hddPath;
+		rawPath.replace_extension(".raw");
+		const bool sparse = hddPath.extension() == ".sphdd";
+		if (config.hddEnable && !ghc::filesystem::exists(hddPath) && (!sparse || ghc::filesystem::exists(rawPath)))
 		{
 			HddCreate hddCreator;
 			hddCreator.filePath = hddPath;
 			hddCreator.neededSize = config.HddSize;
+			if (sparse)
+				hddCreator.convertPath = rawPath;
 			hddCreator.Start();
 		}
 
@@ -44,6 +44,7 @@
 
 void rx_process(NetPacket* pk);
 bool rx_fifo_can_rx();
+int rx_fifo_rx_room();
 
 #define ETH_DEF "eth0"
 #ifdef _WIN32
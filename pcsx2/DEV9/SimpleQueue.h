@@ -15,6 +15,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+
 //Designed to allow one thread to queue data to another thread
 template <class T>
 class SimpleQueue
@@ -108,3 +111,73 @@ SimpleQueue<T>::~SimpleQueue()
 		tail = nullptr;
 	}
 }
+
+//Bounded queue for one queue thread and one worker thread
+//Entries are stored in place, so queueing never allocates
+//Size must be a power of 2
+template <class T, u32 Size>
+class SimpleRingQueue
+{
+	static_assert((Size & (Size - 1)) == 0, "SimpleRingQueue size must be a power of 2");
+
+private:
+	//Each counter is only written by one thread, keep them on separate cache lines
+	alignas(64) std::atomic<u32> head{0}; //Entries queued so far
+	alignas(64) std::atomic<u32> tail{0}; //Entries dequeued so far
+	alignas(64) T entries[Size];
+
+public:
+	//Used by single queue thread, returns false if the queue is full
+	bool Enqueue(const T& entry);
+	//Used by single worker thread
+	bool Dequeue(T* entry);
+	//Used by single worker thread, dequeues up to maxCount entries and returns how many
+	u32 DequeueBatch(T* dest, u32 maxCount);
+
+	bool IsQueueEmpty();
+	//Number of entries waiting
+	u32 GetDepth();
+};
+
+template <class T, u32 Size>
+bool SimpleRingQueue<T, Size>::Enqueue(const T& entry)
+{
+	const u32 pos = head.load(std::memory_order_relaxed);
+	if (pos - tail.load(std::memory_order_acquire) == Size)
+		return false;
+
+	entries[pos & (Size - 1)] = entry;
+	head.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+template <class T, u32 Size>
+bool SimpleRingQueue<T, Size>::Dequeue(T* entry)
+{
+	return DequeueBatch(entry, 1) == 1;
+}
+
+template <class T, u32 Size>
+u32 SimpleRingQueue<T, Size>::DequeueBatch(T* dest, u32 maxCount)
+{
+	const u32 pos = tail.load(std::memory_order_relaxed);
+	const u32 count = std::min(head.load(std::memory_order_acquire) - pos, maxCount);
+
+	for (u32 i = 0; i < count; i++)
+		dest[i] = entries[(pos + i) & (Size - 1)];
+
+	tail.store(pos + count, std::memory_order_release);
+	return count;
+}
+
+template <class T, u32 Size>
+bool SimpleRingQueue<T, Size>::IsQueueEmpty()
+{
+	return GetDepth() == 0;
+}
+
+template <class T, u32 Size>
+u32 SimpleRingQueue<T, Size>::GetDepth()
+{
+	return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+}
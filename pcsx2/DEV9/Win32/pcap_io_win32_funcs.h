@@ -47,6 +47,10 @@ FUNCTION_SHIM_2_ARG(int, pcap_setfilter, pcap_t*, struct bpf_program*)
 FUNCTION_SHIM_2_ARG(int, pcap_setdirection, pcap_t*, pcap_direction_t)
 FUNCTION_SHIM_2_ARG(int, pcap_getnonblock, pcap_t*, char*)
 FUNCTION_SHIM_3_ARG(int, pcap_setnonblock, pcap_t*, int, char*)
+#ifdef _WIN32
+FUNCTION_SHIM_2_ARG(int, pcap_setmintocopy, pcap_t*, int)
+FUNCTION_SHIM_1_ARG(HANDLE, pcap_getevent, pcap_t*)
+#endif
 //FUNCTION_SHIM_3_ARG(int, pcap_inject, pcap_t*, const void*, size_t)
 FUNCTION_SHIM_3_ARG(int, pcap_sendpacket, pcap_t*, const u_char*, int)
 //FUNCTION_SHIM_1_ARG(const char*, pcap_statustostr, int)
@@ -582,33 +582,39 @@ bool TAPAdapter::isInitialised()
 //gets a packet.rv :true success
 bool TAPAdapter::recv(NetPacket* pkt)
 {
-	DWORD read_size;
-	BOOL result = ReadFile(htap,
-		pkt->buffer,
-		sizeof(pkt->buffer),
-		&read_size,
-		&read);
+	DWORD read_size = 0;
+	BOOL result = TRUE;
 
-	if (!result)
+	if (!readPending)
 	{
-		DWORD dwError = GetLastError();
-		if (dwError == ERROR_IO_PENDING)
-		{
-			HANDLE readHandles[]{read.hEvent, cancel};
-			const DWORD waitResult = WaitForMultipleObjects(2, readHandles, FALSE, INFINITE);
+		result = ReadFile(htap,
+			readBuffer,
+			sizeof(readBuffer),
+			&read_size,
+			&read);
 
-			if (waitResult == WAIT_OBJECT_0 + 1)
-			{
-				CancelIo(htap);
-				//Wait for the I/O subsystem to acknowledge our cancellation
-				result = GetOverlappedResult(htap, &read, &read_size, TRUE);
-			}
-			else
-				result = GetOverlappedResult(htap, &read, &read_size, FALSE);
+		if (!result)
+		{
+			if (GetLastError() != ERROR_IO_PENDING)
+				return false;
+			readPending = true;
 		}
 	}
 
-	if (result && VerifyPkt(pkt, read_size))
+	if (readPending)
+	{
+		//Don't wait for the read here, waitRecv() does that
+		result = GetOverlappedResult(htap, &read, &read_size, FALSE);
+		if (!result && GetLastError() == ERROR_IO_INCOMPLETE)
+			return false;
+		readPending = false;
+	}
+
+	if (!result)
+		return false;
+
+	memcpy(pkt->buffer, readBuffer, read_size);
+	if (VerifyPkt(pkt, read_size))
 	{
 		InspectRecv(pkt);
 		return true;
@@ -616,6 +622,15 @@ bool TAPAdapter::recv(NetPacket* pkt)
 	else
 		return false;
 }
+bool TAPAdapter::waitRecv(int timeout_ms)
+{
+	//recv() starts the next read
+	if (!readPending)
+		return true;
+
+	HANDLE readHandles[]{read.hEvent, cancel};
+	return WaitForMultipleObjects(2, readHandles, FALSE, timeout_ms) == WAIT_OBJECT_0;
+}
 //sends the packet .rv :true success
 bool TAPAdapter::send(NetPacket* pkt)
 {
@@ -669,6 +684,13 @@ TAPAdapter::~TAPAdapter()
 {
 	if (!isActive)
 		return;
+	if (readPending)
+	{
+		CancelIo(htap);
+		//Wait for the I/O subsystem to acknowledge our cancellation
+		DWORD read_size;
+		GetOverlappedResult(htap, &read, &read_size, TRUE);
+	}
 	CloseHandle(read.hEvent);
 	CloseHandle(write.hEvent);
 	CloseHandle(cancel);
@@ -26,12 +26,17 @@ class TAPAdapter : public NetAdapter
 	HANDLE cancel;
 	bool isActive = false;
 
+	//recv() leaves a read pending when no packet is ready, the driver fills readBuffer once one arrives
+	bool readPending = false;
+	char readBuffer[sizeof(NetPacket::buffer)];
+
 public:
 	TAPAdapter();
 	virtual bool blocks();
 	virtual bool isInitialised();
 	//gets a packet.rv :true success
 	virtual bool recv(NetPacket* pkt);
+	virtual bool waitRecv(int timeout_ms);
 	//sends the packet and deletes it when done (if successful).rv :true success
 	virtual bool send(NetPacket* pkt);
 	virtual void reloadSettings();
@@ -15,9 +15,11 @@
 
 #include "PrecompiledHeader.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <vector>
 #if defined(__POSIX__)
 #include <pthread.h>
 #endif
@@ -39,25 +41,110 @@ std::thread rx_thread;
 std::mutex rx_mutex;
 
 volatile bool RxRunning = false;
+
+//Max packets taken from the adapter before handing them to the fifo
+const int RxBatchSize = 16;
+//Only bounds how long the rx thread takes to notice RxRunning on adapters without a close() wakeup
+const int RxWaitTimeout = 50;
+
+//Power of two histogram, bucket 0 holds 0, bucket n holds [2^(n-1), 2^n), the last bucket holds the rest
+struct RxHistogram
+{
+	static const int Buckets = 12;
+	u64 count[Buckets];
+
+	void Reset()
+	{
+		memset(count, 0, sizeof(count));
+	}
+
+	void Add(u32 value)
+	{
+		int bucket = 0;
+		while (value != 0 && bucket < Buckets - 1)
+		{
+			value >>= 1;
+			bucket++;
+		}
+		count[bucket]++;
+	}
+
+	void Print(const char* name, const char* unit)
+	{
+		std::string line;
+		char entry[64];
+		for (int i = 0; i < Buckets; i++)
+		{
+			if (count[i] == 0)
+				continue;
+
+			if (i == Buckets - 1)
+				snprintf(entry, sizeof(entry), " >=%u%s:%llu", 1u << (i - 1), unit, (unsigned long long)count[i]);
+			else
+				snprintf(entry, sizeof(entry), " <%u%s:%llu", 1u << i, unit, (unsigned long long)count[i]);
+			line += entry;
+		}
+
+		if (!line.empty())
+			DevCon.WriteLn("DEV9: RX %s%s", name, line.c_str());
+	}
+};
+
+//latency is from the adapter signalling a packet to it being in the fifo
+RxHistogram rx_latency;
+RxHistogram rx_batch;
+
 //rx thread
 void NetRxThread()
 {
-	NetPacket tmp;
+	Threading::PlaceCurrentThread(Threading::ThreadRole::DEV9Rx);
+
+	std::vector<NetPacket> batch(RxBatchSize);
 	while (RxRunning)
 	{
-		while (rx_fifo_can_rx() && nif->recv(&tmp))
+		//Packets stay queued in the adapter until the guest makes room
+		const int room = rx_fifo_rx_room();
+		if (room == 0)
+		{
+			using namespace std::chrono_literals;
+			std::this_thread::sleep_for(1ms);
+			continue;
+		}
+
+		if (!nif->waitRecv(RxWaitTimeout))
+			continue;
+
+		const auto wake = std::chrono::steady_clock::now();
+
+		//Drain the burst first, so rx_mutex is only taken once for all of it
+		const int max = std::min(room, RxBatchSize);
+		int count = 0;
+		while (count < max && nif->recv(&batch[count]))
+			count++;
+
+		if (count == 0)
+			continue;
+
+		Threading::SampleThreadPlacement();
+
 		{
 			std::lock_guard rx_lock(rx_mutex);
-			//Check if we can still rx
-			if (rx_fifo_can_rx())
-				rx_process(&tmp);
-			else
-				Console.Error("DEV9: rx_fifo_can_rx() false after nif->recv(), dropping");
+			for (int i = 0; i < count; i++)
+			{
+				//Check if we can still rx
+				if (rx_fifo_can_rx())
+					rx_process(&batch[i]);
+				else
+					Console.Error("DEV9: rx_fifo_can_rx() false after nif->recv(), dropping");
+			}
 		}
 
-		using namespace std::chrono_literals;
-		std::this_thread::sleep_for(1ms);
+		const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wake);
+		rx_latency.Add(static_cast<u32>(latency.count()));
+		rx_batch.Add(count);
 	}
+
+	Threading::ReleaseCurrentThread();
 }
 
 void tx_put(NetPacket* pkt)
@@ -108,6 +195,9 @@ void InitNet()
 	nif = na;
 	RxRunning = true;
 
+	rx_latency.Reset();
+	rx_batch.Reset();
+
 	rx_thread = std::thread(NetRxThread);
 
 #ifdef _WIN32
@@ -158,6 +248,9 @@ void TermNet()
 		rx_thread.join();
 		Console.WriteLn("DEV9: Done");
 
+		rx_latency.Print("latency", "us");
+		rx_batch.Print("batch size", "");
+
 		delete nif;
 		nif = nullptr;
 	}
@@ -199,6 +292,14 @@ bool NetAdapter::recv(NetPacket* pkt)
 	return false;
 }
 
+bool NetAdapter::waitRecv(int timeout_ms)
+{
+	//No handle to wait on, poll as often as the fifo allows
+	using namespace std::chrono_literals;
+	std::this_thread::sleep_for(1ms);
+	return true;
+}
+
 bool NetAdapter::send(NetPacket* pkt)
 {
 	return InternalServerSend(pkt);
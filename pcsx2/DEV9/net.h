@@ -107,6 +107,9 @@ public:
 	virtual bool blocks() = 0;
 	virtual bool isInitialised() = 0;
 	virtual bool recv(NetPacket* pkt); //gets a packet
+	//waits up to timeout_ms for recv() to have a packet, rv :false on timeout or close()
+	//adapters that override this must not block in recv()
+	virtual bool waitRecv(int timeout_ms);
 	virtual bool send(NetPacket* pkt); //sends the packet and deletes it when done
 	virtual void reloadSettings() = 0;
 	virtual void close(){};
@@ -29,6 +29,10 @@
 #include <sys/types.h>
 #include <ifaddrs.h>
 #endif
+#if defined(__POSIX__)
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 #include <stdio.h>
 #include <stdarg.h>
@@ -46,6 +50,17 @@ char errbuf[PCAP_ERRBUF_SIZE];
 int pcap_io_running = 0;
 bool pcap_io_switched;
 
+//Lets the rx thread sleep until a packet arrives, instead of polling the adapter
+#ifdef _WIN32
+HANDLE pcap_io_cancel = NULL;
+#else
+int pcap_io_fd = -1;
+int pcap_io_cancel[2] = {-1, -1};
+#endif
+
+bool pcap_io_can_wait();
+void pcap_io_close_cancel();
+
 extern u8 eeprom[];
 
 char namebuff[256];
@@ -187,6 +202,7 @@ int pcap_io_init(char* adapter, bool switched, mac_address virtual_mac)
 	pcap_io_switched = switched;
 
 	/* Open the adapter */
+#ifdef _WIN32
 	if ((adhandle = pcap_open_live(adapter, // name of the device
 			 65536, // portion of the packet to capture.
 			 // 65536 grants that the whole packet will be captured on all the MACs.
@@ -199,6 +215,48 @@ int pcap_io_init(char* adapter, bool switched, mac_address virtual_mac)
 		Console.Error("DEV9: Unable to open the adapter. %s is not supported by pcap", adapter);
 		return -1;
 	}
+
+	//Signal the read event for every packet, rather than once the driver buffered 16KB
+	pcap_setmintocopy(adhandle, 0);
+	pcap_io_cancel = CreateEvent(NULL, TRUE, FALSE, NULL);
+#else
+	if ((adhandle = pcap_create(adapter, errbuf)) == NULL)
+	{
+		Console.Error("DEV9: %s", errbuf);
+		Console.Error("DEV9: Unable to open the adapter. %s is not supported by pcap", adapter);
+		return -1;
+	}
+
+	// 65536 grants that the whole packet will be captured on all the MACs.
+	pcap_set_snaplen(adhandle, 65536);
+	pcap_set_promisc(adhandle, switched ? 1 : 0);
+	pcap_set_timeout(adhandle, 1);
+	//Hand over packets as they arrive, rather than once the kernel buffer block is full or times out
+	pcap_set_immediate_mode(adhandle, 1);
+
+	if (pcap_activate(adhandle) < 0)
+	{
+		Console.Error("DEV9: %s", pcap_geterr(adhandle));
+		Console.Error("DEV9: Unable to open the adapter. %s is not supported by pcap", adapter);
+		pcap_close(adhandle);
+		adhandle = nullptr;
+		return -1;
+	}
+
+	//Without a selectable fd, recv keeps blocking for the read timeout
+	pcap_io_fd = pcap_get_selectable_fd(adhandle);
+	if (pcap_io_fd != -1 && pipe(pcap_io_cancel) == -1)
+		pcap_io_fd = -1;
+#endif
+
+	if (pcap_io_can_wait() && pcap_setnonblock(adhandle, 1, errbuf) == -1)
+	{
+		Console.Error("DEV9: Error setting non blocking mode: %s", errbuf);
+		pcap_close(adhandle);
+		adhandle = nullptr;
+		pcap_io_close_cancel();
+		return -1;
+	}
 	if (switched)
 	{
 		char virtual_mac_str[18];
@@ -335,6 +393,48 @@ int pcap_io_recv(void* packet, int max_len)
 	return -1;
 }
 
+bool pcap_io_can_wait()
+{
+#ifdef _WIN32
+	return pcap_io_cancel != NULL;
+#else
+	return pcap_io_fd != -1;
+#endif
+}
+
+//rv :true if a packet can be read, false on timeout or pcap_io_cancel_wait()
+bool pcap_io_wait(int timeout_ms)
+{
+	if (pcap_io_running <= 0)
+		return false;
+
+#ifdef _WIN32
+	HANDLE handles[]{pcap_getevent(adhandle), pcap_io_cancel};
+	return WaitForMultipleObjects(2, handles, FALSE, timeout_ms) == WAIT_OBJECT_0;
+#else
+	pollfd fds[2]{{pcap_io_fd, POLLIN, 0}, {pcap_io_cancel[0], POLLIN, 0}};
+	if (poll(fds, 2, timeout_ms) <= 0)
+		return false;
+
+	return (fds[1].revents & POLLIN) == 0 && (fds[0].revents & POLLIN) != 0;
+#endif
+}
+
+void pcap_io_cancel_wait()
+{
+#ifdef _WIN32
+	if (pcap_io_cancel != NULL)
+		SetEvent(pcap_io_cancel);
+#else
+	if (pcap_io_cancel[1] != -1)
+	{
+		const char wake = 0;
+		if (write(pcap_io_cancel[1], &wake, 1) != 1)
+			Console.Error("DEV9: Failed to wake RX thread");
+	}
+#endif
+}
+
 void pcap_io_close()
 {
 	if (dump_pcap)
@@ -342,6 +442,25 @@ void pcap_io_close()
 	if (adhandle)
 		pcap_close(adhandle);
 	pcap_io_running = 0;
+
+	pcap_io_close_cancel();
+}
+
+void pcap_io_close_cancel()
+{
+#ifdef _WIN32
+	if (pcap_io_cancel != NULL)
+		CloseHandle(pcap_io_cancel);
+	pcap_io_cancel = NULL;
+#else
+	for (int& fd : pcap_io_cancel)
+	{
+		if (fd != -1)
+			::close(fd);
+		fd = -1;
+	}
+	pcap_io_fd = -1;
+#endif
 }
 
 
@@ -408,6 +527,13 @@ bool PCAPAdapter::isInitialised()
 {
 	return !!pcap_io_running;
 }
+bool PCAPAdapter::waitRecv(int timeout_ms)
+{
+	if (!pcap_io_can_wait())
+		return NetAdapter::waitRecv(timeout_ms);
+
+	return pcap_io_wait(timeout_ms);
+}
 //gets a packet.rv :true success
 bool PCAPAdapter::recv(NetPacket* pkt)
 {
@@ -459,6 +585,11 @@ void PCAPAdapter::reloadSettings()
 #endif
 }
 
+void PCAPAdapter::close()
+{
+	pcap_io_cancel_wait();
+}
+
 PCAPAdapter::~PCAPAdapter()
 {
 	pcap_io_close();
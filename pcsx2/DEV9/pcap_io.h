@@ -179,9 +179,11 @@ public:
 	virtual bool isInitialised();
 	//gets a packet.rv :true success
 	virtual bool recv(NetPacket* pkt);
+	virtual bool waitRecv(int timeout_ms);
 	//sends the packet and deletes it when done (if successful).rv :true success
 	virtual bool send(NetPacket* pkt);
 	virtual void reloadSettings();
+	virtual void close();
 	virtual ~PCAPAdapter();
 	static std::vector<AdapterEntry> GetAdapters();
 };
@@ -63,12 +63,19 @@ void test()
 
 //this can return a false positive, but its not problem since it may say it cant recv while it can (no harm done, just delay on packets)
 bool rx_fifo_can_rx()
+{
+	return rx_fifo_rx_room() > 0;
+}
+
+//number of full sized packets that fit in the fifo, can be lower than the actual room (see above)
+int rx_fifo_rx_room()
 {
 	//check if RX is on & stuff like that here
 
 	//Check if there is space on RXBD
-	if (dev9Ru8(SMAP_R_RXFIFO_FRAME_CNT) == 64)
-		return false;
+	const int frames = 64 - dev9Ru8(SMAP_R_RXFIFO_FRAME_CNT);
+	if (frames <= 0)
+		return 0;
 
 	//Check if there is space on fifo
 	int rd_ptr = dev9Ru32(SMAP_R_RXFIFO_RD_PTR);
@@ -80,10 +87,10 @@ bool rx_fifo_can_rx()
 		space = sizeof(dev9.rxfifo);
 
 	if (space < 1514)
-		return false;
+		return 0;
 
-	//we can recv a packet !
-	return true;
+	//we can recv a packet ! each following one takes up to 1516 bytes once padded
+	return std::min(frames, 1 + (space - 1514) / 1516);
 }
 
 void rx_process(NetPacket* pk)
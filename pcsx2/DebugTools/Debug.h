@@ -75,10 +75,16 @@ public:
 		: TextFileTraceLog( &desc->base ) {}
 
 	void DoWrite( const char *fmt ) const override;
+	bool DoWriteBinary( const char* fmt, va_list list ) const override;
 	bool IsActive() const override
 	{
 		return EmuConfig.Trace.Enabled && Enabled;
 	}
+
+	// Binary traces (see TraceRing.h) store the prefix as the start of the format, and
+	// its current values as the first arguments.
+	virtual std::string GetPrefixFormat() const { return {}; }
+	virtual u32 GetPrefixArgs( u32* args ) const { return 0; }
 };
 
 class SysTraceLog_EE : public SysTraceLog
@@ -89,6 +95,8 @@ public:
 	SysTraceLog_EE( const SysTraceLogDescriptor* desc ) : _parent( desc ) {}
 
 	void ApplyPrefix( FastFormatAscii& ascii ) const override;
+	std::string GetPrefixFormat() const override;
+	u32 GetPrefixArgs( u32* args ) const override;
 	bool IsActive() const override
 	{
 		return SysTraceLog::IsActive() && EmuConfig.Trace.EE.m_EnableAll;
@@ -105,6 +113,7 @@ public:
 	SysTraceLog_VIFcode( const SysTraceLogDescriptor* desc ) : _parent( desc ) {}
 
 	void ApplyPrefix( FastFormatAscii& ascii ) const override;
+	std::string GetPrefixFormat() const override;
 };
 
 class SysTraceLog_EE_Disasm : public SysTraceLog_EE
@@ -161,6 +170,8 @@ public:
 	SysTraceLog_IOP( const SysTraceLogDescriptor* desc ) : _parent( desc ) {}
 
 	void ApplyPrefix( FastFormatAscii& ascii ) const override;
+	std::string GetPrefixFormat() const override;
+	u32 GetPrefixArgs( u32* args ) const override;
 	bool IsActive() const override
 	{
 		return SysTraceLog::IsActive() && EmuConfig.Trace.IOP.m_EnableAll;
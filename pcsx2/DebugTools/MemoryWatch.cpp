@@ -0,0 +1,339 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "MemoryWatch.h"
+
+#include "Memory.h"
+#include "IopMem.h"
+#include "R3000A.h"
+#include "R5900.h"
+#include "System/SysThreads.h"
+
+#include <atomic>
+#include <map>
+
+namespace
+{
+	enum PageWatch : u8
+	{
+		PageWatch_Read = 0x01,
+		PageWatch_Write = 0x02,
+	};
+
+	enum class WatchMode
+	{
+		None,   // no memchecks for this cpu
+		Paged,  // memchecks are watched with page protection
+		Inline, // memchecks can't be watched, every block checks its accesses
+	};
+
+	struct WatchRange
+	{
+		u32 start; // offsets in main ram
+		u32 end;
+		MemCheckCondition cond;
+		MemCheckResult result;
+	};
+
+	static constexpr u32 MaxPages = Ps2MemSize::MainRam >> 12;
+	static constexpr u32 MaxFaults = 16;
+
+	struct WatchedRam
+	{
+		BreakPointCpu cpu;
+		u32 size;
+
+		// Recompiled code of the cpu, the only code whose faults are the cpu's accesses.
+		uptr code = 0;
+		uptr code_end = 0;
+
+		WatchMode mode = WatchMode::None;
+		std::vector<WatchRange> ranges;
+		std::vector<u32> pages;
+
+		u8 page_watch[MaxPages] = {};
+		std::atomic<bool> armed[MaxPages];
+		std::atomic<bool> needs_rearm{false};
+
+		// Blocks using inline checks, start pc -> end pc.
+		std::map<u32, u32> checked;
+
+		// Only written by the page fault handler on the core thread, and read by the same
+		// thread from the event test.
+		MemoryWatch::Fault faults[MaxFaults];
+		std::atomic<u32> fault_count{0};
+
+		WatchedRam(BreakPointCpu cpu_, u32 size_)
+			: cpu(cpu_)
+			, size(size_)
+		{
+		}
+
+		u8* GetBase() const
+		{
+			if (cpu == BREAKPOINT_EE)
+				return eeMem ? eeMem->Main : nullptr;
+			else
+				return iopMem ? iopMem->Main : nullptr;
+		}
+
+		void Protect(u32 page) const
+		{
+			// EE ram pages are shared with the block tracking, which has the final word.
+			if (cpu == BREAKPOINT_EE)
+				mmap_ProtectRamPage(page);
+			else
+				HostSys::MemProtect(GetBase() + (page << 12), __pagesize, MemoryWatch::GetPageAccess(cpu, page, PageAccess_ReadWrite()));
+		}
+	};
+} // namespace
+
+static WatchedRam s_ee_ram(BREAKPOINT_EE, Ps2MemSize::MainRam);
+static WatchedRam s_iop_ram(BREAKPOINT_IOP, Ps2MemSize::IopRam);
+
+static WatchedRam& GetRam(BreakPointCpu cpu)
+{
+	return (cpu == BREAKPOINT_IOP) ? s_iop_ram : s_ee_ram;
+}
+
+// Converts a memcheck to offsets in main ram, returns false if part of it lies elsewhere.
+static bool AddRange(WatchedRam& ram, const MemCheck& check)
+{
+	const u32 length = std::max<u32>(check.end - check.start, 1);
+
+	if (ram.cpu == BREAKPOINT_EE)
+	{
+		// Strips the kseg and uncached bits, as the dynarec does.
+		const u32 start = standardizeBreakpointAddressEE(check.start) & 0x1fffffff;
+		if (start >= Ps2MemSize::MainRam || Ps2MemSize::MainRam - start < length)
+			return false;
+
+		ram.ranges.push_back({start, start + length, check.cond, check.result});
+		return true;
+	}
+
+	// IOP ram is mirrored four times over the first 8MB.
+	u32 start = check.start & 0x1fffffff;
+	if (start >= 0x00800000 || 0x00800000 - start < length)
+		return false;
+
+	for (u32 left = length; left != 0;)
+	{
+		const u32 offset = start & (Ps2MemSize::IopRam - 1);
+		const u32 chunk = std::min(left, Ps2MemSize::IopRam - offset);
+		ram.ranges.push_back({offset, offset + chunk, check.cond, check.result});
+		start += chunk;
+		left -= chunk;
+	}
+	return true;
+}
+
+void MemoryWatch::Reset(BreakPointCpu cpu, const u8* code, const u8* code_end)
+{
+	WatchedRam& ram = GetRam(cpu);
+	ram.code = (uptr)code;
+	ram.code_end = (uptr)code_end;
+
+	// Switch to the old pages' normal protection first.
+	for (u32 page : ram.pages)
+	{
+		ram.page_watch[page] = 0;
+		if (ram.armed[page].exchange(false))
+			ram.Protect(page);
+	}
+
+	ram.mode = WatchMode::None;
+	ram.ranges.clear();
+	ram.pages.clear();
+	ram.checked.clear();
+	ram.fault_count = 0;
+	ram.needs_rearm = false;
+
+	// IOP faults can't be told apart from the other users of IOP ram, see MemoryWatch.h.
+	bool watchable = (cpu == BREAKPOINT_EE && ram.GetBase() != nullptr);
+	for (const MemCheck& check : CBreakPoints::GetMemChecks())
+	{
+		if (check.cpu != cpu || check.result == 0)
+			continue;
+
+		ram.mode = WatchMode::Paged;
+		if (!AddRange(ram, check))
+			watchable = false;
+	}
+
+	if (ram.mode == WatchMode::None)
+		return;
+
+	if (!watchable)
+	{
+		DevCon.WriteLn("MemoryWatch: %s memchecks can't be watched, checking all accesses", cpu == BREAKPOINT_EE ? "EE" : "IOP");
+		ram.mode = WatchMode::Inline;
+		ram.ranges.clear();
+		return;
+	}
+
+	for (const WatchRange& range : ram.ranges)
+	{
+		u8 watch = 0;
+		if (range.cond & MEMCHECK_READ)
+			watch |= PageWatch_Read;
+		if (range.cond & MEMCHECK_WRITE)
+			watch |= PageWatch_Write;
+		if (watch == 0)
+			continue;
+
+		for (u32 page = range.start >> 12; page <= (range.end - 1) >> 12; page++)
+		{
+			if (ram.page_watch[page] == 0)
+				ram.pages.push_back(page);
+			ram.page_watch[page] |= watch;
+		}
+	}
+
+	for (u32 page : ram.pages)
+	{
+		ram.armed[page] = true;
+		ram.Protect(page);
+	}
+
+	DevCon.WriteLn("MemoryWatch: %s watching %zu ranges on %zu pages", cpu == BREAKPOINT_EE ? "EE" : "IOP", ram.ranges.size(), ram.pages.size());
+}
+
+bool MemoryWatch::NeedsInlineChecks(BreakPointCpu cpu, u32 pc)
+{
+	// The interpreters check everything themselves.
+	if (cpu == BREAKPOINT_EE ? !CHECK_EEREC : !CHECK_IOPREC)
+		return true;
+
+	const WatchedRam& ram = GetRam(cpu);
+	switch (ram.mode)
+	{
+		case WatchMode::None:
+			return false;
+
+		case WatchMode::Inline:
+			return true;
+
+		case WatchMode::Paged:
+		{
+			auto it = ram.checked.upper_bound(pc);
+			if (it == ram.checked.begin())
+				return false;
+			--it;
+			return pc < it->second;
+		}
+	}
+
+	return true;
+}
+
+void MemoryWatch::SetInlineChecks(BreakPointCpu cpu, u32 startpc, u32 endpc)
+{
+	u32& end = GetRam(cpu).checked[startpc];
+	end = std::max(end, endpc);
+}
+
+bool MemoryWatch::TakeFault(BreakPointCpu cpu, Fault& fault)
+{
+	WatchedRam& ram = GetRam(cpu);
+
+	const u32 count = ram.fault_count.load(std::memory_order_acquire);
+	if (count == 0)
+		return false;
+
+	fault = ram.faults[count - 1];
+	ram.fault_count.store(count - 1, std::memory_order_release);
+	return true;
+}
+
+MemCheckResult MemoryWatch::GetFaultResult(BreakPointCpu cpu, const Fault& fault)
+{
+	const int mask = fault.write ? MEMCHECK_WRITE : MEMCHECK_READ;
+
+	int result = MEMCHECK_IGNORE;
+	for (const WatchRange& range : GetRam(cpu).ranges)
+	{
+		if ((range.cond & mask) && fault.addr >= range.start && fault.addr < range.end)
+			result |= range.result;
+	}
+
+	return static_cast<MemCheckResult>(result);
+}
+
+void MemoryWatch::Rearm(BreakPointCpu cpu)
+{
+	WatchedRam& ram = GetRam(cpu);
+	if (!ram.needs_rearm.exchange(false))
+		return;
+
+	for (u32 page : ram.pages)
+	{
+		if (!ram.armed[page].exchange(true))
+			ram.Protect(page);
+	}
+}
+
+PageProtectionMode MemoryWatch::GetPageAccess(BreakPointCpu cpu, u32 page, const PageProtectionMode& mode)
+{
+	const WatchedRam& ram = GetRam(cpu);
+	if (!ram.armed[page].load(std::memory_order_relaxed))
+		return mode;
+
+	return (ram.page_watch[page] & PageWatch_Read) ? PageAccess_None() : PageAccess_ReadOnly();
+}
+
+bool MemoryWatch::HandlePageFault(uptr addr, uptr pc)
+{
+	// Note: This runs in the signal handler, keep it to flags and protection changes.
+	for (WatchedRam* ram : {&s_ee_ram, &s_iop_ram})
+	{
+		const u8* base = ram->GetBase();
+		if (!base || addr < (uptr)base || addr - (uptr)base >= ram->size)
+			continue;
+
+		const u32 offset = addr - (uptr)base;
+		const u32 page = offset >> 12;
+		if (!ram->armed[page].exchange(false))
+			return false;
+
+		ram->Protect(page);
+		ram->needs_rearm = true;
+
+		// Only the cpu's own recompiled code runs at its pc.  Anything else (DMA, HLE and
+		// BIOS helpers, the other cpu, the recompiler reading the code, or the debugger's
+		// memory views on other threads) isn't reported, the page just gets protected again
+		// from the next event test.
+		if (pc >= ram->code && pc < ram->code_end && GetCoreThread().IsSelf())
+		{
+			const u32 count = ram->fault_count.load(std::memory_order_acquire);
+			if (count < MaxFaults)
+			{
+				const bool write = !(ram->page_watch[page] & PageWatch_Read);
+				ram->faults[count] = {ram->cpu == BREAKPOINT_EE ? cpuRegs.pc : psxRegs.pc, offset, write};
+				ram->fault_count.store(count + 1, std::memory_order_release);
+			}
+		}
+
+		if (ram->cpu == BREAKPOINT_EE)
+			g_nextEventCycle = cpuRegs.cycle;
+		else
+			g_iopNextEventCycle = psxRegs.cycle;
+
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,78 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Breakpoints.h"
+
+// --------------------------------------------------------------------------------------
+//  MemoryWatch  (page protection based memchecks for the recompilers)
+// --------------------------------------------------------------------------------------
+// Checking every recompiled load and store against every memcheck makes the emulation
+// crawl, so memchecks which lie in EE main ram are watched with page protection instead:
+// the host pages holding a watched range are made read only (write checks) or
+// inaccessible (read checks).
+//
+// When a watched page faults, the handler unprotects it, remembers the address and the
+// cpu's pc, and schedules an event test.  Only faults raised by the cpu's recompiled code
+// are reported: DMA, HLE helpers, the other cpu and the recompiler itself also touch main
+// ram, and their faults just get the page protected again from the event test.  From the
+// event test the recompiler reports the hit, marks the block that was running as needing
+// inline checks and clears it, then the pages are protected again.  Only blocks which
+// actually touch watched pages ever pay for the checks.
+//
+// Memchecks which reach outside of main ram (scratchpad, hardware registers, ...) can't be
+// watched this way, in which case all blocks are checked inline like before.  Neither can
+// IOP memchecks: the IOP recompiler goes through iopMemRead/Write for its accesses, so its
+// faults come from the same code as everybody else's.
+//
+// Limitations: the accesses which follow the first fault of a block, up to the end of that
+// block, aren't reported.  Faults on pages that are watched for reads can't tell reads and
+// writes apart, so they only report memchecks that include reads.
+//
+namespace MemoryWatch
+{
+	struct Fault
+	{
+		u32 pc;     // pc of the cpu owning the page when it faulted
+		u32 addr;   // offset of the access in the cpu's main ram
+		bool write; // set when the page only faults on writes
+	};
+
+	// Rebuilds the watched pages of the cpu from the current memchecks, forgets which blocks
+	// use inline checks and protects the pages.  Called by the recompilers on reset, since
+	// all blocks are recompiled afterwards, with the bounds of their code cache.
+	extern void Reset(BreakPointCpu cpu, const u8* code, const u8* code_end);
+
+	// True when recompiled code at pc has to check its memory accesses itself.
+	extern bool NeedsInlineChecks(BreakPointCpu cpu, u32 pc);
+	extern void SetInlineChecks(BreakPointCpu cpu, u32 startpc, u32 endpc);
+
+	// Pops a fault taken since the last call, returns false once there are none left.
+	extern bool TakeFault(BreakPointCpu cpu, Fault& fault);
+
+	// Memcheck actions triggered by the fault.
+	extern MemCheckResult GetFaultResult(BreakPointCpu cpu, const Fault& fault);
+
+	// Protects the pages which were unprotected by faults again.
+	extern void Rearm(BreakPointCpu cpu);
+
+	// Protection of an EE or IOP ram page, given the protection it would have otherwise.
+	extern PageProtectionMode GetPageAccess(BreakPointCpu cpu, u32 page, const PageProtectionMode& mode);
+
+	// Called from the page fault handler with the faulting address and host instruction,
+	// returns true if the fault was on a watched page.
+	extern bool HandlePageFault(uptr addr, uptr pc);
+} // namespace MemoryWatch
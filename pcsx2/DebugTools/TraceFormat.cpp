@@ -0,0 +1,447 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// No PrecompiledHeader.h here, this file is also built into tools/tracedecode.
+
+#include "TraceFormat.h"
+
+#include <cstring>
+#include <memory>
+#include <zlib.h>
+
+std::vector<TraceFormat::Spec> TraceFormat::ParseFormat(const char* fmt)
+{
+	std::vector<Spec> specs;
+
+	for (size_t pos = 0; fmt[pos] != 0; pos++)
+	{
+		if (fmt[pos] != '%')
+			continue;
+
+		Spec spec = {};
+		spec.begin = pos++;
+
+		if (fmt[pos] == '%')
+			continue;
+
+		while (fmt[pos] && strchr("-+ #0'", fmt[pos]))
+			pos++;
+
+		if (fmt[pos] == '*')
+		{
+			spec.star_width = true;
+			pos++;
+		}
+		while (fmt[pos] >= '0' && fmt[pos] <= '9')
+			pos++;
+
+		if (fmt[pos] == '.')
+		{
+			pos++;
+			if (fmt[pos] == '*')
+			{
+				spec.star_precision = true;
+				pos++;
+			}
+			while (fmt[pos] >= '0' && fmt[pos] <= '9')
+				pos++;
+		}
+
+		// Length modifiers, only the ones which change how the argument is passed matter.
+		int longs = 0;
+		bool is_64 = false, is_size = false, is_long_double = false;
+		while (fmt[pos] && strchr("hljztLq", fmt[pos]))
+		{
+			switch (fmt[pos])
+			{
+				case 'l': longs++; break;
+				case 'j':
+				case 'q': is_64 = true; break;
+				case 'z':
+				case 't': is_size = true; break;
+				case 'L': is_long_double = true; break;
+			}
+			pos++;
+		}
+		if (longs >= 2)
+			is_64 = true;
+
+		if (fmt[pos] == 0)
+			break;
+
+		spec.conversion = fmt[pos];
+		spec.end = pos + 1;
+
+		switch (spec.conversion)
+		{
+			case 'd':
+			case 'i':
+				spec.kind = is_64 ? ArgKind::Int64 : is_size ? ArgKind::SizeT : longs ? ArgKind::Long : ArgKind::Int;
+				break;
+
+			case 'u':
+			case 'o':
+			case 'x':
+			case 'X':
+				spec.kind = is_64 ? ArgKind::UInt64 : is_size ? ArgKind::SizeT : longs ? ArgKind::ULong : ArgKind::UInt;
+				break;
+
+			case 'e':
+			case 'E':
+			case 'f':
+			case 'F':
+			case 'g':
+			case 'G':
+			case 'a':
+			case 'A':
+				spec.kind = is_long_double ? ArgKind::LongDouble : ArgKind::Double;
+				break;
+
+			// Wide strings aren't copied, only their address is kept.
+			case 's':
+				spec.kind = longs ? ArgKind::Pointer : ArgKind::String;
+				break;
+
+			case 'p':
+				spec.kind = ArgKind::Pointer;
+				break;
+
+			case 'n':
+				spec.kind = ArgKind::Count;
+				break;
+
+			default:
+				spec.kind = ArgKind::Int;
+				break;
+		}
+
+		specs.push_back(spec);
+		pos = spec.end - 1;
+	}
+
+	return specs;
+}
+
+void TraceFormat::EncodeArgs(const std::vector<Spec>& specs, const u32* prefix_args, u32 prefix_count, va_list list, std::vector<u8>& record)
+{
+	auto push = [&record](u64 value) {
+		const size_t pos = record.size();
+		record.resize(pos + sizeof(value));
+		memcpy(&record[pos], &value, sizeof(value));
+	};
+
+	va_list args;
+	va_copy(args, list);
+
+	u32 prefix_pos = 0;
+	auto next = [&](ArgKind kind) -> u64 {
+		if (prefix_pos < prefix_count)
+			return prefix_args[prefix_pos++];
+
+		switch (kind)
+		{
+			case ArgKind::Int: return static_cast<u64>(static_cast<s64>(va_arg(args, int)));
+			case ArgKind::UInt: return va_arg(args, unsigned int);
+			case ArgKind::Long: return static_cast<u64>(static_cast<s64>(va_arg(args, long)));
+			case ArgKind::ULong: return va_arg(args, unsigned long);
+			case ArgKind::Int64: return static_cast<u64>(va_arg(args, long long));
+			case ArgKind::UInt64: return va_arg(args, unsigned long long);
+			case ArgKind::SizeT: return va_arg(args, size_t);
+			case ArgKind::Pointer: return reinterpret_cast<uptr>(va_arg(args, void*));
+			case ArgKind::Count: va_arg(args, int*); return 0;
+
+			case ArgKind::Double:
+			case ArgKind::LongDouble:
+			{
+				const double d = (kind == ArgKind::Double) ? va_arg(args, double) : static_cast<double>(va_arg(args, long double));
+				u64 value;
+				memcpy(&value, &d, sizeof(d));
+				return value;
+			}
+
+			case ArgKind::String:
+				break;
+		}
+		return 0;
+	};
+
+	for (const Spec& spec : specs)
+	{
+		if (spec.star_width)
+			push(next(ArgKind::Int));
+		if (spec.star_precision)
+			push(next(ArgKind::Int));
+
+		if (spec.kind == ArgKind::String)
+		{
+			const char* str = va_arg(args, const char*);
+			if (!str)
+				str = "(null)";
+
+			const u32 length = static_cast<u32>(strnlen(str, MaxStringLength));
+			const size_t pos = record.size();
+			record.resize(pos + Align(4 + length), 0);
+			memcpy(&record[pos], &length, sizeof(length));
+			memcpy(&record[pos + 4], str, length);
+		}
+		else if (spec.kind != ArgKind::Count)
+		{
+			push(next(spec.kind));
+		}
+		else
+		{
+			next(spec.kind);
+		}
+	}
+
+	va_end(args);
+}
+
+// --------------------------------------------------------------------------------------
+//  Decoder
+// --------------------------------------------------------------------------------------
+
+namespace
+{
+	class ArgReader
+	{
+		const u8* m_pos;
+		const u8* m_end;
+
+	public:
+		ArgReader(const u8* data, size_t size)
+			: m_pos(data)
+			, m_end(data + size)
+		{
+		}
+
+		bool Read(u64& value)
+		{
+			if (m_end - m_pos < 8)
+				return false;
+			memcpy(&value, m_pos, sizeof(value));
+			m_pos += 8;
+			return true;
+		}
+
+		bool ReadString(std::string& value)
+		{
+			u32 length;
+			if (m_end - m_pos < 4)
+				return false;
+			memcpy(&length, m_pos, sizeof(length));
+			if (static_cast<size_t>(m_end - m_pos) < TraceFormat::Align(4 + length))
+				return false;
+			value.assign(reinterpret_cast<const char*>(m_pos + 4), length);
+			m_pos += TraceFormat::Align(4 + length);
+			return true;
+		}
+	};
+
+	template <typename... Args>
+	void AppendFormatted(std::string& out, const std::string& spec, Args... args)
+	{
+		char buffer[512];
+		const int length = snprintf(buffer, sizeof(buffer), spec.c_str(), args...);
+		if (length < 0)
+			return;
+
+		if (static_cast<size_t>(length) < sizeof(buffer))
+		{
+			out.append(buffer, length);
+		}
+		else
+		{
+			std::string large(length + 1, 0);
+			snprintf(&large[0], large.size(), spec.c_str(), args...);
+			out.append(large.data(), length);
+		}
+	}
+
+	// Copies the text between conversions, where %% is the only escape.
+	void AppendLiteral(std::string& out, const std::string& text, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end && i < text.size(); i++)
+		{
+			out += text[i];
+			if (text[i] == '%' && i + 1 < end && text[i + 1] == '%')
+				i++;
+		}
+	}
+
+	struct DecodedFormat
+	{
+		std::string text;
+		std::vector<TraceFormat::Spec> specs;
+	};
+} // namespace
+
+static bool FormatRecord(const DecodedFormat& format, const u8* args, size_t size, std::string& out)
+{
+	using namespace TraceFormat;
+
+	ArgReader reader(args, size);
+	size_t literal = 0;
+
+	for (const Spec& spec : format.specs)
+	{
+		AppendLiteral(out, format.text, literal, spec.begin);
+		literal = spec.end;
+
+		// Flags, width and precision as written, minus the length modifiers since every
+		// argument was widened to 64 bits, with '*' replaced by the recorded values.
+		std::string flags;
+		for (size_t i = spec.begin + 1; i < spec.end - 1; i++)
+		{
+			const char ch = format.text[i];
+			if (ch == '*')
+			{
+				u64 value;
+				if (!reader.Read(value))
+					return false;
+				flags += std::to_string(static_cast<int>(static_cast<s64>(value)));
+			}
+			else if (!strchr("hljztLq", ch))
+			{
+				flags += ch;
+			}
+		}
+
+		std::string string_value;
+		u64 value = 0;
+		if (spec.kind == ArgKind::String ? !reader.ReadString(string_value) : (spec.kind != ArgKind::Count && !reader.Read(value)))
+			return false;
+
+		switch (spec.kind)
+		{
+			case ArgKind::Int:
+			case ArgKind::Long:
+			case ArgKind::Int64:
+			case ArgKind::UInt:
+			case ArgKind::ULong:
+			case ArgKind::UInt64:
+			case ArgKind::SizeT:
+				if (spec.conversion == 'c')
+					AppendFormatted(out, "%" + flags + "c", static_cast<int>(value));
+				else
+					AppendFormatted(out, "%" + flags + "ll" + spec.conversion, static_cast<unsigned long long>(value));
+				break;
+
+			case ArgKind::Double:
+			case ArgKind::LongDouble:
+			{
+				double d;
+				memcpy(&d, &value, sizeof(d));
+				AppendFormatted(out, "%" + flags + spec.conversion, d);
+				break;
+			}
+
+			case ArgKind::String:
+				AppendFormatted(out, "%" + flags + "s", string_value.c_str());
+				break;
+
+			case ArgKind::Pointer:
+				AppendFormatted(out, "%" + flags + "p", reinterpret_cast<void*>(static_cast<uintptr_t>(value)));
+				break;
+
+			case ArgKind::Count:
+				break;
+		}
+	}
+
+	AppendLiteral(out, format.text, literal, format.text.size());
+	return true;
+}
+
+bool TraceFormat::Decode(const char* path, FILE* out)
+{
+	std::unique_ptr<gzFile_s, int (*)(gzFile)> file(gzopen(path, "rb"), gzclose);
+	if (!file)
+	{
+		fprintf(stderr, "Failed to open %s\n", path);
+		return false;
+	}
+
+	FileHeader header;
+	if (gzread(file.get(), &header, sizeof(header)) != sizeof(header) || memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+	{
+		fprintf(stderr, "%s is not a trace file\n", path);
+		return false;
+	}
+	if (header.version != Version)
+	{
+		fprintf(stderr, "Unsupported trace file version %u\n", header.version);
+		return false;
+	}
+
+	std::vector<DecodedFormat> formats;
+	std::vector<u8> payload;
+	std::string line;
+	u32 thread = 0;
+	u64 records = 0;
+
+	EntryHeader entry;
+	while (gzread(file.get(), &entry, sizeof(entry)) == sizeof(entry))
+	{
+		if (entry.size < sizeof(entry) || (entry.size & 7) != 0)
+		{
+			fprintf(stderr, "Corrupt entry after %llu records\n", static_cast<unsigned long long>(records));
+			return false;
+		}
+
+		payload.resize(entry.size - sizeof(entry));
+		if (!payload.empty() && gzread(file.get(), payload.data(), static_cast<unsigned>(payload.size())) != static_cast<int>(payload.size()))
+		{
+			fprintf(stderr, "Truncated entry after %llu records\n", static_cast<unsigned long long>(records));
+			return false;
+		}
+
+		if (entry.id == DefineFormat)
+		{
+			u32 id;
+			if (payload.size() < sizeof(id) + 1)
+				return false;
+			memcpy(&id, payload.data(), sizeof(id));
+			if (id >= formats.size())
+				formats.resize(id + 1);
+			formats[id].text.assign(reinterpret_cast<const char*>(payload.data() + sizeof(id)), strnlen(reinterpret_cast<const char*>(payload.data() + sizeof(id)), payload.size() - sizeof(id)));
+			formats[id].specs = ParseFormat(formats[id].text.c_str());
+		}
+		else if (entry.id == SwitchThread)
+		{
+			u32 index;
+			if (payload.size() < sizeof(index))
+				return false;
+			memcpy(&index, payload.data(), sizeof(index));
+			if (index != thread && records != 0)
+				fprintf(out, "---- thread %u ----\n", index);
+			thread = index;
+		}
+		else
+		{
+			line.clear();
+			if (entry.id >= formats.size() || !FormatRecord(formats[entry.id], payload.data(), payload.size(), line))
+			{
+				fprintf(stderr, "Bad record with format %u after %llu records\n", entry.id, static_cast<unsigned long long>(records));
+				return false;
+			}
+			line += '\n';
+			fwrite(line.data(), 1, line.size(), out);
+			records++;
+		}
+	}
+
+	return true;
+}
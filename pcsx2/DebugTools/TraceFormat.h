@@ -0,0 +1,102 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// --------------------------------------------------------------------------------------
+//  Binary trace file format
+// --------------------------------------------------------------------------------------
+// Shared between the emulator (TraceRing.cpp) and the offline decoder (tools/tracedecode),
+// so this must not depend on anything else in pcsx2.
+//
+// A trace file is a gzip stream of a FileHeader followed by entries.  Every entry starts
+// with its size in bytes (header included, always a multiple of 8) and an id:
+//
+//   DefineFormat  - u32 format id, then the printf format, NUL terminated.  Written once per
+//                   file before the first record using that format.
+//   SwitchThread  - u32 thread index.  Records that follow came from that thread.
+//   anything else - a record using that format id, followed by one 8 byte slot per argument
+//                   of the format.  Strings are a u32 length followed by the characters,
+//                   padded to 8 bytes.
+
+#include "common/Pcsx2Types.h"
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace TraceFormat
+{
+	static constexpr char Magic[8] = {'P', 'S', '2', 'T', 'R', 'A', 'C', 'E'};
+	static constexpr u32 Version = 1;
+
+	static constexpr u32 DefineFormat = 0xFFFFFFFF;
+	static constexpr u32 SwitchThread = 0xFFFFFFFE;
+
+	// Longer string arguments are truncated.
+	static constexpr u32 MaxStringLength = 1024;
+
+	struct FileHeader
+	{
+		char magic[8];
+		u32 version;
+		u32 reserved;
+	};
+
+	struct EntryHeader
+	{
+		u32 size;
+		u32 id;
+	};
+
+	// How an argument is read from the va_list, every one of them is stored in 64 bits.
+	enum class ArgKind : u8
+	{
+		Int,
+		UInt,
+		Long,
+		ULong,
+		Int64,
+		UInt64,
+		SizeT,
+		Double,
+		LongDouble,
+		String,
+		Pointer,
+		Count, // %n, nothing is stored
+	};
+
+	// One conversion of a printf format, with the arguments it consumes.
+	struct Spec
+	{
+		size_t begin; // offset of the '%'
+		size_t end; // one past the conversion character
+		char conversion;
+		bool star_width;
+		bool star_precision;
+		ArgKind kind;
+	};
+
+	std::vector<Spec> ParseFormat(const char* fmt);
+
+	static constexpr u32 Align(u32 size) { return (size + 7) & ~7u; }
+
+	// Appends the arguments of a record to it.  The first prefix_count arguments come from
+	// prefix_args, the rest from the va_list.
+	void EncodeArgs(const std::vector<Spec>& specs, const u32* prefix_args, u32 prefix_count, va_list list, std::vector<u8>& record);
+
+	// Converts a trace file to text, returns false and prints the reason to stderr on errors.
+	bool Decode(const char* path, FILE* out);
+} // namespace TraceFormat
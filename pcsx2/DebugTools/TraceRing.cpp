@@ -0,0 +1,366 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+
+#include "TraceRing.h"
+#include "TraceFormat.h"
+#include "Debug.h"
+#include "common/PersistentThread.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <zlib.h>
+
+using namespace TraceFormat;
+
+namespace
+{
+	struct RegisteredFormat
+	{
+		u32 id;
+		size_t prefix_length;
+		std::string text;
+		std::vector<Spec> specs;
+	};
+
+	// Written by its owning thread only, read by the writer thread only.  Positions are free
+	// running and wrap at 2^32, records never straddle the end of the buffer: a zero size
+	// marks the rest of the buffer as unused.
+	struct ThreadRing
+	{
+		static constexpr u32 Size = 1 << 20;
+		static constexpr u32 Mask = Size - 1;
+
+		alignas(64) std::atomic<u32> write_pos{0};
+		alignas(64) std::atomic<u32> read_pos{0};
+		std::atomic<bool> owned{true};
+		u32 index = 0;
+		std::unique_ptr<u8[]> data{new u8[Size]};
+	};
+
+	// Rings are never freed, a thread that exits hands its ring over to the next new thread.
+	struct RingHandle
+	{
+		ThreadRing* ring = nullptr;
+
+		~RingHandle()
+		{
+			if (ring)
+				ring->owned.store(false, std::memory_order_release);
+		}
+	};
+
+	struct FormatKey
+	{
+		const SysTraceLog* source;
+		const char* fmt;
+
+		bool operator==(const FormatKey& right) const { return source == right.source && fmt == right.fmt; }
+	};
+
+	struct FormatKeyHash
+	{
+		size_t operator()(const FormatKey& key) const
+		{
+			return std::hash<const void*>()(key.source) ^ (std::hash<const void*>()(key.fmt) * 31);
+		}
+	};
+} // namespace
+
+static std::mutex s_formats_mutex;
+static std::vector<std::unique_ptr<RegisteredFormat>> s_formats;
+static std::unordered_map<std::string, std::unordered_map<const SysTraceLog*, RegisteredFormat*>> s_format_map;
+
+static std::mutex s_rings_mutex;
+static std::vector<std::unique_ptr<ThreadRing>> s_rings;
+
+static std::mutex s_open_mutex;
+static std::atomic<bool> s_open{false};
+
+static std::mutex s_writer_mutex;
+static std::condition_variable s_writer_cv;
+static std::thread s_writer_thread;
+static bool s_writer_exit = false;
+
+// Only touched by the writer thread while a file is open.
+static gzFile s_file = nullptr;
+static std::vector<bool> s_defined;
+static u32 s_last_thread = 0;
+
+// Formats are nearly always literals, so the address of the format identifies it.  The
+// per thread cache keeps the shared map and its lock off the hot path, and the text is
+// compared anyway for the odd log which formats into a reused buffer.
+static const RegisteredFormat* LookupFormat(const SysTraceLog& source, const char* fmt)
+{
+	thread_local std::unordered_map<FormatKey, const RegisteredFormat*, FormatKeyHash> cache;
+
+	const FormatKey key = {&source, fmt};
+	auto cached = cache.find(key);
+	if (cached != cache.end() && strcmp(cached->second->text.c_str() + cached->second->prefix_length, fmt) == 0)
+		return cached->second;
+
+	std::unique_lock<std::mutex> lock(s_formats_mutex);
+	RegisteredFormat*& format = s_format_map[fmt][&source];
+	if (!format)
+	{
+		std::unique_ptr<RegisteredFormat> entry = std::make_unique<RegisteredFormat>();
+		entry->id = static_cast<u32>(s_formats.size());
+		entry->text = source.GetPrefixFormat();
+		entry->prefix_length = entry->text.size();
+		entry->text += fmt;
+		entry->specs = ParseFormat(entry->text.c_str());
+		format = entry.get();
+		s_formats.push_back(std::move(entry));
+	}
+
+	cache[key] = format;
+	return format;
+}
+
+static ThreadRing* GetThreadRing()
+{
+	thread_local RingHandle handle;
+	if (handle.ring)
+		return handle.ring;
+
+	std::unique_lock<std::mutex> lock(s_rings_mutex);
+	for (const std::unique_ptr<ThreadRing>& ring : s_rings)
+	{
+		if (!ring->owned.load(std::memory_order_acquire) &&
+			ring->read_pos.load(std::memory_order_acquire) == ring->write_pos.load(std::memory_order_relaxed))
+		{
+			ring->owned.store(true, std::memory_order_relaxed);
+			handle.ring = ring.get();
+			return handle.ring;
+		}
+	}
+
+	s_rings.push_back(std::make_unique<ThreadRing>());
+	handle.ring = s_rings.back().get();
+	handle.ring->index = static_cast<u32>(s_rings.size() - 1);
+	return handle.ring;
+}
+
+bool TraceRing::Write(const SysTraceLog& source, const char* fmt, const u32* prefix_args, u32 prefix_count, va_list list)
+{
+	if (!s_open.load(std::memory_order_acquire))
+		return false;
+
+	const RegisteredFormat* format = LookupFormat(source, fmt);
+
+	thread_local std::vector<u8> record;
+	record.resize(sizeof(EntryHeader));
+
+	EncodeArgs(format->specs, prefix_args, prefix_count, list, record);
+
+	const EntryHeader header = {static_cast<u32>(record.size()), format->id};
+	memcpy(record.data(), &header, sizeof(header));
+
+	ThreadRing* ring = GetThreadRing();
+	const u32 size = header.size;
+	if (size > ThreadRing::Size / 2)
+		return true;
+
+	u32 pos = ring->write_pos.load(std::memory_order_relaxed);
+	const u32 tail = ThreadRing::Size - (pos & ThreadRing::Mask);
+	const u32 needed = (tail < size) ? tail + size : size;
+
+	// Tracing is lossless, if the writer fell behind wait for it to catch up.
+	while (ThreadRing::Size - (pos - ring->read_pos.load(std::memory_order_acquire)) < needed)
+	{
+		if (!s_open.load(std::memory_order_acquire))
+			return true;
+
+		s_writer_cv.notify_one();
+		std::this_thread::yield();
+	}
+
+	if (tail < size)
+	{
+		const u32 marker = 0;
+		memcpy(&ring->data[pos & ThreadRing::Mask], &marker, sizeof(marker));
+		pos += tail;
+	}
+
+	memcpy(&ring->data[pos & ThreadRing::Mask], record.data(), size);
+	pos += size;
+	ring->write_pos.store(pos, std::memory_order_release);
+
+	if (pos - ring->read_pos.load(std::memory_order_relaxed) > ThreadRing::Size / 2)
+		s_writer_cv.notify_one();
+
+	return true;
+}
+
+// --------------------------------------------------------------------------------------
+//  Writer thread
+// --------------------------------------------------------------------------------------
+
+static void WriteEntry(u32 id, const void* payload, u32 payload_size)
+{
+	static const u8 zero[8] = {};
+
+	const EntryHeader header = {Align(sizeof(EntryHeader) + payload_size), id};
+	gzwrite(s_file, &header, sizeof(header));
+	gzwrite(s_file, payload, payload_size);
+	gzwrite(s_file, zero, header.size - sizeof(EntryHeader) - payload_size);
+}
+
+static void DefineFormatIfNeeded(u32 id)
+{
+	if (id < s_defined.size() && s_defined[id])
+		return;
+
+	std::string text;
+	{
+		std::unique_lock<std::mutex> lock(s_formats_mutex);
+		if (id >= s_formats.size())
+			return;
+		text = s_formats[id]->text;
+	}
+
+	std::vector<u8> payload(sizeof(id) + text.size() + 1, 0);
+	memcpy(payload.data(), &id, sizeof(id));
+	memcpy(payload.data() + sizeof(id), text.c_str(), text.size());
+	WriteEntry(DefineFormat, payload.data(), static_cast<u32>(payload.size()));
+
+	if (id >= s_defined.size())
+		s_defined.resize(id + 1);
+	s_defined[id] = true;
+}
+
+static void DrainRing(ThreadRing& ring)
+{
+	u32 pos = ring.read_pos.load(std::memory_order_relaxed);
+	const u32 end = ring.write_pos.load(std::memory_order_acquire);
+	if (pos == end)
+		return;
+
+	if (ring.index != s_last_thread)
+	{
+		WriteEntry(SwitchThread, &ring.index, sizeof(ring.index));
+		s_last_thread = ring.index;
+	}
+
+	while (pos != end)
+	{
+		const u32 offset = pos & ThreadRing::Mask;
+
+		EntryHeader header;
+		memcpy(&header, &ring.data[offset], sizeof(header));
+		if (header.size == 0)
+		{
+			pos += ThreadRing::Size - offset;
+			continue;
+		}
+
+		DefineFormatIfNeeded(header.id);
+		gzwrite(s_file, &ring.data[offset], header.size);
+		pos += header.size;
+	}
+
+	ring.read_pos.store(pos, std::memory_order_release);
+}
+
+static void DrainRings()
+{
+	std::vector<ThreadRing*> rings;
+	{
+		std::unique_lock<std::mutex> lock(s_rings_mutex);
+		for (const std::unique_ptr<ThreadRing>& ring : s_rings)
+			rings.push_back(ring.get());
+	}
+
+	for (ThreadRing* ring : rings)
+		DrainRing(*ring);
+}
+
+static void WriterThread()
+{
+	Threading::SetNameOfCurrentThread("Trace Writer");
+
+	std::unique_lock<std::mutex> lock(s_writer_mutex);
+	while (!s_writer_exit)
+	{
+		s_writer_cv.wait_for(lock, std::chrono::milliseconds(20));
+
+		lock.unlock();
+		DrainRings();
+		lock.lock();
+	}
+
+	lock.unlock();
+	DrainRings();
+}
+
+bool TraceRing::Open(const std::string& path)
+{
+	std::unique_lock<std::mutex> lock(s_open_mutex);
+	if (s_open.load(std::memory_order_relaxed))
+		return true;
+
+	// Level 1, the writer has to keep up with the emulation threads.
+	gzFile file = gzopen(path.c_str(), "wb1");
+	if (!file)
+		return false;
+
+	FileHeader header = {};
+	memcpy(header.magic, Magic, sizeof(Magic));
+	header.version = Version;
+	if (gzwrite(file, &header, sizeof(header)) != sizeof(header))
+	{
+		gzclose(file);
+		return false;
+	}
+
+	s_file = file;
+	s_defined.clear();
+	s_last_thread = ~0u;
+	s_writer_exit = false;
+	s_writer_thread = std::thread(WriterThread);
+	s_open.store(true, std::memory_order_release);
+
+	Console.WriteLn("Writing binary trace log to %s", path.c_str());
+	return true;
+}
+
+void TraceRing::Close()
+{
+	std::unique_lock<std::mutex> lock(s_open_mutex);
+	if (!s_open.load(std::memory_order_relaxed))
+		return;
+
+	s_open.store(false, std::memory_order_release);
+	{
+		std::unique_lock<std::mutex> writer_lock(s_writer_mutex);
+		s_writer_exit = true;
+	}
+	s_writer_cv.notify_one();
+	s_writer_thread.join();
+
+	gzclose(s_file);
+	s_file = nullptr;
+}
+
+bool TraceRing::IsOpen()
+{
+	return s_open.load(std::memory_order_acquire);
+}
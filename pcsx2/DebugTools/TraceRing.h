@@ -0,0 +1,45 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdarg>
+#include <string>
+
+class SysTraceLog;
+
+// --------------------------------------------------------------------------------------
+//  TraceRing  (binary trace logging)
+// --------------------------------------------------------------------------------------
+// Records trace log writes without formatting them: each emulation thread appends the id of
+// the format string and the raw arguments to a ring of its own, and a background thread
+// drains the rings into a compressed trace file.  The file is self describing and can be
+// converted to the usual text log with tools/tracedecode.  See TraceFormat.h for the layout.
+//
+namespace TraceRing
+{
+	// Starts writing to the given trace file, unless one is already open.
+	extern bool Open(const std::string& path);
+
+	// Writes out everything recorded so far and closes the trace file.
+	extern void Close();
+
+	extern bool IsOpen();
+
+	// Records a write to the given log.  The first prefix_count arguments of the log's
+	// binary format come from prefix_args, the rest from the va_list.  Returns false if no
+	// trace file is open, in which case nothing is read from the va_list.
+	extern bool Write(const SysTraceLog& source, const char* fmt, const u32* prefix_args, u32 prefix_count, va_list list);
+} // namespace TraceRing
@@ -182,12 +182,16 @@ void ElfObject::checkElfSize(s64 elfsize)
 
 u32 ElfObject::getCRC()
 {
+	if (hasCRC) return crc;
+
 	u32 CRC = 0;
 
 	const u32* srcdata = (u32*)data.GetPtr();
 	for(u32 i=data.GetSizeInBytes()/4; i; --i, ++srcdata)
 		CRC ^= *srcdata;
 
+	crc = CRC;
+	hasCRC = true;
 	return CRC;
 }
 
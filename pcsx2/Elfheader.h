@@ -130,6 +130,8 @@ class ElfObject
 		ELF_PHR* proghead;
 		ELF_SHR* secthead;
 		wxString filename;
+		u32 crc = 0;
+		bool hasCRC = false;
 
 		void initElfHeaders();
 		void readIso(IsoFile& file);
@@ -156,6 +158,8 @@ class ElfObject
 		bool hasHeaders();
 
 		std::pair<u32,u32> getTextRange();
+
+		// The CRC is computed once and kept, so the thread loading the ELF can compute it ahead of time.
 		u32 getCRC();
 };
 
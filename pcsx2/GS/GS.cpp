@@ -1270,6 +1270,10 @@ void GSApp::Init()
 	m_default_configuration["shaderfx"]                                   = "0";
 	m_default_configuration["shaderfx_conf"]                              = "shaders/GS_FX_Settings.ini";
 	m_default_configuration["shaderfx_glsl"]                              = "shaders/GS.fx";
+	m_default_configuration["texture_budget_hw"]                          = "0";
+	m_default_configuration["texture_budget_sw"]                          = "256";
+	m_default_configuration["texture_upload_dedup"]                       = "0";
+	m_default_configuration["threaded_cvb_sw"]                            = "0";
 	m_default_configuration["TVShader"]                                   = "0";
 	m_default_configuration["upscale_multiplier"]                         = "1";
 	m_default_configuration["UserHacks"]                                  = "0";
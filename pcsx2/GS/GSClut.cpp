@@ -30,6 +30,10 @@ GSClut::GSClut(GSLocalMemory* mem)
 	m_write.dirty = true;
 	m_read.dirty = true;
 
+	m_cache = (ReadCache*)_aligned_malloc(sizeof(ReadCache) * ReadCacheSize, 32);
+	memset(m_cache, 0, sizeof(ReadCache) * ReadCacheSize);
+	m_cached = nullptr;
+
 	for (int i = 0; i < 16; i++)
 	{
 		for (int j = 0; j < 64; j++)
@@ -99,6 +103,7 @@ GSClut::GSClut(GSLocalMemory* mem)
 
 GSClut::~GSClut()
 {
+	_aligned_free(m_cache);
 	vmfree(m_clut, CLUT_ALLOC_SIZE);
 }
 
@@ -300,44 +305,105 @@ void GSClut::Read32(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
 		m_read.TEXA = TEXA;
 		m_read.dirty = false;
 		m_read.adirty = true;
+		m_cached = nullptr;
 
-		uint16* clut = m_clut;
+		const uint16* src[2] = {};
+		int count[2] = {};
+		int offset = 0;
+		bool i8;
+
+		switch (TEX0.PSM)
+		{
+			case PSM_PSMT8:
+			case PSM_PSMT8H:
+				i8 = true;
+				break;
+			case PSM_PSMT4:
+			case PSM_PSMT4HL:
+			case PSM_PSMT4HH:
+				i8 = false;
+				break;
+			default:
+				return;
+		}
 
+		// Entries the conversion reads from
 		if (TEX0.CPSM == PSM_PSMCT32 || TEX0.CPSM == PSM_PSMCT24)
 		{
-			switch (TEX0.PSM)
+			if (i8)
 			{
-				case PSM_PSMT8:
-				case PSM_PSMT8H:
-					ReadCLUT_T32_I8(clut, m_buff32, (TEX0.CSA & 15) << 4);
-					break;
-				case PSM_PSMT4:
-				case PSM_PSMT4HL:
-				case PSM_PSMT4HH:
-					clut += (TEX0.CSA & 15) << 4;
-					// TODO: merge these functions
-					ReadCLUT_T32_I4(clut, m_buff32);
-					ExpandCLUT64_T32_I8(m_buff32, (uint64*)m_buff64); // sw renderer does not need m_buff64 anymore
-					break;
+				offset = (TEX0.CSA & 15) << 4;
+				src[0] = m_clut;
+				count[0] = 512;
+			}
+			else
+			{
+				src[0] = m_clut + ((TEX0.CSA & 15) << 4);
+				src[1] = src[0] + 256;
+				count[0] = 16;
+				count[1] = 16;
 			}
 		}
 		else if (TEX0.CPSM == PSM_PSMCT16 || TEX0.CPSM == PSM_PSMCT16S)
 		{
-			switch (TEX0.PSM)
+			src[0] = m_clut + (TEX0.CSA << 4);
+			count[0] = i8 ? 256 : 16;
+		}
+		else
+		{
+			return;
+		}
+
+		const uint64 key = TEXA.TA0 | (TEXA.AEM << 8) | (TEXA.TA1 << 16) | ((uint64)TEX0.CPSM << 32) | ((uint64)i8 << 40) | ((uint64)offset << 48);
+		const uint64 hash = HashCLUT(src[1], count[1], HashCLUT(src[0], count[0], key));
+
+		ReadCache* entry = &m_cache[(hash ^ (hash >> 32)) & (ReadCacheSize - 1)];
+
+		m_cached = entry;
+		m_buff32 = entry->buff32;
+		m_buff64 = entry->buff64;
+
+		if (entry->valid && entry->key == key && entry->hash == hash &&
+			CompareCLUT(entry->src, src[0], count[0]) && CompareCLUT(entry->src + count[0], src[1], count[1]))
+		{
+			m_read.adirty = entry->adirty;
+			m_read.amin = entry->amin;
+			m_read.amax = entry->amax;
+			return;
+		}
+
+		memcpy(entry->src, src[0], count[0] * sizeof(uint16));
+		if (count[1])
+			memcpy(entry->src + count[0], src[1], count[1] * sizeof(uint16));
+		entry->key = key;
+		entry->hash = hash;
+		entry->adirty = true;
+		entry->valid = true;
+
+		if (TEX0.CPSM == PSM_PSMCT32 || TEX0.CPSM == PSM_PSMCT24)
+		{
+			if (i8)
 			{
-				case PSM_PSMT8:
-				case PSM_PSMT8H:
-					clut += TEX0.CSA << 4;
-					Expand16(clut, m_buff32, 256, TEXA);
-					break;
-				case PSM_PSMT4:
-				case PSM_PSMT4HL:
-				case PSM_PSMT4HH:
-					clut += TEX0.CSA << 4;
-					// TODO: merge these functions
-					Expand16(clut, m_buff32, 16, TEXA);
-					ExpandCLUT64_T32_I8(m_buff32, (uint64*)m_buff64); // sw renderer does not need m_buff64 anymore
-					break;
+				ReadCLUT_T32_I8(m_clut, m_buff32, offset);
+			}
+			else
+			{
+				// TODO: merge these functions
+				ReadCLUT_T32_I4(src[0], m_buff32);
+				ExpandCLUT64_T32_I8(m_buff32, (uint64*)m_buff64); // sw renderer does not need m_buff64 anymore
+			}
+		}
+		else
+		{
+			if (i8)
+			{
+				Expand16(src[0], m_buff32, 256, TEXA);
+			}
+			else
+			{
+				// TODO: merge these functions
+				Expand16(src[0], m_buff32, 16, TEXA);
+				ExpandCLUT64_T32_I8(m_buff32, (uint64*)m_buff64); // sw renderer does not need m_buff64 anymore
 			}
 		}
 	}
@@ -404,6 +470,13 @@ void GSClut::GetAlphaMinMax32(int& amin_out, int& amax_out)
 			m_read.amin = v0.min_i16(v1).extract16<0>();
 			m_read.amax = v0.max_i16(v1).extract16<1>();
 		}
+
+		if (m_cached)
+		{
+			m_cached->amin = m_read.amin;
+			m_cached->amax = m_read.amax;
+			m_cached->adirty = false;
+		}
 	}
 
 	amin_out = m_read.amin;
@@ -518,6 +591,22 @@ void GSClut::ReadCLUT_T32_I8(const uint16* RESTRICT clut, uint32* RESTRICT dst,
 
 __forceinline void GSClut::ReadCLUT_T32_I4(const uint16* RESTRICT clut, uint32* RESTRICT dst)
 {
+#if _M_SSE >= 0x501
+
+	GSVector8i* s = (GSVector8i*)clut;
+	GSVector8i* d = (GSVector8i*)dst;
+
+	GSVector8i lo = s[0];
+	GSVector8i hi = s[16];
+
+	GSVector8i v0 = lo.upl16(hi);
+	GSVector8i v1 = lo.uph16(hi);
+
+	d[0] = v0.ac(v1);
+	d[1] = v0.bd(v1);
+
+#else
+
 	GSVector4i* s = (GSVector4i*)clut;
 	GSVector4i* d = (GSVector4i*)dst;
 
@@ -532,6 +621,8 @@ __forceinline void GSClut::ReadCLUT_T32_I4(const uint16* RESTRICT clut, uint32*
 	d[1] = v1;
 	d[2] = v2;
 	d[3] = v3;
+
+#endif
 }
 
 #if 0
@@ -615,6 +706,27 @@ __forceinline void GSClut::ReadCLUT_T16_I4(const uint16* RESTRICT clut, uint32*
 
 void GSClut::ExpandCLUT64_T32_I8(const uint32* RESTRICT src, uint64* RESTRICT dst)
 {
+#if _M_SSE >= 0x501
+
+	GSVector8i* s = (GSVector8i*)src;
+	GSVector8i* d = (GSVector8i*)dst;
+
+	// unpacking works within lanes, swap the middle qwords so the pairs come out in order
+	GSVector8i lo0 = s[0].acbd();
+	GSVector8i lo1 = s[1].acbd();
+
+	for (int i = 0; i < 16; i++, d += 4)
+	{
+		GSVector8i hi = GSVector8i::broadcast32(&src[i]);
+
+		d[0] = lo0.upl32(hi);
+		d[1] = lo0.uph32(hi);
+		d[2] = lo1.upl32(hi);
+		d[3] = lo1.uph32(hi);
+	}
+
+#else
+
 	GSVector4i* s = (GSVector4i*)src;
 	GSVector4i* d = (GSVector4i*)dst;
 
@@ -627,6 +739,8 @@ void GSClut::ExpandCLUT64_T32_I8(const uint32* RESTRICT src, uint64* RESTRICT ds
 	ExpandCLUT64_T32(s1, s0, s1, s2, s3, &d[32]);
 	ExpandCLUT64_T32(s2, s0, s1, s2, s3, &d[64]);
 	ExpandCLUT64_T32(s3, s0, s1, s2, s3, &d[96]);
+
+#endif
 }
 
 __forceinline void GSClut::ExpandCLUT64_T32(const GSVector4i& hi, const GSVector4i& lo0, const GSVector4i& lo1, const GSVector4i& lo2, const GSVector4i& lo3, GSVector4i* dst)
@@ -707,6 +821,49 @@ CONSTINIT const GSVector4i GSClut::m_rm = GSVector4i::cxpr(0x0000001f);
 
 void GSClut::Expand16(const uint16* RESTRICT src, uint32* RESTRICT dst, int w, const GIFRegTEXA& TEXA)
 {
+#if _M_SSE >= 0x501
+
+	ASSERT((w & 15) == 0);
+
+	const GSVector8i rm = GSVector8i::broadcast32(m_rm);
+	const GSVector8i gm = GSVector8i::broadcast32(m_gm);
+	const GSVector8i bm = GSVector8i::broadcast32(m_bm);
+
+	GSVector8i TA0(TEXA.TA0 << 24);
+	GSVector8i TA1(TEXA.TA1 << 24);
+
+	GSVector8i c, cl, ch;
+
+	const GSVector8i* s = (const GSVector8i*)src;
+	GSVector8i* d = (GSVector8i*)dst;
+
+	// unpacking works within lanes, swap the middle qwords so the colors come out in order
+
+	if (!TEXA.AEM)
+	{
+		for (int i = 0, j = w >> 4; i < j; i++)
+		{
+			c = s[i].acbd();
+			cl = c.upl16(c);
+			ch = c.uph16(c);
+			d[i * 2 + 0] = ((cl & rm) << 3) | ((cl & gm) << 6) | ((cl & bm) << 9) | TA0.blend8(TA1, cl.sra16(15));
+			d[i * 2 + 1] = ((ch & rm) << 3) | ((ch & gm) << 6) | ((ch & bm) << 9) | TA0.blend8(TA1, ch.sra16(15));
+		}
+	}
+	else
+	{
+		for (int i = 0, j = w >> 4; i < j; i++)
+		{
+			c = s[i].acbd();
+			cl = c.upl16(c);
+			ch = c.uph16(c);
+			d[i * 2 + 0] = ((cl & rm) << 3) | ((cl & gm) << 6) | ((cl & bm) << 9) | TA0.blend8(TA1, cl.sra16(15)).andnot(cl == GSVector8i::zero());
+			d[i * 2 + 1] = ((ch & rm) << 3) | ((ch & gm) << 6) | ((ch & bm) << 9) | TA0.blend8(TA1, ch.sra16(15)).andnot(ch == GSVector8i::zero());
+		}
+	}
+
+#else
+
 	ASSERT((w & 7) == 0);
 
 	const GSVector4i rm = m_rm;
@@ -743,6 +900,83 @@ void GSClut::Expand16(const uint16* RESTRICT src, uint32* RESTRICT dst, int w, c
 			d[i * 2 + 1] = ((ch & rm) << 3) | ((ch & gm) << 6) | ((ch & bm) << 9) | TA0.blend8(TA1, ch.sra16(15)).andnot(ch == GSVector4i::zero());
 		}
 	}
+
+#endif
+}
+
+// Only picks the cache entry, a matching entry is still compared with the current CLUT.
+// count is a multiple of 16.
+uint64 GSClut::HashCLUT(const uint16* RESTRICT src, int count, uint64 hash)
+{
+#if _M_SSE >= 0x501
+
+	const GSVector8i* s = (const GSVector8i*)src;
+
+	GSVector8i sum = GSVector8i::zero();
+	GSVector8i mix = GSVector8i::zero();
+
+	for (int i = 0, j = count >> 4; i < j; i++)
+	{
+		sum = sum.add32(s[i]);
+		mix = (mix.sll32(5) | mix.srl32(27)) ^ s[i];
+	}
+
+	GSVector4i a = sum.extract<0>().add32(sum.extract<1>());
+	GSVector4i b = mix.extract<0>() ^ mix.extract<1>();
+
+#else
+
+	const GSVector4i* s = (const GSVector4i*)src;
+
+	GSVector4i a = GSVector4i::zero();
+	GSVector4i b = GSVector4i::zero();
+
+	for (int i = 0, j = count >> 3; i < j; i++)
+	{
+		a = a.add32(s[i]);
+		b = (b.sll32(5) | b.srl32(27)) ^ s[i];
+	}
+
+#endif
+
+	alignas(16) uint64 v[4];
+
+	GSVector4i::store<true>(&v[0], a);
+	GSVector4i::store<true>(&v[2], b);
+
+	for (uint64 x : v)
+		hash = (hash ^ x) * 0x100000001b3ull;
+
+	return hash;
+}
+
+bool GSClut::CompareCLUT(const uint16* RESTRICT a, const uint16* RESTRICT b, int count)
+{
+#if _M_SSE >= 0x501
+
+	const GSVector8i* s = (const GSVector8i*)a;
+	const GSVector8i* d = (const GSVector8i*)b;
+
+	for (int i = 0, j = count >> 4; i < j; i++)
+	{
+		if (!s[i].eq(d[i]))
+			return false;
+	}
+
+#else
+
+	const GSVector4i* s = (const GSVector4i*)a;
+	const GSVector4i* d = (const GSVector4i*)b;
+
+	for (int i = 0, j = count >> 3; i < j; i++)
+	{
+		if (!s[i].eq(d[i]))
+			return false;
+	}
+
+#endif
+
+	return true;
 }
 
 //
@@ -54,6 +54,25 @@ class alignas(32) GSClut : public GSAlignedClass<32>
 		bool IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
 	} m_read;
 
+	// Recently read CLUTs with the entries they were read from, so switching back to a palette
+	// used before skips the conversion (and the alpha range scan).
+	struct alignas(32) ReadCache
+	{
+		uint16 src[512];
+		uint32 buff32[256];
+		uint64 buff64[256];
+		uint64 key; // formats, offset and TEXA the conversion depends on
+		uint64 hash;
+		int amin, amax;
+		bool adirty;
+		bool valid;
+	};
+
+	static const int ReadCacheSize = 16;
+
+	ReadCache* m_cache;
+	ReadCache* m_cached; // entry of the last read, m_buff32 and m_buff64 point into it
+
 	typedef void (GSClut::*writeCLUT)(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT);
 
 	writeCLUT m_wc[2][16][64];
@@ -78,7 +97,6 @@ class alignas(32) GSClut : public GSAlignedClass<32>
 	static void WriteCLUT_T32_I4_CSM1(const uint32* RESTRICT src, uint16* RESTRICT clut);
 	static void WriteCLUT_T16_I8_CSM1(const uint16* RESTRICT src, uint16* RESTRICT clut);
 	static void WriteCLUT_T16_I4_CSM1(const uint16* RESTRICT src, uint16* RESTRICT clut);
-	static void ReadCLUT_T32_I8(const uint16* RESTRICT clut, uint32* RESTRICT dst, int offset);
 	static void ReadCLUT_T32_I4(const uint16* RESTRICT clut, uint32* RESTRICT dst);
 	//static void ReadCLUT_T32_I4(const uint16* RESTRICT clut, uint32* RESTRICT dst32, uint64* RESTRICT dst64);
 	//static void ReadCLUT_T16_I8(const uint16* RESTRICT clut, uint32* RESTRICT dst);
@@ -86,6 +104,8 @@ class alignas(32) GSClut : public GSAlignedClass<32>
 	//static void ReadCLUT_T16_I4(const uint16* RESTRICT clut, uint32* RESTRICT dst32, uint64* RESTRICT dst64);
 public:
 	static void ExpandCLUT64_T32_I8(const uint32* RESTRICT src, uint64* RESTRICT dst);
+	static void ReadCLUT_T32_I8(const uint16* RESTRICT clut, uint32* RESTRICT dst, int offset);
+	static void Expand16(const uint16* RESTRICT src, uint32* RESTRICT dst, int w, const GIFRegTEXA& TEXA);
 
 private:
 	static void ExpandCLUT64_T32(const GSVector4i& hi, const GSVector4i& lo0, const GSVector4i& lo1, const GSVector4i& lo2, const GSVector4i& lo3, GSVector4i* dst);
@@ -94,7 +114,8 @@ private:
 	static void ExpandCLUT64_T16(const GSVector4i& hi, const GSVector4i& lo0, const GSVector4i& lo1, const GSVector4i& lo2, const GSVector4i& lo3, GSVector4i* dst);
 	static void ExpandCLUT64_T16(const GSVector4i& hi, const GSVector4i& lo, GSVector4i* dst);
 
-	static void Expand16(const uint16* RESTRICT src, uint32* RESTRICT dst, int w, const GIFRegTEXA& TEXA);
+	static uint64 HashCLUT(const uint16* RESTRICT src, int count, uint64 hash);
+	static bool CompareCLUT(const uint16* RESTRICT a, const uint16* RESTRICT b, int count);
 
 public:
 	GSClut(GSLocalMemory* mem);
@@ -110,6 +131,10 @@ public:
 
 	uint32 operator[](size_t i) const { return m_buff32[i]; }
 
+	// CLUT buffer as written by Write, 16 bits per entry (the upper halves of 32 bit colors
+	// start at entry 256).  Only the tests fill it directly.
+	uint16* GetBuffer() { return m_clut; }
+
 	operator const uint32*() const { return m_buff32; }
 	operator const uint64*() const { return m_buff64; }
 };
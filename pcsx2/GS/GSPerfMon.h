@@ -39,6 +39,10 @@ public:
 		Fillrate,
 		Quad,
 		SyncPoint,
+		TextureHit,
+		TextureMiss,
+		TextureInvalidation,
+		UploadSkipped,
 		CounterLast,
 	};
 
@@ -25,6 +25,7 @@ class GSJobQueue final
 private:
 	std::thread m_thread;
 	std::function<void(T&)> m_func;
+	std::function<void()> m_startup;
 	bool m_exit;
 	ringbuffer_base<T, CAPACITY> m_queue;
 
@@ -35,6 +36,9 @@ private:
 
 	void ThreadProc()
 	{
+		if (m_startup)
+			m_startup();
+
 		std::unique_lock<std::mutex> l(m_lock);
 
 		while (true)
@@ -43,13 +47,18 @@ private:
 			while (m_queue.empty())
 			{
 				if (m_exit)
+				{
+					Threading::ReleaseCurrentThread();
 					return;
+				}
 
 				m_notempty.wait(l);
 			}
 
 			l.unlock();
 
+			Threading::SampleThreadPlacement();
+
 			uint32 waited = 0;
 			while (true)
 			{
@@ -74,8 +83,10 @@ private:
 	}
 
 public:
-	GSJobQueue(std::function<void(T&)> func)
+	// startup runs on the worker thread before the first job, e.g. to place the thread.
+	GSJobQueue(std::function<void(T&)> func, std::function<void()> startup = nullptr)
 		: m_func(func)
+		, m_startup(startup)
 		, m_exit(false)
 	{
 		m_thread = std::thread(&GSJobQueue::ThreadProc, this);
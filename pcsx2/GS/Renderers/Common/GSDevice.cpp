@@ -26,6 +26,8 @@ GSDevice::GSDevice()
 	, m_blend(NULL)
 	, m_target_tmp(NULL)
 	, m_current(NULL)
+	, m_pool_count(0)
+	, m_pool_memory(0)
 	, m_frame(0)
 {
 	memset(&m_vertex, 0, sizeof(m_vertex));
@@ -35,8 +37,7 @@ GSDevice::GSDevice()
 
 GSDevice::~GSDevice()
 {
-	for (auto t : m_pool)
-		delete t;
+	ClearPool();
 
 	delete m_backbuffer;
 	delete m_merge;
@@ -52,10 +53,7 @@ bool GSDevice::Create(const WindowInfo& wi)
 
 bool GSDevice::Reset(int w, int h)
 {
-	for (auto t : m_pool)
-		delete t;
-
-	m_pool.clear();
+	ClearPool();
 
 	delete m_backbuffer;
 	delete m_merge;
@@ -106,33 +104,79 @@ void GSDevice::Present(GSTexture* sTex, GSTexture* dTex, const GSVector4& dRect,
 
 GSTexture* GSDevice::FetchSurface(int type, int w, int h, int format)
 {
-	const GSVector2i size(w, h);
+	auto i = m_pool.find(GetPoolKey(type, format, w, h));
 
-	for (auto i = m_pool.begin(); i != m_pool.end(); ++i)
+	if (i != m_pool.end() && !i->second.empty())
 	{
-		GSTexture* t = *i;
+		GSTexture* t = i->second.front();
 
-		if (t->GetType() == type && t->GetFormat() == format && t->GetSize() == size)
-		{
-			m_pool.erase(i);
+		i->second.pop_front();
 
-			return t;
-		}
+		m_pool_count--;
+		m_pool_memory -= t->GetMemUsage();
+
+		return t;
 	}
 
 	return CreateSurface(type, w, h, format);
 }
 
-void GSDevice::PrintMemoryUsage()
+GSTexture* GSDevice::GetPoolLRU()
 {
-#ifdef ENABLE_OGL_DEBUG
-	uint32 pool = 0;
-	for (auto t : m_pool)
+	// The number of size classes in use is small, checking the tail of every bucket is cheap
+
+	GSTexture* lru = NULL;
+
+	for (const auto& i : m_pool)
+	{
+		if (!i.second.empty() && (lru == NULL || m_frame - i.second.back()->last_frame_used > m_frame - lru->last_frame_used))
+		{
+			lru = i.second.back();
+		}
+	}
+
+	return lru;
+}
+
+void GSDevice::EvictPoolLRU()
+{
+	GSTexture* t = GetPoolLRU();
+
+	if (t == NULL)
+		return;
+
+	auto i = m_pool.find(GetPoolKey(t->GetType(), t->GetFormat(), t->GetWidth(), t->GetHeight()));
+
+	i->second.pop_back();
+
+	if (i->second.empty())
 	{
-		if (t)
-			pool += t->GetMemUsage();
+		m_pool.erase(i);
 	}
-	GL_PERF("MEM: Surface Pool %dMB", pool >> 20u);
+
+	m_pool_count--;
+	m_pool_memory -= t->GetMemUsage();
+
+	delete t;
+}
+
+void GSDevice::ClearPool()
+{
+	for (auto& i : m_pool)
+	{
+		for (GSTexture* t : i.second)
+			delete t;
+	}
+
+	m_pool.clear();
+	m_pool_count = 0;
+	m_pool_memory = 0;
+}
+
+void GSDevice::PrintMemoryUsage()
+{
+#ifdef ENABLE_OGL_DEBUG
+	GL_PERF("MEM: Surface Pool %dMB (%d surfaces, %d size classes)", (int)(m_pool_memory >> 20u), (int)m_pool_count, (int)m_pool.size());
 #endif
 }
 
@@ -156,15 +200,16 @@ void GSDevice::Recycle(GSTexture* t)
 #endif
 		t->last_frame_used = m_frame;
 
-		m_pool.push_front(t);
+		m_pool[GetPoolKey(t->GetType(), t->GetFormat(), t->GetWidth(), t->GetHeight())].push_front(t);
 
-		//printf("%d\n",m_pool.size());
+		m_pool_count++;
+		m_pool_memory += t->GetMemUsage();
 
-		while (m_pool.size() > 300)
-		{
-			delete m_pool.back();
+		//printf("%d\n",m_pool_count);
 
-			m_pool.pop_back();
+		while (m_pool_count > 300)
+		{
+			EvictPoolLRU();
 		}
 	}
 }
@@ -173,22 +218,28 @@ void GSDevice::AgePool()
 {
 	m_frame++;
 
-	while (m_pool.size() > 40 && m_frame - m_pool.back()->last_frame_used > 10)
+	while (m_pool_count > 40)
 	{
-		delete m_pool.back();
+		GSTexture* t = GetPoolLRU();
 
-		m_pool.pop_back();
+		if (m_frame - t->last_frame_used <= 10)
+			break;
+
+		EvictPoolLRU();
 	}
 }
 
 void GSDevice::PurgePool()
 {
 	// OOM emergency. Let's free this useless pool
-	while (!m_pool.empty())
-	{
-		delete m_pool.back();
+	ClearPool();
+}
 
-		m_pool.pop_back();
+void GSDevice::TrimPool(size_t max_memory)
+{
+	while (m_pool_memory > max_memory && m_pool_count > 0)
+	{
+		EvictPoolLRU();
 	}
 }
 
@@ -16,7 +16,6 @@
 #pragma once
 
 #include "common/WindowInfo.h"
-#include "GSFastList.h"
 #include "GSTexture.h"
 #include "GSVertex.h"
 #include "GS/GSAlignedClass.h"
@@ -126,9 +125,22 @@ struct HWBlend
 class GSDevice : public GSAlignedClass<32>
 {
 private:
-	FastList<GSTexture*> m_pool;
+	// Recycled surfaces, bucketed by exact size class (type, format, width, height).
+	// Each bucket is ordered from the most to the least recently recycled surface.
+	std::unordered_map<uint64, std::deque<GSTexture*>> m_pool;
+	size_t m_pool_count;
+	size_t m_pool_memory;
 	static std::array<HWBlend, 3*3*3*3 + 1> m_blendMap;
 
+	static __forceinline uint64 GetPoolKey(int type, int format, int w, int h)
+	{
+		return ((uint64)(type & 0xff) << 56) | ((uint64)(format & 0xffffff) << 32) | ((uint64)(w & 0xffff) << 16) | (uint64)(h & 0xffff);
+	}
+
+	GSTexture* GetPoolLRU();
+	void EvictPoolLRU();
+	void ClearPool();
+
 protected:
 	enum : uint16
 	{
@@ -251,6 +263,8 @@ public:
 
 	void AgePool();
 	void PurgePool();
+	void TrimPool(size_t max_memory);
+	size_t GetPoolMemoryUsage() const { return m_pool_memory; }
 
 	virtual void PrintMemoryUsage();
 
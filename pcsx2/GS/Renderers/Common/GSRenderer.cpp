@@ -431,6 +431,28 @@ void GSRenderer::VSync(int field)
 
 				s += format(" | %d%% CPU", sum);
 			}
+
+			double lookups = m_perfmon.Get(GSPerfMon::TextureHit) + m_perfmon.Get(GSPerfMon::TextureMiss);
+
+			if (lookups > 0)
+			{
+				s += format(" | TC %d%% hit %d miss %d inv",
+					(int)(100 * m_perfmon.Get(GSPerfMon::TextureHit) / lookups),
+					(int)m_perfmon.Get(GSPerfMon::TextureMiss),
+					(int)m_perfmon.Get(GSPerfMon::TextureInvalidation));
+			}
+
+			// Bytes per frame
+			double skipped = m_perfmon.Get(GSPerfMon::UploadSkipped);
+
+			if (skipped >= 1024 * 1024)
+			{
+				s += format(" | %.2f MB unchanged", skipped / (1024 * 1024));
+			}
+			else if (skipped > 0)
+			{
+				s += format(" | %.2f KB unchanged", skipped / 1024);
+			}
 		}
 #else
 		{
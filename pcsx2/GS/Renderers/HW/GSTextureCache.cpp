@@ -20,6 +20,7 @@
 
 bool GSTextureCache::m_disable_partial_invalidation = false;
 bool GSTextureCache::m_wrap_gs_mem = false;
+bool GSTextureCache::m_upload_dedup = false;
 
 GSTextureCache::GSTextureCache(GSRenderer* r)
 	: m_renderer(r)
@@ -47,6 +48,7 @@ GSTextureCache::GSTextureCache(GSRenderer* r)
 	}
 
 	m_paltex = theApp.GetConfigB("paltex");
+	m_upload_dedup = theApp.GetConfigB("texture_upload_dedup");
 	m_crc_hack_level = theApp.GetConfigT<CRCHackLevel>("crc_hack_level");
 	if (m_crc_hack_level == CRCHackLevel::Automatic)
 		m_crc_hack_level = GSUtil::GetRecommendedCRCHackLevel(theApp.GetCurrentRendererType());
@@ -57,6 +59,12 @@ GSTextureCache::GSTextureCache(GSRenderer* r)
 	m_temp = (uint8*)_aligned_malloc(9 * 1024 * 1024, 32);
 
 	m_texture_inside_rt_cache.reserve(m_texture_inside_rt_cache_size);
+
+	// 0 means no limit other than the ages
+	m_budget = (size_t)std::max<int>(theApp.GetConfigI("texture_budget_hw"), 0) << 20;
+	m_over_budget = false;
+
+	memset(&m_memory_usage, 0, sizeof(m_memory_usage));
 }
 
 GSTextureCache::~GSTextureCache()
@@ -874,6 +882,9 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 
 	off.loopPages(rect, [&](uint32 page)
 	{
+		if ((m_src.m_pages[page >> 5] & (1 << (page & 31))) == 0)
+			return;
+
 		auto& list = m_src.m_map[page];
 		for (auto i = list.begin(); i != list.end();)
 		{
@@ -933,6 +944,12 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 	if (!target)
 		return;
 
+	// Blocks written are within [bp, bp_end[ (whole page rows, so it is an upper bound).
+	// A target can only be affected below when it starts at bp, when it starts inside the written
+	// range (write before the target), or when bp falls inside the target (write in the middle).
+	// Checking this first skips all the format tables for the unrelated targets.
+	const uint32 bp_end = bp + ((r.w + GSLocalMemory::m_psm[psm].pgs.y - 1) / GSLocalMemory::m_psm[psm].pgs.y) * bw * 32;
+
 	for (int type = 0; type < 2; type++)
 	{
 		auto& list = m_dst[type];
@@ -941,6 +958,9 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 			auto j = i++;
 			Target* t = *j;
 
+			if (bp < t->m_TEX0.TBP0 ? bp_end <= t->m_TEX0.TBP0 : (bp > t->m_TEX0.TBP0 && bp > t->m_end_block))
+				continue;
+
 			// GH: (I think) this code is completely broken. Typical issue:
 			// EE write an alpha channel into 32 bits texture
 			// Results: the target is deleted (because HasCompatibleBits is false)
@@ -1276,6 +1296,94 @@ void GSTextureCache::IncAge()
 			}
 		}
 	}
+
+	UpdateMemoryUsage();
+
+	if (m_budget > 0 && m_memory_usage.Total() > m_budget)
+	{
+		EnforceBudget();
+	}
+	else if (m_over_budget)
+	{
+		m_over_budget = false;
+
+		GL_CACHE("TC: Back under budget, %dMB in use", (int)(m_memory_usage.Total() >> 20u));
+	}
+}
+
+void GSTextureCache::UpdateMemoryUsage()
+{
+	MemoryUsage& mu = m_memory_usage;
+
+	memset(&mu, 0, sizeof(mu));
+
+	for (auto s : m_src.m_surfaces)
+	{
+		if (s && !s->m_shared_texture && s->m_texture)
+		{
+			if (s->m_target)
+				mu.source_rt += s->m_texture->GetMemUsage();
+			else
+				mu.source += s->m_texture->GetMemUsage();
+		}
+	}
+
+	for (auto t : m_dst[RenderTarget])
+	{
+		if (t && t->m_texture)
+			mu.target += t->m_texture->GetMemUsage();
+	}
+
+	for (auto t : m_dst[DepthStencil])
+	{
+		if (t && t->m_texture)
+			mu.depth += t->m_texture->GetMemUsage();
+	}
+
+	mu.pool = m_renderer->m_dev->GetPoolMemoryUsage();
+}
+
+void GSTextureCache::EnforceBudget()
+{
+	// Targets hold data which only exists on the GPU, they are never evicted to fit the budget.
+	// Sources can always be recreated from local memory, drop the least recently used ones first.
+	// A removed source recycles its texture into the pool, so the pool is trimmed last.
+
+	std::vector<Source*> unused;
+
+	for (auto s : m_src.m_surfaces)
+	{
+		if (s && !s->m_shared_texture && s->m_age > 0)
+		{
+			unused.push_back(s);
+		}
+	}
+
+	std::sort(unused.begin(), unused.end(), [](const Source* a, const Source* b) { return a->m_age > b->m_age; });
+
+	size_t total = m_memory_usage.Total() - m_memory_usage.pool;
+
+	for (Source* s : unused)
+	{
+		if (total <= m_budget)
+			break;
+
+		total -= s->m_texture ? s->m_texture->GetMemUsage() : 0;
+
+		m_src.RemoveAt(s);
+	}
+
+	m_renderer->m_dev->TrimPool(total < m_budget ? m_budget - total : 0);
+
+	UpdateMemoryUsage();
+
+	// Only report the transitions, the budget is enforced every frame while over it
+	if (!m_over_budget)
+	{
+		m_over_budget = true;
+
+		GL_CACHE("TC: Over budget, %dMB left in use after eviction", (int)(m_memory_usage.Total() >> 20u));
+	}
 }
 
 //Fixme: Several issues in here. Not handling depth stencil, pitch conversion doesnt work.
@@ -1656,32 +1764,9 @@ GSTextureCache::Target* GSTextureCache::CreateTarget(const GIFRegTEX0& TEX0, int
 void GSTextureCache::PrintMemoryUsage()
 {
 #ifdef ENABLE_OGL_DEBUG
-	uint32 tex = 0;
-	uint32 tex_rt = 0;
-	uint32 rt = 0;
-	uint32 dss = 0;
-	for (auto s : m_src.m_surfaces)
-	{
-		if (s && !s->m_shared_texture)
-		{
-			if (s->m_target)
-				tex_rt += s->m_texture->GetMemUsage();
-			else
-				tex += s->m_texture->GetMemUsage();
-		}
-	}
-	for (auto t : m_dst[RenderTarget])
-	{
-		if (t)
-			rt += t->m_texture->GetMemUsage();
-	}
-	for (auto t : m_dst[DepthStencil])
-	{
-		if (t)
-			dss += t->m_texture->GetMemUsage();
-	}
+	const MemoryUsage& mu = m_memory_usage;
 
-	GL_PERF("MEM: RO Tex %dMB. RW Tex %dMB. Target %dMB. Depth %dMB", tex >> 20u, tex_rt >> 20u, rt >> 20u, dss >> 20u);
+	GL_PERF("MEM: RO Tex %dMB. RW Tex %dMB. Target %dMB. Depth %dMB", (int)(mu.source >> 20u), (int)(mu.source_rt >> 20u), (int)(mu.target >> 20u), (int)(mu.depth >> 20u));
 #endif
 }
 
@@ -1739,6 +1824,9 @@ GSTextureCache::Source::Source(GSRenderer* r, const GIFRegTEX0& TEX0, const GIFR
 	, m_p2t(NULL)
 	, m_from_target(NULL)
 	, m_from_target_TEX0(TEX0)
+	, m_hash(NULL)
+	, m_hash_pitch(0)
+	, m_hash_count(0)
 {
 	m_TEX0 = TEX0;
 	m_TEXA = TEXA;
@@ -1775,6 +1863,9 @@ GSTextureCache::Source::Source(GSRenderer* r, const GIFRegTEX0& TEX0, const GIFR
 GSTextureCache::Source::~Source()
 {
 	_aligned_free(m_write.rect);
+
+	if (m_hash)
+		_aligned_free(m_hash);
 }
 
 void GSTextureCache::Source::Update(const GSVector4i& rect, int layer)
@@ -1802,6 +1893,20 @@ void GSTextureCache::Source::Update(const GSVector4i& rect, int layer)
 	GSOffset::BNHelper bn = off.bnMulti(r.left, r.top);
 
 	uint32 blocks = 0;
+	uint32 unchanged = 0;
+
+	// Only the base layer is hashed, a source is never updated from anything but local memory
+	// so a block with the same content as its last upload is already right on the GPU.
+	bool dedup = m_upload_dedup && layer == 0;
+
+	if (dedup && m_hash == NULL)
+	{
+		m_hash_pitch = tw / bs.x;
+		m_hash_count = m_hash_pitch * (th / bs.y);
+		m_hash = (uint64*)_aligned_malloc(m_hash_count * sizeof(uint64), 32);
+
+		memset(m_hash, 0, m_hash_count * sizeof(uint64));
+	}
 
 	if (m_repeating)
 	{
@@ -1823,6 +1928,12 @@ void GSTextureCache::Source::Update(const GSVector4i& rect, int layer)
 					{
 						m_valid[row] |= col;
 
+						if (dedup && IsBlockUnchanged(x, y, block))
+						{
+							unchanged++;
+							continue;
+						}
+
 						Write(GSVector4i(x, y, x + bs.x, y + bs.y), layer);
 
 						blocks++;
@@ -1850,6 +1961,12 @@ void GSTextureCache::Source::Update(const GSVector4i& rect, int layer)
 					{
 						m_valid[row] |= col;
 
+						if (dedup && IsBlockUnchanged(x, y, block))
+						{
+							unchanged++;
+							continue;
+						}
+
 						Write(GSVector4i(x, y, x + bs.x, y + bs.y), layer);
 
 						blocks++;
@@ -1865,6 +1982,46 @@ void GSTextureCache::Source::Update(const GSVector4i& rect, int layer)
 
 		Flush(m_write.count, layer);
 	}
+
+	if (unchanged > 0)
+	{
+		m_renderer->m_perfmon.Put(GSPerfMon::UploadSkipped, bs.x * bs.y * unchanged << (m_palette ? 0 : 2));
+	}
+}
+
+bool GSTextureCache::Source::IsBlockUnchanged(int x, int y, uint32 block)
+{
+	const GSVector2i& bs = GSLocalMemory::m_psm[m_TEX0.PSM].bs;
+
+	uint32 i = (y / bs.y) * m_hash_pitch + (x / bs.x);
+
+	if (x >= (int)m_hash_pitch * bs.x || i >= m_hash_count)
+	{
+		return false;
+	}
+
+	// 4 independent multiply/xorshift lanes over the 256 bytes of the block
+
+	const uint64* RESTRICT p = (const uint64*)m_renderer->m_mem.BlockPtr(block);
+
+	uint64 h[4] = {0x9e3779b97f4a7c15ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull, 0x85ebca77c2b2ae63ull};
+
+	for (int j = 0; j < 32; j += 4)
+	{
+		for (int k = 0; k < 4; k++)
+		{
+			h[k] = (h[k] ^ p[j + k]) * 0xff51afd7ed558ccdull;
+			h[k] ^= h[k] >> 29;
+		}
+	}
+
+	uint64 hash = ((h[0] ^ (h[1] * 31)) ^ ((h[2] * 127) ^ (h[3] * 8191))) | 1; // never 0
+
+	bool unchanged = m_hash[i] == hash;
+
+	m_hash[i] = hash;
+
+	return unchanged;
 }
 
 void GSTextureCache::Source::UpdateLayer(const GIFRegTEX0& TEX0, const GSVector4i& rect, int layer)
@@ -2130,6 +2287,7 @@ void GSTextureCache::SourceMap::Add(Source* s, const GIFRegTEX0& TEX0, const GSO
 		size_t page = TEX0.TBP0 >> 5;
 
 		s->m_erase_it[page] = m_map[page].InsertFront(s);
+		m_pages[page >> 5] |= 1 << (page & 31);
 
 		return;
 	}
@@ -2138,6 +2296,7 @@ void GSTextureCache::SourceMap::Add(Source* s, const GIFRegTEX0& TEX0, const GSO
 	s->m_pages.loopPages([this, s](uint32 page)
 	{
 		s->m_erase_it[page] = m_map[page].InsertFront(s);
+		m_pages[page >> 5] |= 1 << (page & 31);
 	});
 }
 
@@ -2152,6 +2311,8 @@ void GSTextureCache::SourceMap::RemoveAll()
 	{
 		m_map[i].clear();
 	}
+
+	memset(m_pages, 0, sizeof(m_pages));
 }
 
 void GSTextureCache::SourceMap::RemoveAt(Source* s)
@@ -2166,12 +2327,18 @@ void GSTextureCache::SourceMap::RemoveAt(Source* s)
 	{
 		const size_t page = s->m_TEX0.TBP0 >> 5;
 		m_map[page].EraseIndex(s->m_erase_it[page]);
+
+		if (m_map[page].empty())
+			m_pages[page >> 5] &= ~(1 << (page & 31));
 	}
 	else
 	{
 		s->m_pages.loopPages([this, s](uint32 page)
 		{
 			m_map[page].EraseIndex(s->m_erase_it[page]);
+
+			if (m_map[page].empty())
+				m_pages[page >> 5] &= ~(1 << (page & 31));
 		});
 	}
 
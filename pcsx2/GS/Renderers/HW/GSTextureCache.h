@@ -105,8 +105,14 @@ public:
 			uint32 count;
 		} m_write;
 
+		// Hash of the local memory block last uploaded for each tile of layer 0, 0 when unknown
+		uint64* m_hash;
+		uint32 m_hash_pitch;
+		uint32 m_hash_count;
+
 		void Write(const GSVector4i& r, int layer);
 		void Flush(uint32 count, int layer);
+		bool IsBlockUnchanged(int x, int y, uint32 block);
 
 	public:
 		std::shared_ptr<Palette> m_palette_obj;
@@ -180,7 +186,7 @@ public:
 	public:
 		std::unordered_set<Source*> m_surfaces;
 		std::array<FastList<Source*>, MAX_PAGES> m_map;
-		uint32 m_pages[16]; // bitmap of all pages
+		uint32 m_pages[16]; // bitmap of the pages which have at least one source in m_map
 		bool m_used;
 
 		SourceMap()
@@ -195,6 +201,17 @@ public:
 		void RemoveAt(Source* s);
 	};
 
+	struct MemoryUsage
+	{
+		size_t source;    // textures uploaded from local memory
+		size_t source_rt; // textures converted from a target
+		size_t target;
+		size_t depth;
+		size_t pool;      // surfaces waiting in the device pool
+
+		size_t Total() const { return source + source_rt + target + depth + pool; }
+	};
+
 	struct TexInsideRtCacheEntry
 	{
 		uint32 psm;
@@ -222,8 +239,15 @@ protected:
 	static bool m_disable_partial_invalidation;
 	bool m_texture_inside_rt;
 	static bool m_wrap_gs_mem;
+	static bool m_upload_dedup;
 	uint8 m_texture_inside_rt_cache_size = 255;
 	std::vector<TexInsideRtCacheEntry> m_texture_inside_rt_cache;
+	size_t m_budget;
+	bool m_over_budget;
+	MemoryUsage m_memory_usage;
+
+	void UpdateMemoryUsage();
+	void EnforceBudget();
 
 	virtual Source* CreateSource(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, Target* t = NULL, bool half_right = false, int x_offset = 0, int y_offset = 0);
 	virtual Target* CreateTarget(const GIFRegTEX0& TEX0, int w, int h, int type);
@@ -265,5 +289,8 @@ public:
 
 	void PrintMemoryUsage();
 
+	// Memory used at the end of the last frame, refreshed by IncAge()
+	const MemoryUsage& GetMemoryUsage() const { return m_memory_usage; }
+
 	void AttachPaletteToSource(Source* s, uint16 pal, bool need_gs_texture);
 };
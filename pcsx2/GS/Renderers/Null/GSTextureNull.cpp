@@ -18,13 +18,11 @@
 
 GSTextureNull::GSTextureNull()
 {
-	memset(&m_desc, 0, sizeof(m_desc));
 }
 
 GSTextureNull::GSTextureNull(int type, int w, int h, int format)
 {
-	m_desc.type = type;
-	m_desc.w = w;
-	m_desc.h = h;
-	m_desc.format = format;
+	m_type = type;
+	m_format = format;
+	m_size = GSVector2i(w, h);
 }
@@ -19,18 +19,10 @@
 
 class GSTextureNull : public GSTexture
 {
-	struct
-	{
-		int type, w, h, format;
-	} m_desc;
-
 public:
 	GSTextureNull();
 	GSTextureNull(int type, int w, int h, int format);
 
-	int GetType() const { return m_desc.type; }
-	int GetFormat() const { return m_desc.format; }
-
 	bool Update(const GSVector4i& r, const void* data, int pitch, int layer = 0) { return true; }
 	bool Map(GSMap& m, const GSVector4i* r = NULL, int layer = 0) { return false; }
 	void Unmap() {}
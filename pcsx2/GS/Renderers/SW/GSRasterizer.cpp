@@ -143,6 +143,8 @@ void GSRasterizer::Draw(GSRasterizerData* data)
 
 	data->start = __rdtsc();
 
+	data->Prepare();
+
 	m_ds->BeginDraw(data);
 
 	const GSVertexSW* vertex = data->vertex;
@@ -61,6 +61,10 @@ public:
 		if (buff != NULL)
 			_aligned_free(buff);
 	}
+
+	// Called by every rasterizer receiving the data, before drawing. Work which was
+	// deferred from the GS thread must be completed before any caller returns.
+	virtual void Prepare() {}
 };
 
 class IDrawScanline : public GSAlignedClass<32>
@@ -214,7 +218,8 @@ public:
 			rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(new DS(), i, threads, perfmon)));
 			auto& r = *rl->m_r[i];
 			rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker(
-				[&r](std::shared_ptr<GSRasterizerData>& item) { r.Draw(item.get()); })));
+				[&r](std::shared_ptr<GSRasterizerData>& item) { r.Draw(item.get()); },
+				[]() { Threading::PlaceCurrentThread(Threading::ThreadRole::GSWorker); })));
 		}
 
 		return rl;
@@ -62,6 +62,9 @@ GSRendererSW::GSRendererSW(int threads)
 	InitCVB(GS_TRIANGLE_CLASS);
 	InitCVB(GS_SPRITE_CLASS);
 
+	// Only worth it when there are rasterizer threads to spread the conversion over
+	m_threaded_cvb = threads > 0 && theApp.GetConfigB("threaded_cvb_sw");
+
 	m_dump_root = root_sw;
 
 	// Reset handler with the auto flush hack enabled on the SW renderer.
@@ -201,139 +204,96 @@ GSTexture* GSRendererSW::GetFeedbackOutput()
 
 
 template <uint32 primclass, uint32 tme, uint32 fst, uint32 q_div>
-void GSRendererSW::ConvertVertexBuffer(GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, size_t count)
+void GSRendererSW::ConvertVertex(const ConvertVertexBufferConstants& k, GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, const GSVector4& q)
 {
-	// FIXME q_div wasn't added to AVX2 code path.
-
-#if 0 //_M_SSE >= 0x501
-
-	// TODO: something isn't right here, this makes other functions slower (split load/store? old sse code in 3rd party lib?)
-
-	GSVector8i o2((GSVector4i)m_context->XYOFFSET);
-	GSVector8 tsize2(GSVector4(0x10000 << m_context->TEX0.TW, 0x10000 << m_context->TEX0.TH, 1, 0));
-
-	for(int i = (int)m_vertex.next; i > 0; i -= 2, src += 2, dst += 2) // ok to overflow, allocator makes sure there is one more dummy vertex
-	{
-		GSVector8i v0 = GSVector8i::load<true>(src[0].m);
-		GSVector8i v1 = GSVector8i::load<true>(src[1].m);
+	GSVector4 stcq = GSVector4::load<true>(&src->m[0]); // s t rgba q
 
-		GSVector8 stcq = GSVector8::cast(v0.ac(v1));
-		GSVector8i xyzuvf = v0.bd(v1);
+	GSVector4i xyzuvf(src->m[1]);
 
-		//GSVector8 stcq = GSVector8::load(&src[0].m[0], &src[1].m[0]);
-		//GSVector8i xyzuvf = GSVector8i::load(&src[0].m[1], &src[1].m[1]);
+	GSVector4i xy = xyzuvf.upl16() - k.off;
+	GSVector4i zf = xyzuvf.ywww().min_u32(GSVector4i::xffffff00());
 
-		GSVector8i xy = xyzuvf.upl16() - o2;
-		GSVector8i zf = xyzuvf.ywww().min_u32(GSVector8i::xffffff00());
+	dst->p = GSVector4(xy).xyxy(GSVector4(zf) + (GSVector4::m_x4f800000 & GSVector4::cast(zf.sra32(31)))) * m_pos_scale;
+	dst->c = GSVector4(GSVector4i::cast(stcq).zzzz().u8to32() << 7);
 
-		GSVector8 p = GSVector8(xy).xyxy(GSVector8(zf) + (GSVector8::m_x4f800000 & GSVector8::cast(zf.sra32(31)))) * m_pos_scale2;
-		GSVector8 c = GSVector8(GSVector8i::cast(stcq).uph8().upl16() << 7);
-
-		GSVector8 t = GSVector8::zero();
-
-		if(tme)
-		{
-			if(fst)
-			{
-				t = GSVector8(xyzuvf.uph16() << (16 - 4));
-			}
-			else
-			{
-				t = stcq.xyww() * tsize2;
-			}
-		}
+	GSVector4 t = GSVector4::zero();
 
-		if(primclass == GS_SPRITE_CLASS)
+	if (tme)
+	{
+		if (fst)
 		{
-			t = t.insert32<1, 3>(GSVector8::cast(xyzuvf));
+			t = GSVector4(xyzuvf.uph16() << (16 - 4));
 		}
-
-		GSVector8::storel(&dst[0].p, p);
-
-		if(tme || primclass == GS_SPRITE_CLASS)
+		else if (q_div)
 		{
-			GSVector8::store<true>(&dst[0].t, t.ac(c));
+			// Division is required if number are huge (Pro Soccer Club)
+			t = (stcq / q) * k.tsize;
 		}
 		else
 		{
-			GSVector8::storel(&dst[0].c, c);
+			t = stcq.xyww() * k.tsize;
 		}
+	}
 
-		GSVector8::storeh(&dst[1].p, p);
-
-		if(tme || primclass == GS_SPRITE_CLASS)
-		{
-			GSVector8::store<true>(&dst[1].t, t.bd(c));
-		}
-		else
-		{
-			GSVector8::storeh(&dst[1].c, c);
-		}
+	if (primclass == GS_SPRITE_CLASS)
+	{
+		xyzuvf = xyzuvf.min_u32(k.z_max);
+		t = t.insert32<1, 3>(GSVector4::cast(xyzuvf));
 	}
 
-#else
+	if (k.half_pel)
+	{
+		// if q is constant we can do the half pel shift for bilinear sampling on the vertices
 
-	GSVector4i off = (GSVector4i)m_context->XYOFFSET;
-	GSVector4 tsize = GSVector4(0x10000 << m_context->TEX0.TW, 0x10000 << m_context->TEX0.TH, 1, 0);
-	GSVector4i z_max = GSVector4i::xffffffff().srl32(GSLocalMemory::m_psm[m_context->ZBUF.PSM].fmt * 8);
+		GSVector4 half(0x8000, 0x8000);
 
-	for (int i = (int)m_vertex.next; i > 0; i--, src++, dst++)
-	{
-		GSVector4 stcq = GSVector4::load<true>(&src->m[0]); // s t rgba q
+		t = (t - half).xyzw(t);
+	}
 
-		GSVector4i xyzuvf(src->m[1]);
+	dst->t = t;
+}
 
-		GSVector4i xy = xyzuvf.upl16() - off;
-		GSVector4i zf = xyzuvf.ywww().min_u32(GSVector4i::xffffff00());
+template <uint32 primclass, uint32 tme, uint32 fst, uint32 q_div>
+void GSRendererSW::ConvertVertexBuffer(const ConvertVertexBufferConstants& k, GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, int begin, int end)
+{
+	// The vertices are converted two at a time, the loads of both are independent and
+	// sprites need the q of their second vertex anyway. begin is always even.
 
-		dst->p = GSVector4(xy).xyxy(GSVector4(zf) + (GSVector4::m_x4f800000 & GSVector4::cast(zf.sra32(31)))) * m_pos_scale;
-		dst->c = GSVector4(GSVector4i::cast(stcq).zzzz().u8to32() << 7);
+	ASSERT((begin & 1) == 0);
 
-		GSVector4 t = GSVector4::zero();
+	dst += begin;
+	src += begin;
 
-		if (tme)
-		{
-			if (fst)
-			{
-				t = GSVector4(xyzuvf.uph16() << (16 - 4));
-			}
-			else if (q_div)
-			{
-				// Division is required if number are huge (Pro Soccer Club)
-				if (primclass == GS_SPRITE_CLASS && (i & 1) == 0)
-				{
-					// q(n) isn't valid, you need to take q(n+1)
-					const GSVertex* next = src + 1;
-					GSVector4 stcq1 = GSVector4::load<true>(&next->m[0]); // s t rgba q
-					t = (stcq / stcq1.wwww()) * tsize;
-				}
-				else
-				{
-					t = (stcq / stcq.wwww()) * tsize;
-				}
-			}
-			else
-			{
-				t = stcq.xyww() * tsize;
-			}
-		}
+	int i = begin;
 
-		if (primclass == GS_SPRITE_CLASS)
+	for (; i + 1 < end; i += 2, src += 2, dst += 2)
+	{
+		GSVector4 q0 = GSVector4::zero();
+		GSVector4 q1 = GSVector4::zero();
+
+		if (tme && !fst && q_div)
 		{
-			xyzuvf = xyzuvf.min_u32(z_max);
-			t = t.insert32<1, 3>(GSVector4::cast(xyzuvf));
+			q1 = GSVector4::load<true>(&src[1].m[0]).wwww();
+
+			// q(n) of a sprite isn't valid, you need to take q(n+1)
+			q0 = primclass == GS_SPRITE_CLASS ? q1 : GSVector4::load<true>(&src[0].m[0]).wwww();
 		}
 
-		dst->t = t;
+		ConvertVertex<primclass, tme, fst, q_div>(k, &dst[0], &src[0], q0);
+		ConvertVertex<primclass, tme, fst, q_div>(k, &dst[1], &src[1], q1);
+	}
 
-#if 0 //_M_SSE >= 0x501
+	if (i < end)
+	{
+		GSVector4 q0 = GSVector4::zero();
 
-		dst->_pad = GSVector4::zero();
+		if (tme && !fst && q_div)
+		{
+			q0 = GSVector4::load<true>(&src[0].m[0]).wwww();
+		}
 
-#endif
+		ConvertVertex<primclass, tme, fst, q_div>(k, &dst[0], &src[0], q0);
 	}
-
-#endif
 }
 
 void GSRendererSW::Draw()
@@ -344,11 +304,15 @@ void GSRendererSW::Draw()
 
 	std::shared_ptr<GSRasterizerData> data(sd);
 
+	size_t vertex_size = sizeof(GSVertexSW) * ((m_vertex.next + 1) & ~1);
+	size_t index_size = sizeof(uint32) * ((m_index.tail + 7) & ~7);
+	size_t src_size = m_threaded_cvb ? sizeof(GSVertex) * m_vertex.next : 0;
+
 	sd->primclass = m_vt.m_primclass;
-	sd->buff = (uint8*)_aligned_malloc(sizeof(GSVertexSW) * ((m_vertex.next + 1) & ~1) + sizeof(uint32) * m_index.tail, 64);
+	sd->buff = (uint8*)_aligned_malloc(vertex_size + index_size + src_size, 64);
 	sd->vertex = (GSVertexSW*)sd->buff;
 	sd->vertex_count = m_vertex.next;
-	sd->index = (uint32*)(sd->buff + sizeof(GSVertexSW) * ((m_vertex.next + 1) & ~1));
+	sd->index = (uint32*)(sd->buff + vertex_size);
 	sd->index_count = m_index.tail;
 
 	// skip per pixel division if q is constant.
@@ -356,7 +320,11 @@ void GSRendererSW::Draw()
 	// If you have both GS_SPRITE_CLASS && m_vt.m_eq.q, it will depends on the first part of the 'OR'
 	uint32 q_div = !IsMipMapActive() && ((m_vt.m_eq.q && m_vt.m_min.t.z != 1.0f) || (!m_vt.m_eq.q && m_vt.m_primclass == GS_SPRITE_CLASS));
 
-	(this->*m_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div])(sd->vertex, m_vertex.buff, m_vertex.next);
+	sd->m_cvb = m_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div];
+	sd->m_cvb_k.off = (GSVector4i)m_context->XYOFFSET;
+	sd->m_cvb_k.tsize = GSVector4(0x10000 << m_context->TEX0.TW, 0x10000 << m_context->TEX0.TH, 1, 0);
+	sd->m_cvb_k.z_max = GSVector4i::xffffffff().srl32(GSLocalMemory::m_psm[m_context->ZBUF.PSM].fmt * 8);
+	sd->m_cvb_k.half_pel = false;
 
 	memcpy(sd->index, m_index.buff, sizeof(uint32) * m_index.tail);
 
@@ -384,6 +352,22 @@ void GSRendererSW::Draw()
 		return;
 	}
 
+	// GetScanlineGlobalData may have asked for the half pel shift, convert the vertices only now
+
+	if (m_threaded_cvb && m_vertex.next > SharedData::CVB_CHUNK_SIZE)
+	{
+		GSVertex* RESTRICT src = (GSVertex*)(sd->buff + vertex_size + index_size);
+
+		memcpy(src, m_vertex.buff, sizeof(GSVertex) * m_vertex.next);
+
+		sd->m_cvb_src = src;
+		sd->m_cvb_chunks = (m_vertex.next + SharedData::CVB_CHUNK_SIZE - 1) / SharedData::CVB_CHUNK_SIZE;
+	}
+	else
+	{
+		sd->m_cvb(sd->m_cvb_k, sd->vertex, m_vertex.buff, 0, m_vertex.next);
+	}
+
 	if (0) if (LOG)
 	{
 		int n = GSUtil::GetVertexCount(PRIM->PRIM);
@@ -1209,16 +1193,7 @@ bool GSRendererSW::GetScanlineGlobalData(SharedData* data)
 
 					// TODO: but not when mipmapping is used!!!
 
-					GSVector4 half(0x8000, 0x8000);
-
-					GSVertexSW* RESTRICT v = data->vertex;
-
-					for (int i = 0, j = data->vertex_count; i < j; i++)
-					{
-						GSVector4 t = v[i].t;
-
-						v[i].t = (t - half).xyzw(t);
-					}
+					data->m_cvb_k.half_pel = true;
 				}
 			}
 
@@ -1435,6 +1410,11 @@ GSRendererSW::SharedData::SharedData(GSRendererSW* parent)
 	, m_zpsm(0)
 	, m_using_pages(false)
 	, m_syncpoint(SyncNone)
+	, m_cvb(NULL)
+	, m_cvb_src(NULL)
+	, m_cvb_chunks(0)
+	, m_cvb_next(0)
+	, m_cvb_done(0)
 {
 	m_tex[0].t = NULL;
 
@@ -1466,6 +1446,35 @@ GSRendererSW::SharedData::~SharedData()
 
 //static TransactionScope::Lock s_lock;
 
+void GSRendererSW::SharedData::ConvertVertices(int chunk)
+{
+	int begin = chunk * CVB_CHUNK_SIZE;
+	int end = std::min<int>(begin + CVB_CHUNK_SIZE, vertex_count);
+
+	m_cvb(m_cvb_k, vertex, m_cvb_src, begin, end);
+}
+
+void GSRendererSW::SharedData::Prepare()
+{
+	if (m_cvb_chunks == 0)
+		return;
+
+	// every thread holding this draw helps until there is nothing left to grab,
+	// so the wait below only covers chunks which are being converted right now
+
+	for (int chunk = m_cvb_next++; chunk < m_cvb_chunks; chunk = m_cvb_next++)
+	{
+		ConvertVertices(chunk);
+
+		m_cvb_done.fetch_add(1, std::memory_order_release);
+	}
+
+	while (m_cvb_done.load(std::memory_order_acquire) < m_cvb_chunks)
+	{
+		_mm_pause();
+	}
+}
+
 void GSRendererSW::SharedData::UsePages(const GSOffset::PageLooper* fb_pages, int fpsm, const GSOffset::PageLooper* zb_pages, int zpsm)
 {
 	if (m_using_pages)
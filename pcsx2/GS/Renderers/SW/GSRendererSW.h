@@ -25,6 +25,26 @@ class GSRendererSW : public GSRenderer
 	static const GSVector8 m_pos_scale2;
 #endif
 
+	// Everything the vertex conversion needs from the drawing context, captured at Draw()
+	// time so the conversion can also run later on the rasterizer threads.
+	struct alignas(16) ConvertVertexBufferConstants
+	{
+		GSVector4i off;
+		GSVector4 tsize;
+		GSVector4i z_max;
+		bool half_pel; // bilinear half pel shift when q is constant, see GetScanlineGlobalData
+	};
+
+	typedef void (*ConvertVertexBufferPtr)(const ConvertVertexBufferConstants& k, GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, int begin, int end);
+
+	ConvertVertexBufferPtr m_cvb[4][2][2][2];
+
+	template <uint32 primclass, uint32 tme, uint32 fst, uint32 q_div>
+	static void ConvertVertexBuffer(const ConvertVertexBufferConstants& k, GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, int begin, int end);
+
+	template <uint32 primclass, uint32 tme, uint32 fst, uint32 q_div>
+	static __forceinline void ConvertVertex(const ConvertVertexBufferConstants& k, GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, const GSVector4& q);
+
 	class SharedData : public GSDrawScanline::SharedData
 	{
 		struct alignas(16) TextureLevel
@@ -57,14 +77,23 @@ class GSRendererSW : public GSRenderer
 
 		void SetSource(GSTextureCacheSW::Texture* t, const GSVector4i& r, int level);
 		void UpdateSource();
-	};
 
-	typedef void (GSRendererSW::*ConvertVertexBufferPtr)(GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, size_t count);
+		// Deferred vertex conversion. The GS thread only copies the raw GSVertex buffer,
+		// the rasterizer threads which receive the draw split the conversion in chunks
+		// between themselves and wait until all chunks are done before rasterizing.
 
-	ConvertVertexBufferPtr m_cvb[4][2][2][2];
+		enum { CVB_CHUNK_SIZE = 256 }; // must be even, sprites convert vertices in pairs
 
-	template <uint32 primclass, uint32 tme, uint32 fst, uint32 q_div>
-	void ConvertVertexBuffer(GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, size_t count);
+		ConvertVertexBufferConstants m_cvb_k;
+		ConvertVertexBufferPtr m_cvb;
+		const GSVertex* m_cvb_src;
+		int m_cvb_chunks;
+		std::atomic<int> m_cvb_next;
+		std::atomic<int> m_cvb_done;
+
+		void ConvertVertices(int chunk);
+		void Prepare() final;
+	};
 
 protected:
 	IRasterizer* m_rl;
@@ -97,6 +126,8 @@ protected:
 
 	bool GetScanlineGlobalData(SharedData* data);
 
+	bool m_threaded_cvb;
+
 public:
 	GSRendererSW(int threads);
 	virtual ~GSRendererSW();
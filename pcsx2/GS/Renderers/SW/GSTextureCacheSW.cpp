@@ -18,7 +18,9 @@
 
 GSTextureCacheSW::GSTextureCacheSW(GSState* state)
 	: m_state(state)
+	, m_size(0)
 {
+	m_budget = (size_t)std::max<int>(theApp.GetConfigI("texture_budget_sw"), 16) << 20;
 }
 
 GSTextureCacheSW::~GSTextureCacheSW()
@@ -30,17 +32,10 @@ GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, cons
 {
 	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
 
-	auto& m = m_map[TEX0.TBP0 >> 5];
+	std::vector<Texture*>& m = m_map[GetKey(TEX0)];
 
-	for (auto i = m.begin(); i != m.end(); ++i)
+	for (Texture* t : m)
 	{
-		Texture* t = *i;
-
-		if (((TEX0.u32[0] ^ t->m_TEX0.u32[0]) | ((TEX0.u32[1] ^ t->m_TEX0.u32[1]) & 3)) != 0) // TBP0 TBW PSM TW TH
-		{
-			continue;
-		}
-
 		if ((psm.trbpp == 16 || psm.trbpp == 24) && TEX0.TCC && TEXA != t->m_TEXA)
 		{
 			continue;
@@ -52,85 +47,188 @@ GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, cons
 		}
 
 		// Lookup hit
-		m.MoveFront(i.Index());
 		t->m_age = 0;
+		m_state->m_perfmon.Put(GSPerfMon::TextureHit, 1);
 		return t;
 	}
 
 	// Lookup miss
 	Texture* t = new Texture(m_state, tw0, TEX0, TEXA);
 
-	m_textures.insert(t);
+	t->m_slot = AllocSlot();
+
+	m_slots[t->m_slot] = t;
+
+	m.push_back(t);
+
+	uint32 word = t->m_slot >> 5;
+	uint32 bit = 1u << (t->m_slot & 31);
 
 	t->m_pages.loopPages([&](uint32 page)
 	{
-		t->m_erase_it[page] = m_map[page].InsertFront(t);
+		m_owners[page][word] |= bit;
 	});
 
+	m_size += t->m_size;
+
+	m_state->m_perfmon.Put(GSPerfMon::TextureMiss, 1);
+
 	return t;
 }
 
+uint32 GSTextureCacheSW::AllocSlot()
+{
+	if (m_free_slots.empty())
+	{
+		// grow by one word of 32 slots on every page
+
+		uint32 first = (uint32)m_slots.size();
+
+		m_slots.resize(first + 32, NULL);
+
+		for (auto& owners : m_owners)
+		{
+			owners.push_back(0);
+		}
+
+		for (uint32 i = first + 32; i > first; i--)
+		{
+			m_free_slots.push_back(i - 1);
+		}
+	}
+
+	uint32 slot = m_free_slots.back();
+
+	m_free_slots.pop_back();
+
+	return slot;
+}
+
+void GSTextureCacheSW::Remove(Texture* t)
+{
+	std::vector<Texture*>& m = m_map[GetKey(t->m_TEX0)];
+
+	m.erase(std::find(m.begin(), m.end(), t));
+
+	if (m.empty())
+	{
+		m_map.erase(GetKey(t->m_TEX0));
+	}
+
+	uint32 word = t->m_slot >> 5;
+	uint32 bit = 1u << (t->m_slot & 31);
+
+	t->m_pages.loopPages([&](uint32 page)
+	{
+		m_owners[page][word] &= ~bit;
+	});
+
+	m_slots[t->m_slot] = NULL;
+	m_free_slots.push_back(t->m_slot);
+
+	m_size -= t->m_size;
+
+	delete t;
+}
+
 void GSTextureCacheSW::InvalidatePages(const GSOffset::PageLooper& pages, uint32 psm)
 {
+	int invalidated = 0;
+
 	pages.loopPages([&](uint32 page)
 	{
-		for (Texture* t : m_map[page])
+		const std::vector<uint32>& owners = m_owners[page];
+
+		for (size_t i = 0; i < owners.size(); i++)
 		{
-			if (GSUtil::HasSharedBits(psm, t->m_sharedbits))
+			uint32 mask = owners[i];
+
+			unsigned long bit;
+			while (_BitScanForward(&bit, mask))
 			{
-				uint32* RESTRICT valid = t->m_valid;
+				mask &= mask - 1;
+
+				Texture* t = m_slots[(i << 5) + bit];
 
-				if (t->m_repeating)
+				if (GSUtil::HasSharedBits(psm, t->m_sharedbits))
 				{
-					for (const GSVector2i& j : t->m_p2t[page])
+					uint32* RESTRICT valid = t->m_valid;
+
+					if (t->m_repeating)
 					{
-						valid[j.x] &= j.y;
+						for (const GSVector2i& j : t->m_p2t[page])
+						{
+							valid[j.x] &= j.y;
+						}
 					}
-				}
-				else
-				{
-					valid[page] = 0;
-				}
+					else
+					{
+						valid[page] = 0;
+					}
+
+					t->m_complete = false;
 
-				t->m_complete = false;
+					invalidated++;
+				}
 			}
 		}
 	});
+
+	if (invalidated > 0)
+	{
+		m_state->m_perfmon.Put(GSPerfMon::TextureInvalidation, invalidated);
+	}
 }
 
 void GSTextureCacheSW::RemoveAll()
 {
-	for (auto i : m_textures)
-		delete i;
+	for (Texture* t : m_slots)
+		delete t;
 
-	m_textures.clear();
+	m_map.clear();
+	m_slots.clear();
+	m_free_slots.clear();
 
-	for (auto& l : m_map)
+	for (auto& owners : m_owners)
 	{
-		l.clear();
+		owners.clear();
 	}
+
+	m_size = 0;
 }
 
 void GSTextureCacheSW::IncAge()
 {
-	for (auto i = m_textures.begin(); i != m_textures.end();)
+	// Called after a full sync, no queued draw references the textures any more
+
+	std::vector<Texture*> unused;
+
+	for (Texture* t : m_slots)
 	{
-		Texture* t = *i;
+		if (t == NULL)
+		{
+			continue;
+		}
 
 		if (++t->m_age > 10)
 		{
-			i = m_textures.erase(i);
+			Remove(t);
+		}
+		else if (t->m_age > 1)
+		{
+			unused.push_back(t);
+		}
+	}
 
-			t->m_pages.loopPages([&](uint32 page)
-			{
-				m_map[page].EraseIndex(t->m_erase_it[page]);
-			});
+	if (m_size > m_budget)
+	{
+		// still over budget, drop the textures which were not used for the longest time first
 
-			delete t;
-		}
-		else
+		std::sort(unused.begin(), unused.end(), [](const Texture* a, const Texture* b) { return a->m_age > b->m_age; });
+
+		for (auto i = unused.begin(); i != unused.end() && m_size > m_budget; ++i)
 		{
-			++i;
+			Remove(*i);
 		}
 	}
 }
@@ -142,6 +240,7 @@ GSTextureCacheSW::Texture::Texture(GSState* state, uint32 tw0, const GIFRegTEX0&
 	, m_buff(NULL)
 	, m_tw(tw0)
 	, m_age(0)
+	, m_slot(0)
 	, m_complete(false)
 	, m_p2t(NULL)
 {
@@ -153,6 +252,10 @@ GSTextureCacheSW::Texture::Texture(GSState* state, uint32 tw0, const GIFRegTEX0&
 		m_tw = std::max<int>(m_TEX0.TW, GSLocalMemory::m_psm[m_TEX0.PSM].pal == 0 ? 3 : 5); // makes one row 32 bytes at least, matches the smallest block size that is allocated for m_buff
 	}
 
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[m_TEX0.PSM];
+
+	m_size = ((1 << m_tw) << (psm.pal == 0 ? 2 : 0)) * std::max<int>(1 << m_TEX0.TH, psm.bs.y) * 4;
+
 	memset(m_valid, 0, sizeof(m_valid));
 
 	m_sharedbits = GSUtil::HasSharedBitsPtr(m_TEX0.PSM);
@@ -203,9 +306,7 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 
 	if (m_buff == NULL)
 	{
-		uint32 pitch = (1 << m_tw) << shift;
-
-		m_buff = _aligned_malloc(pitch * th * 4, 32);
+		m_buff = _aligned_malloc(m_size, 32);
 
 		if (m_buff == NULL)
 		{
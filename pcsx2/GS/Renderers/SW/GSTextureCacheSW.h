@@ -16,7 +16,6 @@
 #pragma once
 
 #include "GS/Renderers/Common/GSRenderer.h"
-#include "GS/Renderers/Common/GSFastList.h"
 
 class GSTextureCacheSW
 {
@@ -32,17 +31,21 @@ public:
 		void* m_buff;
 		uint32 m_tw;
 		uint32 m_age;
+		uint32 m_slot;
+		uint32 m_size;
 		bool m_complete;
 		bool m_repeating;
 		std::vector<GSVector2i>* m_p2t;
 		uint32 m_valid[MAX_PAGES];
-		std::array<uint16, MAX_PAGES> m_erase_it;
 		const uint32* RESTRICT m_sharedbits;
 
 		// m_valid
 		// fast mode: each uint32 bits map to the 32 blocks of that page
 		// repeating mode: 1 bpp image of the texture tiles (8x8), also having 512 elements is just a coincidence (worst case: (1024*1024)/(8*8)/(sizeof(uint32)*8))
 
+		// m_size
+		// bytes m_buff will take once the texture is updated, counted against the cache budget from the start
+
 		Texture(GSState* state, uint32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
 		virtual ~Texture();
 
@@ -52,8 +55,26 @@ public:
 
 protected:
 	GSState* m_state;
-	std::unordered_set<Texture*> m_textures;
-	std::array<FastList<Texture*>, MAX_PAGES> m_map;
+
+	// TBP0 TBW PSM TW TH => textures differing only by TEXA or tw0
+	std::unordered_map<uint64, std::vector<Texture*>> m_map;
+
+	// Every texture owns a slot, m_owners[page] has bit n set when m_slots[n] covers that page.
+	// Invalidation only visits the set bits instead of walking per page lists.
+	std::vector<Texture*> m_slots;
+	std::vector<uint32> m_free_slots;
+	std::array<std::vector<uint32>, MAX_PAGES> m_owners;
+
+	size_t m_size;
+	size_t m_budget;
+
+	static __forceinline uint64 GetKey(const GIFRegTEX0& TEX0)
+	{
+		return TEX0.u32[0] | ((uint64)(TEX0.u32[1] & 3) << 32);
+	}
+
+	uint32 AllocSlot();
+	void Remove(Texture* t);
 
 public:
 	GSTextureCacheSW(GSState* state);
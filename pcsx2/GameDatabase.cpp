@@ -22,6 +22,8 @@
 #include "yaml-cpp/yaml.h"
 #include <fstream>
 #include <algorithm>
+#include <numeric>
+#include <wx/ffile.h>
 
 std::string strToLower(std::string str)
 {
@@ -247,3 +249,464 @@ bool YamlGameDatabaseImpl::initDatabase(std::ifstream& stream)
 
 	return true;
 }
+
+// --------------------------------------------------------------------------------------
+//  BinaryGameDatabaseImpl
+// --------------------------------------------------------------------------------------
+// Layout, little endian:
+//   BinaryHeader
+//   u32 seeds[bucketCount]   hash seed of each bucket
+//   u32 offsets[count]       offset of the entry stored in each slot
+//   entries
+//
+// A serial's slot is hashSerial(serial, seeds[hashSerial(serial, 0) % bucketCount]) % count.
+// Every slot holds exactly one entry, which starts with its serial, so serials that aren't
+// in the database are caught by comparing it.  Strings are a u32 length and the characters.
+
+namespace
+{
+	struct BinaryHeader
+	{
+		char magic[8];
+		u32 version;
+		u32 count;
+		u32 bucketCount;
+		u32 seedsOffset;
+		u32 offsetsOffset;
+		u32 reserved;
+		u64 sourceSize; // size and modification time of the YAML, for the cache file
+		s64 sourceTime;
+	};
+	static_assert(sizeof(BinaryHeader) == 48, "BinaryHeader must not have padding");
+
+	static constexpr char BinaryMagic[8] = {'P', 'C', 'S', 'X', '2', 'G', 'D', 'B'};
+	static constexpr u32 BinaryVersion = 1;
+
+	class EntryWriter
+	{
+		std::vector<u8>& m_out;
+
+	public:
+		EntryWriter(std::vector<u8>& out)
+			: m_out(out)
+		{
+		}
+
+		void putU32(u32 value)
+		{
+			const size_t pos = m_out.size();
+			m_out.resize(pos + sizeof(value));
+			memcpy(&m_out[pos], &value, sizeof(value));
+		}
+
+		void putS32(s32 value) { putU32(static_cast<u32>(value)); }
+
+		void putString(const std::string& value)
+		{
+			putU32(static_cast<u32>(value.size()));
+			m_out.insert(m_out.end(), value.begin(), value.end());
+		}
+
+		void putStrings(const std::vector<std::string>& values)
+		{
+			putU32(static_cast<u32>(values.size()));
+			for (const std::string& value : values)
+				putString(value);
+		}
+	};
+
+	// Reads are bounds checked, past the end everything reads as zero and ok() turns false.
+	class EntryReader
+	{
+		const u8* m_pos;
+		const u8* m_end;
+		bool m_ok = true;
+
+	public:
+		EntryReader(const u8* data, size_t size)
+			: m_pos(data)
+			, m_end(data + size)
+		{
+		}
+
+		bool ok() const { return m_ok; }
+
+		u32 getU32()
+		{
+			u32 value = 0;
+			if (static_cast<size_t>(m_end - m_pos) < sizeof(value))
+			{
+				m_ok = false;
+				return 0;
+			}
+			memcpy(&value, m_pos, sizeof(value));
+			m_pos += sizeof(value);
+			return value;
+		}
+
+		s32 getS32() { return static_cast<s32>(getU32()); }
+
+		std::string getString()
+		{
+			const u32 length = getU32();
+			if (static_cast<size_t>(m_end - m_pos) < length)
+			{
+				m_ok = false;
+				return std::string();
+			}
+			std::string value(reinterpret_cast<const char*>(m_pos), length);
+			m_pos += length;
+			return value;
+		}
+
+		std::vector<std::string> getStrings()
+		{
+			std::vector<std::string> values;
+			const u32 count = getU32();
+			for (u32 i = 0; i < count && m_ok; i++)
+				values.push_back(getString());
+			return values;
+		}
+	};
+} // namespace
+
+static u32 readU32(const u8* ptr)
+{
+	u32 value;
+	memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+// FNV-1a, started from the seed and run through a 64 bit finalizer so every seed gives an
+// unrelated hash.
+static u32 hashSerial(const std::string& serial, u32 seed)
+{
+	u64 hash = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+	for (const char c : serial)
+	{
+		hash ^= static_cast<u8>(c);
+		hash *= 0x100000001b3ull;
+	}
+
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+	return static_cast<u32>(hash);
+}
+
+static void encodeEntry(EntryWriter& writer, const std::string& serial, const GameDatabaseSchema::GameEntry& entry)
+{
+	writer.putString(serial);
+	writer.putU32(entry.isValid ? 1 : 0);
+	writer.putString(entry.name);
+	writer.putString(entry.region);
+	writer.putS32(enum_cast(entry.compat));
+	writer.putS32(enum_cast(entry.eeRoundMode));
+	writer.putS32(enum_cast(entry.vuRoundMode));
+	writer.putS32(enum_cast(entry.eeClampMode));
+	writer.putS32(enum_cast(entry.vuClampMode));
+	writer.putStrings(entry.gameFixes);
+
+	writer.putU32(static_cast<u32>(entry.speedHacks.size()));
+	for (const auto& speedHack : entry.speedHacks)
+	{
+		writer.putString(speedHack.first);
+		writer.putS32(speedHack.second);
+	}
+
+	writer.putStrings(entry.memcardFilters);
+
+	writer.putU32(static_cast<u32>(entry.patches.size()));
+	for (const auto& patch : entry.patches)
+	{
+		writer.putString(patch.first);
+		writer.putString(patch.second.author);
+		writer.putStrings(patch.second.patchLines);
+	}
+}
+
+// Decodes what follows the serial.
+static bool decodeEntry(EntryReader& reader, GameDatabaseSchema::GameEntry& entry)
+{
+	entry.isValid = reader.getU32() != 0;
+	entry.name = reader.getString();
+	entry.region = reader.getString();
+	entry.compat = static_cast<GameDatabaseSchema::Compatibility>(reader.getS32());
+	entry.eeRoundMode = static_cast<GameDatabaseSchema::RoundMode>(reader.getS32());
+	entry.vuRoundMode = static_cast<GameDatabaseSchema::RoundMode>(reader.getS32());
+	entry.eeClampMode = static_cast<GameDatabaseSchema::ClampMode>(reader.getS32());
+	entry.vuClampMode = static_cast<GameDatabaseSchema::ClampMode>(reader.getS32());
+	entry.gameFixes = reader.getStrings();
+
+	const u32 speedHackCount = reader.getU32();
+	for (u32 i = 0; i < speedHackCount && reader.ok(); i++)
+	{
+		std::string speedHack = reader.getString();
+		entry.speedHacks[speedHack] = reader.getS32();
+	}
+
+	entry.memcardFilters = reader.getStrings();
+
+	const u32 patchCount = reader.getU32();
+	for (u32 i = 0; i < patchCount && reader.ok(); i++)
+	{
+		std::string crc = reader.getString();
+		GameDatabaseSchema::Patch& patch = entry.patches[crc];
+		patch.author = reader.getString();
+		patch.patchLines = reader.getStrings();
+	}
+
+	return reader.ok();
+}
+
+// Places the serials with hash and displace: the buckets, biggest first, each search for a
+// seed which sends all of their serials to free slots.  With about four serials per bucket
+// that takes a few attempts for the early buckets, and the last ones just look for a free
+// slot.
+static bool buildImage(const std::unordered_map<std::string, GameDatabaseSchema::GameEntry>& games, std::vector<u8>& image)
+{
+	std::vector<const std::pair<const std::string, GameDatabaseSchema::GameEntry>*> items;
+	items.reserve(games.size());
+	for (const auto& game : games)
+		items.push_back(&game);
+
+	const u32 count = static_cast<u32>(items.size());
+	const u32 bucketCount = std::max<u32>(1, (count + 3) / 4);
+
+	std::vector<std::vector<u32>> buckets(bucketCount);
+	for (u32 i = 0; i < count; i++)
+		buckets[hashSerial(items[i]->first, 0) % bucketCount].push_back(i);
+
+	std::vector<u32> order(bucketCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&buckets](u32 a, u32 b) {
+		return buckets[a].size() > buckets[b].size();
+	});
+
+	static constexpr u32 EmptySlot = 0xffffffff;
+	std::vector<u32> seeds(bucketCount, 0);
+	std::vector<u32> slots(count, EmptySlot);
+	std::vector<u32> positions;
+
+	for (const u32 bucket : order)
+	{
+		const std::vector<u32>& members = buckets[bucket];
+		if (members.empty())
+			break;
+
+		u32 seed = 1;
+		for (; seed != 0; seed++)
+		{
+			positions.clear();
+			for (const u32 item : members)
+			{
+				const u32 slot = hashSerial(items[item]->first, seed) % count;
+				if (slots[slot] != EmptySlot || std::find(positions.begin(), positions.end(), slot) != positions.end())
+					break;
+				positions.push_back(slot);
+			}
+
+			if (positions.size() == members.size())
+				break;
+		}
+
+		if (seed == 0)
+			return false;
+
+		seeds[bucket] = seed;
+		for (size_t i = 0; i < members.size(); i++)
+			slots[positions[i]] = members[i];
+	}
+
+	BinaryHeader header = {};
+	memcpy(header.magic, BinaryMagic, sizeof(header.magic));
+	header.version = BinaryVersion;
+	header.count = count;
+	header.bucketCount = bucketCount;
+	header.seedsOffset = sizeof(BinaryHeader);
+	header.offsetsOffset = header.seedsOffset + bucketCount * sizeof(u32);
+
+	image.clear();
+	image.resize(header.offsetsOffset + count * sizeof(u32));
+	memcpy(&image[0], &header, sizeof(header));
+	memcpy(&image[header.seedsOffset], seeds.data(), bucketCount * sizeof(u32));
+
+	EntryWriter writer(image);
+	for (u32 slot = 0; slot < count; slot++)
+	{
+		const u32 offset = static_cast<u32>(image.size());
+		memcpy(&image[header.offsetsOffset + slot * sizeof(u32)], &offset, sizeof(offset));
+		encodeEntry(writer, items[slots[slot]]->first, items[slots[slot]]->second);
+	}
+
+	return true;
+}
+
+BinaryGameDatabaseImpl::~BinaryGameDatabaseImpl()
+{
+	close();
+}
+
+void BinaryGameDatabaseImpl::close()
+{
+	HostSys::UnmapFile(m_mapping, m_mappingSize);
+	m_mapping = nullptr;
+	m_mappingSize = 0;
+	m_built.clear();
+
+	m_data = nullptr;
+	m_size = 0;
+	m_count = 0;
+	m_bucketCount = 0;
+	m_seeds = nullptr;
+	m_offsets = nullptr;
+}
+
+bool BinaryGameDatabaseImpl::useImage(const u8* data, size_t size)
+{
+	BinaryHeader header;
+	if (size < sizeof(header))
+		return false;
+
+	memcpy(&header, data, sizeof(header));
+	if (memcmp(header.magic, BinaryMagic, sizeof(header.magic)) != 0 || header.version != BinaryVersion)
+		return false;
+
+	// The entries themselves are checked as they are decoded.
+	if ((header.count != 0 && header.bucketCount == 0) ||
+		static_cast<u64>(header.seedsOffset) + static_cast<u64>(header.bucketCount) * sizeof(u32) > size ||
+		static_cast<u64>(header.offsetsOffset) + static_cast<u64>(header.count) * sizeof(u32) > size)
+		return false;
+
+	m_data = data;
+	m_size = size;
+	m_count = header.count;
+	m_bucketCount = header.bucketCount;
+	m_seeds = data + header.seedsOffset;
+	m_offsets = data + header.offsetsOffset;
+	return true;
+}
+
+bool BinaryGameDatabaseImpl::openCache(const wxString& path, u64 sourceSize, s64 sourceTime)
+{
+	close();
+
+	size_t size = 0;
+	void* mapping = HostSys::MapFileReadOnly(path, size);
+	if (!mapping)
+		return false;
+
+	BinaryHeader header;
+	const bool current = size >= sizeof(header) &&
+						 (memcpy(&header, mapping, sizeof(header)), header.sourceSize == sourceSize && header.sourceTime == sourceTime);
+
+	if (!current || !useImage(static_cast<const u8*>(mapping), size))
+	{
+		HostSys::UnmapFile(mapping, size);
+		return false;
+	}
+
+	m_mapping = mapping;
+	m_mappingSize = size;
+	return true;
+}
+
+bool BinaryGameDatabaseImpl::writeCache(const wxString& path, u64 sourceSize, s64 sourceTime)
+{
+	if (m_built.size() < sizeof(BinaryHeader))
+		return false;
+
+	BinaryHeader header;
+	memcpy(&header, m_built.data(), sizeof(header));
+	header.sourceSize = sourceSize;
+	header.sourceTime = sourceTime;
+
+	// Written beside the cache and renamed over it, so a cut short write is never picked up.
+	const wxString temp = path + L".tmp";
+	{
+		wxLogNull noLog;
+		wxFFile file;
+		if (!file.Open(temp, L"wb"))
+			return false;
+
+		const bool written = file.Write(&header, sizeof(header)) == sizeof(header) &&
+							 file.Write(m_built.data() + sizeof(header), m_built.size() - sizeof(header)) == m_built.size() - sizeof(header) &&
+							 file.Close();
+		if (!written)
+		{
+			file.Close();
+			wxRemoveFile(temp);
+			return false;
+		}
+
+		if (!wxRenameFile(temp, path, true))
+		{
+			wxRemoveFile(temp);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool BinaryGameDatabaseImpl::initDatabase(std::ifstream& stream)
+{
+	close();
+
+	YamlGameDatabaseImpl yaml;
+	if (!yaml.initDatabase(stream))
+		return false;
+
+	std::vector<u8> image;
+	if (!buildImage(yaml.getGames(), image))
+	{
+		Console.Error("[GameDB] Unable to index the GameDB");
+		return false;
+	}
+
+	m_built = std::move(image);
+	return useImage(m_built.data(), m_built.size());
+}
+
+GameDatabaseSchema::GameEntry BinaryGameDatabaseImpl::findGame(const std::string serial)
+{
+	std::string serialLower = strToLower(serial);
+	Console.WriteLn(fmt::format("[GameDB] Searching for '{}' in GameDB", serialLower));
+
+	GameDatabaseSchema::GameEntry entry;
+	if (m_count != 0)
+	{
+		const u32 bucket = hashSerial(serialLower, 0) % m_bucketCount;
+		const u32 slot = hashSerial(serialLower, readU32(m_seeds + bucket * sizeof(u32))) % m_count;
+		const u32 offset = readU32(m_offsets + slot * sizeof(u32));
+
+		if (offset < m_size)
+		{
+			EntryReader reader(m_data + offset, m_size - offset);
+			if (reader.getString() == serialLower && reader.ok())
+			{
+				if (decodeEntry(reader, entry))
+				{
+					Console.WriteLn(fmt::format("[GameDB] Found '{}' in GameDB", serialLower));
+					return entry;
+				}
+
+				Console.Error(fmt::format("[GameDB] Entry for '{}' is corrupt", serialLower));
+				entry = GameDatabaseSchema::GameEntry();
+				entry.isValid = false;
+				return entry;
+			}
+		}
+	}
+
+	Console.Error(fmt::format("[GameDB] Could not find '{}' in GameDB", serialLower));
+	entry.isValid = false;
+	return entry;
+}
+
+int BinaryGameDatabaseImpl::numGames()
+{
+	return m_count;
+}
@@ -98,6 +98,8 @@ public:
 	GameDatabaseSchema::GameEntry findGame(const std::string serial) override;
 	int numGames() override;
 
+	const std::unordered_map<std::string, GameDatabaseSchema::GameEntry>& getGames() const { return gameDb; }
+
 private:
 	std::unordered_map<std::string, GameDatabaseSchema::GameEntry> gameDb;
 	GameDatabaseSchema::GameEntry entryFromYaml(const std::string serial, const YAML::Node& node);
@@ -105,6 +107,44 @@ private:
 	std::vector<std::string> convertMultiLineStringToVector(const std::string multiLineString);
 };
 
+// Compact form of the database, built from the YAML and kept in a cache file that is mapped
+// as is.  Serials are looked up through a perfect hash, and entries stay encoded until they
+// are asked for, so opening the database costs next to nothing.
+class BinaryGameDatabaseImpl : public IGameDatabase
+{
+public:
+	BinaryGameDatabaseImpl() = default;
+	virtual ~BinaryGameDatabaseImpl();
+
+	BinaryGameDatabaseImpl(const BinaryGameDatabaseImpl&) = delete;
+	BinaryGameDatabaseImpl& operator=(const BinaryGameDatabaseImpl&) = delete;
+
+	// Parses the YAML, and builds the database in memory
+	bool initDatabase(std::ifstream& stream) override;
+	GameDatabaseSchema::GameEntry findGame(const std::string serial) override;
+	int numGames() override;
+
+	// Maps the cache file, if it was built from a YAML of the given size and modification time
+	bool openCache(const wxString& path, u64 sourceSize, s64 sourceTime);
+	// Saves the database built by initDatabase, tagged with the YAML it came from
+	bool writeCache(const wxString& path, u64 sourceSize, s64 sourceTime);
+
+private:
+	bool useImage(const u8* data, size_t size);
+	void close();
+
+	std::vector<u8> m_built;
+	void* m_mapping = nullptr;
+	size_t m_mappingSize = 0;
+
+	const u8* m_data = nullptr;
+	size_t m_size = 0;
+	u32 m_count = 0;
+	u32 m_bucketCount = 0;
+	const u8* m_seeds = nullptr;
+	const u8* m_offsets = nullptr;
+};
+
 extern IGameDatabase* AppHost_GetGameDatabase();
 extern std::string strToLower(std::string str);
 extern bool compareStrNoCase(const std::string str1, const std::string str2);
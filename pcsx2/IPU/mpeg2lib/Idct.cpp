@@ -22,10 +22,6 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
-// [TODO] : There are modern SSE versions of idct (idct_mmx.c) in the mpeg2 libs that we
-// should probably upgrade to.  They use their own raw-style intrinsics and not the intel
-// compiler-integrated ones.
-
 #include "PrecompiledHeader.h"
 
 #include "Common.h"
@@ -155,31 +151,168 @@ static __fi void idct_col (s16 * const block)
     block[8*7] = (a0 - b0) >> 17;
 }
 
-__ri void mpeg2_idct_copy(s16 * block, u8 * dest, const int stride)
+// Scalar version of the IDCT below, kept as the reference the SSE version must match
+// (see tests/ctest/IPU).
+__ri void mpeg2_idct_reference(s16 * block)
 {
-    int i;
-
-    for (i = 0; i < 8; i++)
+	for (int i = 0; i < 8; i++)
 		idct_row (block + 8 * i);
-    for (i = 0; i < 8; i++)
+	for (int i = 0; i < 8; i++)
 		idct_col (block + i);
+}
+
+static __fi void transpose8x8(__m128i (&r)[8])
+{
+	const __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+	const __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+	const __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+	const __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+	const __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+	const __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+	const __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+	const __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+	const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+	const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+	const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+	const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+	const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+	const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+	const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+	const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+	r[0] = _mm_unpacklo_epi64(b0, b4);
+	r[1] = _mm_unpackhi_epi64(b0, b4);
+	r[2] = _mm_unpacklo_epi64(b1, b5);
+	r[3] = _mm_unpackhi_epi64(b1, b5);
+	r[4] = _mm_unpacklo_epi64(b2, b6);
+	r[5] = _mm_unpackhi_epi64(b2, b6);
+	r[6] = _mm_unpacklo_epi64(b3, b7);
+	r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+static __fi __m128i mul(__m128i a, int w)
+{
+	return _mm_mullo_epi32(a, _mm_set1_epi32(w));
+}
+
+// Same as BUTTERFLY, 4 lanes.
+static __fi void butterfly(__m128i& t0, __m128i& t1, int w0, int w1, __m128i d0, __m128i d1)
+{
+	const __m128i tmp = mul(_mm_add_epi32(d0, d1), w0);
+	t0 = _mm_add_epi32(tmp, mul(d1, w1 - w0));
+	t1 = _mm_sub_epi32(tmp, mul(d0, w1 + w0));
+}
+
+// One 1D pass of idct_row (col = false) or idct_col (col = true) on 4 lanes of 32 bits,
+// d[k] holds input k of each of the 4 transforms.
+template <bool col>
+static __fi void idct_1d(__m128i (&d)[8])
+{
+	__m128i t0, t1, t2, t3;
+
+	const __m128i d0 = _mm_add_epi32(_mm_slli_epi32(d[0], 11), _mm_set1_epi32(col ? 65536 : 128));
+	const __m128i d2 = _mm_slli_epi32(d[2], 11);
+	t0 = _mm_add_epi32(d0, d2);
+	t1 = _mm_sub_epi32(d0, d2);
+	butterfly(t2, t3, W6, W2, d[3], d[1]);
+	const __m128i a0 = _mm_add_epi32(t0, t2);
+	const __m128i a1 = _mm_add_epi32(t1, t3);
+	const __m128i a2 = _mm_sub_epi32(t1, t3);
+	const __m128i a3 = _mm_sub_epi32(t0, t2);
+
+	butterfly(t0, t1, W7, W1, d[7], d[4]);
+	butterfly(t2, t3, W3, W5, d[5], d[6]);
+	const __m128i b0 = _mm_add_epi32(t0, t2);
+	const __m128i b3 = _mm_add_epi32(t1, t3);
+	t0 = _mm_sub_epi32(t0, t2);
+	t1 = _mm_sub_epi32(t1, t3);
+
+	__m128i b1, b2;
+
+	if (col)
+	{
+		t0 = _mm_srai_epi32(t0, 8);
+		t1 = _mm_srai_epi32(t1, 8);
+		b1 = mul(_mm_add_epi32(t0, t1), 181);
+		b2 = mul(_mm_sub_epi32(t0, t1), 181);
+	}
+	else
+	{
+		b1 = _mm_srai_epi32(mul(_mm_add_epi32(t0, t1), 181), 8);
+		b2 = _mm_srai_epi32(mul(_mm_sub_epi32(t0, t1), 181), 8);
+	}
 
-	__m128 zero = _mm_setzero_ps();
-    do {
-		dest[0] = CLIP (block[0]);
-		dest[1] = CLIP (block[1]);
-		dest[2] = CLIP (block[2]);
-		dest[3] = CLIP (block[3]);
-		dest[4] = CLIP (block[4]);
-		dest[5] = CLIP (block[5]);
-		dest[6] = CLIP (block[6]);
-		dest[7] = CLIP (block[7]);
+	const int shift = col ? 17 : 8;
 
-		_mm_store_ps((float*)block, zero);
+	d[0] = _mm_srai_epi32(_mm_add_epi32(a0, b0), shift);
+	d[1] = _mm_srai_epi32(_mm_add_epi32(a1, b1), shift);
+	d[2] = _mm_srai_epi32(_mm_add_epi32(a2, b2), shift);
+	d[3] = _mm_srai_epi32(_mm_add_epi32(a3, b3), shift);
+	d[4] = _mm_srai_epi32(_mm_sub_epi32(a3, b3), shift);
+	d[5] = _mm_srai_epi32(_mm_sub_epi32(a2, b2), shift);
+	d[6] = _mm_srai_epi32(_mm_sub_epi32(a1, b1), shift);
+	d[7] = _mm_srai_epi32(_mm_sub_epi32(a0, b0), shift);
+}
+
+// Narrows to 16 bits by truncation, like the scalar stores into the s16 block.
+static __fi __m128i pack_trunc(__m128i lo, __m128i hi)
+{
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+
+	return _mm_packs_epi32(lo, hi);
+}
+
+// Runs the 1D pass on the 8 vectors of r, lane i of each vector being one transform.
+template <bool col>
+static __fi void idct_pass(__m128i (&r)[8])
+{
+	__m128i lo[8], hi[8];
+
+	for (int i = 0; i < 8; i++)
+	{
+		lo[i] = _mm_cvtepi16_epi32(r[i]);
+		hi[i] = _mm_cvtepi16_epi32(_mm_srli_si128(r[i], 8));
+	}
+
+	idct_1d<col>(lo);
+	idct_1d<col>(hi);
+
+	for (int i = 0; i < 8; i++)
+		r[i] = pack_trunc(lo[i], hi[i]);
+}
+
+// Bit exact with mpeg2_idct_reference. The row pass works on the transposed block so both
+// passes process 8 transforms side by side. The row shortcut of the scalar version (only
+// the DC set) gives the same result as the full transform, so it isn't needed here.
+static __fi void idct_sse(const s16 * block, __m128i (&r)[8])
+{
+	for (int i = 0; i < 8; i++)
+		r[i] = _mm_load_si128((const __m128i*)(block + 8 * i));
+
+	transpose8x8(r);
+	idct_pass<false>(r);
+	transpose8x8(r);
+	idct_pass<true>(r);
+}
+
+__ri void mpeg2_idct_copy(s16 * block, u8 * dest, const int stride)
+{
+	__m128i r[8];
+
+	idct_sse(block, r);
+
+	// Legal streams stay within the range of clip_lut, which is a plain clamp to 0-255.
+	const __m128i zero = _mm_setzero_si128();
+
+	for (int i = 0; i < 8; i++)
+	{
+		_mm_storel_epi64((__m128i*)dest, _mm_packus_epi16(r[i], r[i]));
+		_mm_store_si128((__m128i*)(block + 8 * i), zero);
 
 		dest += stride;
-		block += 8;
-    } while (--i);
+	}
 }
 
 
@@ -190,21 +323,19 @@ __ri void mpeg2_idct_add (const int last, s16 * block, s16 * dest, const int str
 
     if (last != 129 || (block[0] & 7) == 4)
     {
-		int i;
-		for (i = 0; i < 8; i++)
-			idct_row (block + 8 * i);
-		for (i = 0; i < 8; i++)
-			idct_col (block + i);
+		__m128i r[8];
 
-		__m128 zero = _mm_setzero_ps();
-		do {
-			_mm_store_ps((float*)dest, _mm_load_ps((float*)block));
-			_mm_store_ps((float*)block, zero);
+		idct_sse(block, r);
 
-			dest += stride;
-			block += 8;
-		} while (--i);
+		const __m128i zero = _mm_setzero_si128();
 
+		for (int i = 0; i < 8; i++)
+		{
+			_mm_store_si128((__m128i*)dest, r[i]);
+			_mm_store_si128((__m128i*)(block + 8 * i), zero);
+
+			dest += stride;
+		}
     }
     else
     {
@@ -34,6 +34,7 @@
 #include "Vlc.h"
 
 #include "common/MemsetFast.inl"
+#include "common/MathUtils.h"
 
 const int non_linear_quantizer_scale [] =
 {
@@ -52,6 +53,55 @@ const int non_linear_quantizer_scale [] =
 const DCTtab * tab;
 int mbaCount = 0;
 
+// DCT coefficient code lookup, indexed by the number of leading zeros of the next 16 bits
+// of the stream. Replaces the chain of range checks picking one of the tables of DCTtabSet,
+// each entry gives the table and how to index it: tab[(code >> shift) - bias].
+// Codes below 16 (12 leading zeros or more) are invalid and handled by the caller.
+struct DCTlookup
+{
+	const DCTtab* tab;
+	u8 shift;
+	u8 bias;
+};
+
+// Table B-14, first coefficient of a non intra block
+static const DCTlookup DCT_B14_first[12] =
+{
+	{DCT.first, 12, 4}, {DCT.first, 12, 4},
+	{DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4},
+	{DCT.tab1, 6, 8},
+	{DCT.tab2, 4, 16}, {DCT.tab3, 3, 16}, {DCT.tab4, 2, 16}, {DCT.tab5, 1, 16}, {DCT.tab6, 0, 16},
+};
+
+// Table B-14, all other coefficients
+static const DCTlookup DCT_B14_next[12] =
+{
+	{DCT.next, 12, 4}, {DCT.next, 12, 4},
+	{DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4},
+	{DCT.tab1, 6, 8},
+	{DCT.tab2, 4, 16}, {DCT.tab3, 3, 16}, {DCT.tab4, 2, 16}, {DCT.tab5, 1, 16}, {DCT.tab6, 0, 16},
+};
+
+// Table B-15, intra blocks with intra_vlc_format (MPEG-2 only)
+static const DCTlookup DCT_B15[12] =
+{
+	{DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4},
+	{DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4},
+	{DCT.tab1a, 6, 8},
+	{DCT.tab2, 4, 16}, {DCT.tab3, 3, 16}, {DCT.tab4, 2, 16}, {DCT.tab5, 1, 16}, {DCT.tab6, 0, 16},
+};
+
+// Returns nullptr for an invalid code (below 16).
+static __fi const DCTtab* get_dct_tab(const DCTlookup (&lookup)[12], u16 code)
+{
+	if (code < 16)
+		return nullptr;
+
+	const DCTlookup& l = lookup[count_leading_sign_bits(code) - 16];
+
+	return &l.tab[(code >> l.shift) - l.bias];
+}
+
 int bitstream_init ()
 {
 	return g_BP.FillBuffer(32);
@@ -362,60 +412,9 @@ static bool get_intra_block()
 		}
 
 		code = UBITS(16);
+		tab = get_dct_tab((decoder.intra_vlc_format && !decoder.mpeg1) ? DCT_B15 : DCT_B14_next, code);
 
-		if (code >= 16384 && (!decoder.intra_vlc_format || decoder.mpeg1))
-		{
-		  tab = &DCT.next[(code >> 12) - 4];
-		}
-		else if (code >= 1024)
-		{
-			if (decoder.intra_vlc_format && !decoder.mpeg1)
-			{
-				tab = &DCT.tab0a[(code >> 8) - 4];
-			}
-			else
-			{
-				tab = &DCT.tab0[(code >> 8) - 4];
-			}
-		}
-		else if (code >= 512)
-		{
-			if (decoder.intra_vlc_format && !decoder.mpeg1)
-			{
-				tab = &DCT.tab1a[(code >> 6) - 8];
-			}
-			else
-			{
-				tab = &DCT.tab1[(code >> 6) - 8];
-			}
-		}
-
-		// [TODO] Optimization: Following codes can all be done by a single "expedited" lookup
-		// that should use a single unrolled DCT table instead of five separate tables used
-		// here.  Multiple conditional statements are very slow, while modern CPU data caches
-		// have lots of room to spare.
-
-		else if (code >= 256)
-		{
-			tab = &DCT.tab2[(code >> 4) - 16];
-		}
-		else if (code >= 128)
-		{
-			tab = &DCT.tab3[(code >> 3) - 16];
-		}
-		else if (code >= 64)
-		{
-			tab = &DCT.tab4[(code >> 2) - 16];
-		}
-		else if (code >= 32)
-		{
-			tab = &DCT.tab5[(code >> 1) - 16];
-		}
-		else if (code >= 16)
-		{
-			tab = &DCT.tab6[code - 16];
-		}
-		else
+		if (!tab)
 		{
 		  ipu_cmd.pos[4] = 0;
 		  return true;
@@ -520,53 +519,9 @@ static bool get_non_intra_block(int * last)
 			}
 
 			code = UBITS(16);
+			tab = get_dct_tab((i == 0) ? DCT_B14_first : DCT_B14_next, code);
 
-			if (code >= 16384)
-			{
-				if (i==0)
-				{
-					tab = &DCT.first[(code >> 12) - 4];
-				}
-				else
-				{			
-					tab = &DCT.next[(code >> 12)- 4];
-				}
-			}
-			else if (code >= 1024)
-			{
-				tab = &DCT.tab0[(code >> 8) - 4];
-			}
-			else if (code >= 512)
-			{		
-				tab = &DCT.tab1[(code >> 6) - 8];
-			}
-
-			// [TODO] Optimization: Following codes can all be done by a single "expedited" lookup
-			// that should use a single unrolled DCT table instead of five separate tables used
-			// here.  Multiple conditional statements are very slow, while modern CPU data caches
-			// have lots of room to spare.
-
-			else if (code >= 256)
-			{		
-				tab = &DCT.tab2[(code >> 4) - 16];
-			}
-			else if (code >= 128)
-			{		
-				tab = &DCT.tab3[(code >> 3) - 16];
-			}
-			else if (code >= 64)
-			{		
-				tab = &DCT.tab4[(code >> 2) - 16];
-			}
-			else if (code >= 32)
-			{		
-				tab = &DCT.tab5[(code >> 1) - 16];
-			}
-			else if (code >= 16)
-			{		
-				tab = &DCT.tab6[code - 16];
-			}
-			else
+			if (!tab)
 			{
 				ipu_cmd.pos[4] = 0;
 				return true;
@@ -194,6 +194,7 @@ extern s32 SBITS(uint bits);
 
 extern void mpeg2_idct_copy(s16 * block, u8* dest, int stride);
 extern void mpeg2_idct_add(int last, s16 * block, s16* dest, int stride);
+extern void mpeg2_idct_reference(s16 * block);
 
 extern bool mpeg2sliceIDEC();
 extern bool mpeg2_slice();
@@ -507,7 +507,7 @@ void psxRcntUpdate()
 	if (difference >= psxCounters[6].CycleT)
 	{
 		psxCounters[6].sCycleT = psxRegs.cycle;
-		psxCounters[6].CycleT = psxCounters[6].rate;
+		psxCounters[6].CycleT = SPU2GetAsyncInterval();
 		SPU2async(difference);
 		c = psxCounters[6].CycleT;
 	}
@@ -300,6 +300,8 @@ void SysMtgsThread::ExecuteTaskInThread()
 
 	RingBufferLock busy(*this);
 
+	Threading::PlaceCurrentThread(Threading::ThreadRole::MTGS);
+
 	while (true)
 	{
 		busy.Release();
@@ -456,6 +458,8 @@ void SysMtgsThread::ExecuteTaskInThread()
 							const int qsize = tag.data[0];
 							ringposinc += qsize;
 
+							Threading::SampleThreadPlacement();
+
 							MTGS_LOG("(MTGS Packet Read) ringtype=Vsync, field=%u, skip=%s", !!(((u32&)RingBuffer.Regs[0x1000]) & 0x2000) ? 0 : 1, tag.data[1] ? "true" : "false");
 
 							// Mail in the important GS registers.
@@ -609,6 +613,7 @@ void SysMtgsThread::OnCleanupInThread()
 	CloseGS();
 	// Unblock any threads in WaitGS in case MTGS gets cancelled while still processing work
 	m_ReadPos.store(m_WritePos.load(std::memory_order_acquire), std::memory_order_relaxed);
+	Threading::ReleaseCurrentThread();
 	_parent::OnCleanupInThread();
 }
 
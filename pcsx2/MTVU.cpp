@@ -122,6 +122,8 @@ void VU_Thread::Reset()
 
 void VU_Thread::ExecuteTaskInThread()
 {
+	Threading::PlaceCurrentThread(Threading::ThreadRole::MTVU);
+
 	PCSX2_PAGEFAULT_PROTECT
 	{
 		ExecuteRingBuffer();
@@ -129,11 +131,18 @@ void VU_Thread::ExecuteTaskInThread()
 	PCSX2_PAGEFAULT_EXCEPT;
 }
 
+void VU_Thread::OnCleanupInThread()
+{
+	Threading::ReleaseCurrentThread();
+	pxThread::OnCleanupInThread();
+}
+
 void VU_Thread::ExecuteRingBuffer()
 {
 	for (;;)
 	{
 		semaEvent.WaitWithoutYield();
+		Threading::SampleThreadPlacement();
 		ScopedLockBool lock(mtxBusy, isBusy);
 		while (m_ato_read_pos.load(std::memory_order_relaxed) != GetWritePos())
 		{
@@ -96,6 +96,7 @@ public:
 
 protected:
 	void ExecuteTaskInThread();
+	void OnCleanupInThread();
 
 private:
 	void ExecuteRingBuffer();
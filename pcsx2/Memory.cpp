@@ -48,6 +48,7 @@ BIOS
 #include "SPU2/spu2.h"
 
 #include "common/PageFaultSource.h"
+#include "DebugTools/MemoryWatch.h"
 
 #ifdef ENABLECACHE
 #include "Cache.h"
@@ -928,6 +929,16 @@ vtlb_ProtectionMode mmap_GetRamPageInfo( u32 paddr )
 	return m_PageProtectInfo[rampage].Mode;
 }
 
+// Applies the protection wanted by the block tracking to a ram page, unless a memory
+// watch needs it to be stricter (see MemoryWatch.h).
+void mmap_ProtectRamPage( uint rampage )
+{
+	const PageProtectionMode mode = (m_PageProtectInfo[rampage].Mode == ProtMode_Write) ?
+		PageAccess_ReadOnly() : PageAccess_ReadWrite();
+
+	HostSys::MemProtect( &eeMem->Main[rampage<<12], __pagesize, MemoryWatch::GetPageAccess( BREAKPOINT_EE, rampage, mode ) );
+}
+
 // paddr - physically mapped PS2 address
 void mmap_MarkCountedRamPage( u32 paddr )
 {
@@ -952,7 +963,7 @@ void mmap_MarkCountedRamPage( u32 paddr )
 	);
 
 	m_PageProtectInfo[rampage].Mode = ProtMode_Write;
-	HostSys::MemProtect( &eeMem->Main[rampage<<12], __pagesize, PageAccess_ReadOnly() );
+	mmap_ProtectRamPage( rampage );
 }
 
 // offset - offset of address relative to psM.
@@ -969,8 +980,8 @@ static __fi void mmap_ClearCpuBlock( uint offset )
 	pxAssertMsg( m_PageProtectInfo[rampage].Mode != ProtMode_Manual,
 		"Attempted to clear a block that is already under manual protection." );
 
-	HostSys::MemProtect( &eeMem->Main[rampage<<12], __pagesize, PageAccess_ReadWrite() );
 	m_PageProtectInfo[rampage].Mode = ProtMode_Manual;
+	mmap_ProtectRamPage( rampage );
 	Cpu->Clear( m_PageProtectInfo[rampage].ReverseRamMap, 0x400 );
 }
 
@@ -978,6 +989,12 @@ void mmap_PageFaultHandler::OnPageFaultEvent( const PageFaultInfo& info, bool& h
 {
 	pxAssert( eeMem );
 
+	if( MemoryWatch::HandlePageFault( info.addr, info.pc ) )
+	{
+		handled = true;
+		return;
+	}
+
 	// get bad virtual address
 	uptr offset = info.addr - (uptr)eeMem->Main;
 	if( offset >= Ps2MemSize::MainRam ) return;
@@ -14,13 +14,15 @@
  */
 
 #include "PrecompiledHeader.h"
-#include "common/SafeArray.inl"
 #include "common/StringUtil.h"
 #include <wx/file.h>
 #include <wx/dir.h>
 #include <wx/stopwatch.h>
 
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 struct Component_FileMcd;
 
@@ -154,18 +156,35 @@ static bool ConvertRAWtoNoECC(wxString file_in, wxString file_out)
 // --------------------------------------------------------------------------------------
 //  FileMemoryCard
 // --------------------------------------------------------------------------------------
-// Provides thread-safe direct file IO mapping.
+// Card images are loaded in memory when opened, reads and writes only touch that copy.
+// Written pages are flagged dirty and a background thread writes them back to the file,
+// merging adjacent pages into a single write, so saving never waits on the disk.
 //
 class FileMemoryCard
 {
 protected:
+	// Size of a page with its ECC, the unit in which dirty data is tracked.
+	static const u32 PageSize = 528;
+
+	// Delay between the first write and the flush, lets a whole save accumulate.
+	static const int FlushDelayMS = 500;
+
 	wxFFile m_file[8];
 	u8 m_effeffs[528 * 16];
-	SafeArray<u8> m_currentdata;
 	u64 m_chksum[8];
 	bool m_ispsx[8];
 	u32 m_chkaddr;
 
+	std::vector<u8> m_data[8];     // whole image of the card file
+	std::vector<bool> m_dirty[8];  // pages of m_data not yet written to the file
+	u32 m_offset[8];               // size of the header of some PSX card formats
+
+	std::thread m_flush_thread;
+	std::mutex m_flush_mutex; // protects m_data writes, m_dirty and m_flush_pending
+	std::condition_variable m_flush_cv;
+	u32 m_flush_pending; // dirty pages waiting for the flusher, across all slots
+	bool m_flush_exit;
+
 public:
 	FileMemoryCard();
 	virtual ~FileMemoryCard() = default;
@@ -185,7 +204,10 @@ public:
 	u64 GetCRC(uint slot);
 
 protected:
-	bool Seek(wxFFile& f, u32 adr);
+	u8* GetPtr(uint slot, u32 adr, u32 size);
+	void MarkDirty(uint slot, u32 pos, u32 size);
+	void FlushThread();
+	void FlushPending(std::unique_lock<std::mutex>& lock);
 	bool Create(const wxString& mcdFile, uint sizeInMB);
 
 	wxString GetDisabledMessage(uint slot) const
@@ -267,6 +289,8 @@ FileMemoryCard::FileMemoryCard()
 {
 	memset8<0xff>(m_effeffs);
 	m_chkaddr = 0;
+	m_flush_pending = 0;
+	m_flush_exit = false;
 }
 
 void FileMemoryCard::Open()
@@ -349,19 +373,66 @@ void FileMemoryCard::Open()
 				wxsFormat(_("Access denied to memory card: \n\n%s\n\n"), str.c_str()) +
 				GetDisabledMessage(slot));
 		}
-		else // Load checksum
+		else // Load the image and checksum
 		{
-			m_ispsx[slot] = m_file[slot].Length() == 0x20000;
+			const size_t size = m_file[slot].Length();
+
+			m_data[slot].resize(size);
+			m_dirty[slot].assign((size + PageSize - 1) / PageSize, false);
+
+			if (m_file[slot].Read(m_data[slot].data(), size) != size)
+			{
+				Msgbox::Alert(
+					wxsFormat(_("Could not read memory card: \n\n%s\n\n"), str.c_str()) +
+					GetDisabledMessage(slot));
+
+				m_file[slot].Close();
+				m_data[slot].clear();
+				continue;
+			}
+
+			// If anyone knows why this filesize logic is here (it appears to be related to legacy PSX
+			// cards, perhaps hacked support for some special emulator-specific memcard formats that
+			// had header info?), then please replace this comment with something useful.  Thanks!  -- air
+
+			if (size == MCD_SIZE + 64)
+				m_offset[slot] = 64;
+			else if (size == MCD_SIZE + 3904)
+				m_offset[slot] = 3904;
+			else
+				m_offset[slot] = 0;
+
+			m_ispsx[slot] = size == 0x20000;
 			m_chkaddr = 0x210;
 
-			if (!m_ispsx[slot] && !!m_file[slot].Seek(m_chkaddr))
-				m_file[slot].Read(&m_chksum[slot], 8);
+			if (!m_ispsx[slot] && GetPtr(slot, m_chkaddr, 8))
+				memcpy(&m_chksum[slot], GetPtr(slot, m_chkaddr, 8), 8);
 		}
 	}
+
+	m_flush_exit = false;
+	m_flush_thread = std::thread(&FileMemoryCard::FlushThread, this);
 }
 
 void FileMemoryCard::Close()
 {
+	if (m_flush_thread.joinable())
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_flush_mutex);
+			m_flush_exit = true;
+		}
+
+		m_flush_cv.notify_one();
+		m_flush_thread.join();
+	}
+
+	// The flusher may have exited while it was writing, with pages dirtied after its last copy.
+	{
+		std::unique_lock<std::mutex> lock(m_flush_mutex);
+		FlushPending(lock);
+	}
+
 	for (int slot = 0; slot < 8; ++slot)
 	{
 		if (m_file[slot].IsOpened())
@@ -380,30 +451,116 @@ void FileMemoryCard::Close()
 					wxRemoveFile(name);
 			}
 		}
+
+		m_data[slot].clear();
+		m_dirty[slot].clear();
 	}
 }
 
-// Returns FALSE if the seek failed (is outside the bounds of the file).
-bool FileMemoryCard::Seek(wxFFile& f, u32 adr)
+// Returns the image data at adr, or nullptr if [adr, adr + size) is outside of the card.
+u8* FileMemoryCard::GetPtr(uint slot, u32 adr, u32 size)
 {
-	const u32 size = f.Length();
+	const u64 pos = (u64)adr + m_offset[slot];
 
-	// If anyone knows why this filesize logic is here (it appears to be related to legacy PSX
-	// cards, perhaps hacked support for some special emulator-specific memcard formats that
-	// had header info?), then please replace this comment with something useful.  Thanks!  -- air
+	if (pos + size > m_data[slot].size())
+		return nullptr;
 
-	u32 offset = 0;
+	return &m_data[slot][pos];
+}
 
-	if (size == MCD_SIZE + 64)
-		offset = 64;
-	else if (size == MCD_SIZE + 3904)
-		offset = 3904;
-	else
+// Must be called with m_flush_mutex held.
+void FileMemoryCard::MarkDirty(uint slot, u32 adr, u32 size)
+{
+	const u32 pos = adr + m_offset[slot];
+	const u32 first = pos / PageSize;
+	const u32 last = (pos + size - 1) / PageSize;
+
+	for (u32 i = first; i <= last; i++)
 	{
-		// perform sanity checks here?
+		if (!m_dirty[slot][i])
+		{
+			m_dirty[slot][i] = true;
+			m_flush_pending++;
+		}
 	}
 
-	return f.Seek(adr + offset);
+	m_flush_cv.notify_one();
+}
+
+void FileMemoryCard::FlushThread()
+{
+	std::unique_lock<std::mutex> lock(m_flush_mutex);
+
+	while (!m_flush_exit)
+	{
+		m_flush_cv.wait(lock, [this] { return m_flush_exit || m_flush_pending > 0; });
+
+		if (!m_flush_exit)
+			m_flush_cv.wait_for(lock, std::chrono::milliseconds(FlushDelayMS), [this] { return m_flush_exit; });
+
+		FlushPending(lock);
+	}
+}
+
+// Copies the runs of dirty pages out of the images with the lock held, then writes them
+// with the lock released so the emulation thread can keep saving in the meantime.
+void FileMemoryCard::FlushPending(std::unique_lock<std::mutex>& lock)
+{
+	struct Run
+	{
+		uint slot;
+		u32 pos;
+		std::vector<u8> data;
+	};
+
+	std::vector<Run> runs;
+	const u32 pages = m_flush_pending;
+
+	for (uint slot = 0; slot < 8; ++slot)
+	{
+		std::vector<bool>& dirty = m_dirty[slot];
+
+		for (u32 i = 0; i < dirty.size(); i++)
+		{
+			if (!dirty[i])
+				continue;
+
+			u32 end = i;
+
+			while (end < dirty.size() && dirty[end])
+				dirty[end++] = false;
+
+			const u32 pos = i * PageSize;
+			const u32 size = std::min<u32>(end * PageSize, m_data[slot].size()) - pos;
+
+			runs.push_back({slot, pos, std::vector<u8>(&m_data[slot][pos], &m_data[slot][pos] + size)});
+
+			i = end;
+		}
+	}
+
+	m_flush_pending = 0;
+
+	if (runs.empty())
+		return;
+
+	lock.unlock();
+
+	for (const Run& run : runs)
+	{
+		wxFFile& f = m_file[run.slot];
+
+		if (!f.Seek(run.pos) || f.Write(run.data.data(), run.data.size()) != run.data.size())
+			Console.Error("(FileMcd) Failed to write %zu bytes at 0x%x to memory card in slot %u.", run.data.size(), run.pos, run.slot);
+	}
+
+	for (uint slot = 0; slot < 8; ++slot)
+		if (m_file[slot].IsOpened())
+			m_file[slot].Flush();
+
+	DevCon.WriteLn("(FileMcd) Flushed %u pages in %zu writes.", pages, runs.size());
+
+	lock.lock();
 }
 
 // returns FALSE if an error occurred (either permission denied or disk full)
@@ -437,7 +594,7 @@ void FileMemoryCard::GetSizeInfo(uint slot, McdSizeInfo& outways)
 	outways.Xor = 18;                     // 0x12, XOR 02 00 00 10
 
 	if (pxAssert(m_file[slot].IsOpened()))
-		outways.McdSizeInSectors = m_file[slot].Length() / (outways.SectorSize + outways.EraseBlockSizeInSectors);
+		outways.McdSizeInSectors = m_data[slot].size() / (outways.SectorSize + outways.EraseBlockSizeInSectors);
 	else
 		outways.McdSizeInSectors = 0x4000;
 
@@ -452,124 +609,115 @@ bool FileMemoryCard::IsPSX(uint slot)
 
 s32 FileMemoryCard::Read(uint slot, u8* dest, u32 adr, int size)
 {
-	wxFFile& mcfp(m_file[slot]);
-	if (!mcfp.IsOpened())
+	if (!m_file[slot].IsOpened())
 	{
 		DevCon.Error("(FileMcd) Ignoring attempted read from disabled slot.");
 		memset(dest, 0, size);
 		return 1;
 	}
-	if (!Seek(mcfp, adr))
+
+	const u8* src = GetPtr(slot, adr, size);
+	if (!src)
 		return 0;
-	return mcfp.Read(dest, size) != 0;
+
+	memcpy(dest, src, size);
+	return 1;
 }
 
 s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 {
-	wxFFile& mcfp(m_file[slot]);
-
-	if (!mcfp.IsOpened())
+	if (!m_file[slot].IsOpened())
 	{
 		DevCon.Error("(FileMcd) Ignoring attempted save/write to disabled slot.");
 		return 1;
 	}
 
-	if (m_ispsx[slot])
-	{
-		m_currentdata.MakeRoomFor(size);
-		for (int i = 0; i < size; i++)
-			m_currentdata[i] = src[i];
-	}
-	else
-	{
-		if (!Seek(mcfp, adr))
-			return 0;
-		m_currentdata.MakeRoomFor(size);
-		mcfp.Read(m_currentdata.GetPtr(), size);
+	u8* dest = GetPtr(slot, adr, size);
+	if (!dest)
+		return 0;
 
+	{
+		std::unique_lock<std::mutex> lock(m_flush_mutex);
 
-		for (int i = 0; i < size; i++)
+		if (m_ispsx[slot])
 		{
-			if ((m_currentdata[i] & src[i]) != src[i])
-				Console.Warning("(FileMcd) Warning: writing to uncleared data. (%d) [%08X]", slot, adr);
-			m_currentdata[i] &= src[i];
+			memcpy(dest, src, size);
 		}
-
-		// Checksumness
+		else
 		{
-			if (adr == m_chkaddr)
-				Console.Warning("(FileMcd) Warning: checksum sector overwritten. (%d)", slot);
+			for (int i = 0; i < size; i++)
+			{
+				if ((dest[i] & src[i]) != src[i])
+					Console.Warning("(FileMcd) Warning: writing to uncleared data. (%d) [%08X]", slot, adr);
+				dest[i] &= src[i];
+			}
 
-			u64* pdata = (u64*)&m_currentdata[0];
-			u32 loops = size / 8;
+			// Checksumness
+			{
+				if (adr == m_chkaddr)
+					Console.Warning("(FileMcd) Warning: checksum sector overwritten. (%d)", slot);
+
+				u64* pdata = (u64*)dest;
+				u32 loops = size / 8;
 
-			for (u32 i = 0; i < loops; i++)
-				m_chksum[slot] ^= pdata[i];
+				for (u32 i = 0; i < loops; i++)
+					m_chksum[slot] ^= pdata[i];
+			}
 		}
-	}
 
-	if (!Seek(mcfp, adr))
-		return 0;
+		MarkDirty(slot, adr, size);
+	}
 
-	int status = mcfp.Write(m_currentdata.GetPtr(), size);
+	static auto last = std::chrono::time_point<std::chrono::system_clock>();
 
-	if (status)
+	std::chrono::duration<float> elapsed = std::chrono::system_clock::now() - last;
+	if (elapsed > std::chrono::seconds(5))
 	{
-		static auto last = std::chrono::time_point<std::chrono::system_clock>();
-
-		std::chrono::duration<float> elapsed = std::chrono::system_clock::now() - last;
-		if (elapsed > std::chrono::seconds(5))
-		{
-			wxString name, ext;
-			wxFileName::SplitPath(m_file[slot].GetName(), NULL, NULL, &name, &ext);
-			OSDlog(Color_StrongYellow, true, "Memory Card %s written.", (const char*)(name + "." + ext).c_str());
-			last = std::chrono::system_clock::now();
-		}
-		return 1;
+		wxString name, ext;
+		wxFileName::SplitPath(m_file[slot].GetName(), NULL, NULL, &name, &ext);
+		OSDlog(Color_StrongYellow, true, "Memory Card %s written.", (const char*)(name + "." + ext).c_str());
+		last = std::chrono::system_clock::now();
 	}
 
-	return 0;
+	return 1;
 }
 
 s32 FileMemoryCard::EraseBlock(uint slot, u32 adr)
 {
-	wxFFile& mcfp(m_file[slot]);
-
-	if (!mcfp.IsOpened())
+	if (!m_file[slot].IsOpened())
 	{
 		DevCon.Error("MemoryCard: Ignoring erase for disabled slot.");
 		return 1;
 	}
 
-	if (!Seek(mcfp, adr))
+	u8* dest = GetPtr(slot, adr, sizeof(m_effeffs));
+	if (!dest)
 		return 0;
-	return mcfp.Write(m_effeffs, sizeof(m_effeffs)) != 0;
+
+	std::unique_lock<std::mutex> lock(m_flush_mutex);
+
+	memcpy(dest, m_effeffs, sizeof(m_effeffs));
+	MarkDirty(slot, adr, sizeof(m_effeffs));
+
+	return 1;
 }
 
 u64 FileMemoryCard::GetCRC(uint slot)
 {
-	wxFFile& mcfp(m_file[slot]);
-	if (!mcfp.IsOpened())
+	if (!m_file[slot].IsOpened())
 		return 0;
 
 	u64 retval = 0;
 
 	if (m_ispsx[slot])
 	{
-		if (!Seek(mcfp, 0))
-			return 0;
-
-		// Process the file in 4k chunks.  Speeds things up significantly.
+		// Only whole 4k chunks of the file size are hashed, as when this was read from the file.
+		const u32 chunk = 528 * 8 * sizeof(u64); // use 528 (sector size), ensures even divisibility
+		const u8* data = GetPtr(slot, 0, 0);
+		const size_t size = std::min<size_t>(m_data[slot].size() / chunk * chunk, m_data[slot].size() - m_offset[slot]);
 
-		u64 buffer[528 * 8]; // use 528 (sector size), ensures even divisibility
-
-		const uint filesize = mcfp.Length() / sizeof(buffer);
-		for (uint i = filesize; i; --i)
-		{
-			mcfp.Read(&buffer, sizeof(buffer));
-			for (uint t = 0; t < ArraySize(buffer); ++t)
-				retval ^= buffer[t];
-		}
+		for (size_t i = 0; i + sizeof(u64) <= size; i += sizeof(u64))
+			retval ^= *(const u64*)&data[i];
 	}
 	else
 	{
@@ -66,7 +66,71 @@ static void SaveYAMLToFile(const wxString& filename, const YAML::Node& node)
 	}
 }
 
+MemoryCardPageCache::MemoryCardPageCache(u32 pageCount)
+	: m_index(pageCount, NotCached)
+{
+}
+
+MemoryCardPage* MemoryCardPageCache::Find(u32 page)
+{
+	if (page >= m_index.size() || m_index[page] == NotCached)
+	{
+		return nullptr;
+	}
+
+	return &m_pages[m_index[page]];
+}
+
+MemoryCardPage* MemoryCardPageCache::Insert(u32 page)
+{
+	if (page >= m_index.size())
+	{
+		m_index.resize(page + 1, NotCached);
+	}
+
+	if (m_index[page] == NotCached)
+	{
+		m_index[page] = static_cast<u32>(m_pages.size());
+		m_pageNumbers.push_back(page);
+		m_pages.emplace_back();
+	}
+
+	return &m_pages[m_index[page]];
+}
+
+void MemoryCardPageCache::Erase(u32 page)
+{
+	if (page >= m_index.size() || m_index[page] == NotCached)
+	{
+		return;
+	}
+
+	// move the last page into the hole so the storage stays contiguous
+	const u32 pos = m_index[page];
+	const u32 lastPage = m_pageNumbers.back();
+	m_pages[pos] = m_pages.back();
+	m_pageNumbers[pos] = lastPage;
+	m_index[lastPage] = pos;
+	m_index[page] = NotCached;
+
+	m_pages.pop_back();
+	m_pageNumbers.pop_back();
+}
+
+void MemoryCardPageCache::Clear()
+{
+	for (const u32 page : m_pageNumbers)
+	{
+		m_index[page] = NotCached;
+	}
+
+	m_pageNumbers.clear();
+	m_pages.clear();
+}
+
 FolderMemoryCard::FolderMemoryCard()
+	: m_cache(TotalPages)
+	, m_oldDataCache(TotalPages)
 {
 	m_slot = 0;
 	m_isEnabled = false;
@@ -75,6 +139,13 @@ FolderMemoryCard::FolderMemoryCard()
 	m_timeLastWritten = 0;
 	m_filteringEnabled = false;
 	m_filteringString = L"";
+	m_flushRequested = false;
+	m_flushThreadExit = false;
+}
+
+FolderMemoryCard::~FolderMemoryCard()
+{
+	StopFlushThread();
 }
 
 void FolderMemoryCard::InitializeInternalData()
@@ -84,8 +155,8 @@ void FolderMemoryCard::InitializeInternalData()
 	memset(&m_fat, 0xFF, sizeof(m_fat));
 	memset(&m_backupBlock1, 0xFF, sizeof(m_backupBlock1));
 	memset(&m_backupBlock2, 0xFF, sizeof(m_backupBlock2));
-	m_cache.clear();
-	m_oldDataCache.clear();
+	m_cache.Clear();
+	m_oldDataCache.Clear();
 	m_lastAccessedFile.CloseAll();
 	m_fileMetadataQuickAccess.clear();
 	m_timeLastWritten = 0;
@@ -109,6 +180,7 @@ void FolderMemoryCard::Open(const bool enableFiltering, const wxString& filter)
 
 void FolderMemoryCard::Open(const wxString& fullPath, const Pcsx2Config::McdOptions& mcdOptions, const u32 sizeInClusters, const bool enableFiltering, const wxString& filter, bool simulateFileWrites)
 {
+	StopFlushThread();
 	InitializeInternalData();
 	m_performFileWrites = !simulateFileWrites;
 
@@ -157,6 +229,8 @@ void FolderMemoryCard::Open(const wxString& fullPath, const Pcsx2Config::McdOpti
 
 	SetTimeLastWrittenToNow();
 	m_framesUntilFlush = 0;
+
+	StartFlushThread();
 }
 
 void FolderMemoryCard::Close(bool flush)
@@ -166,13 +240,18 @@ void FolderMemoryCard::Close(bool flush)
 		return;
 	}
 
+	// finish a flush that may be in progress, the rest of the cache is flushed right here
+	StopFlushThread();
+
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	if (flush)
 	{
 		Flush();
 	}
 
-	m_cache.clear();
-	m_oldDataCache.clear();
+	m_cache.Clear();
+	m_oldDataCache.Clear();
 	m_lastAccessedFile.CloseAll();
 	m_fileMetadataQuickAccess.clear();
 }
@@ -922,6 +1001,8 @@ bool FolderMemoryCard::ReadFromFile(u8* dest, u32 adr, u32 dataLength)
 
 s32 FolderMemoryCard::Read(u8* dest, u32 adr, int size)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	//const u32 block = adr / BlockSizeRaw;
 	const u32 page = adr / PageSizeRaw;
 	const u32 offset = adr % PageSizeRaw;
@@ -943,10 +1024,10 @@ s32 FolderMemoryCard::Read(u8* dest, u32 adr, int size)
 		const u32 dataLength = std::min((u32)size, (u32)(PageSize - offset));
 
 		// if we have a cache for this page, just load from that
-		auto it = m_cache.find(page);
-		if (it != m_cache.end())
+		const MemoryCardPage* cachePage = m_cache.Find(page);
+		if (cachePage != nullptr)
 		{
-			memcpy(dest, &it->second.raw[offset], dataLength);
+			memcpy(dest, &cachePage->raw[offset], dataLength);
 		}
 		else
 		{
@@ -999,6 +1080,8 @@ void FolderMemoryCard::ReadDataWithoutCache(u8* const dest, const u32 adr, const
 
 s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	//const u32 block = adr / BlockSizeRaw;
 	//const u32 cluster = adr / ClusterSizeRaw;
 	const u32 page = adr / PageSizeRaw;
@@ -1020,18 +1103,13 @@ s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 		const u32 dataLength = std::min((u32)size, PageSize - offset);
 
 		// if cache page has not yet been touched, fill it with the data from our memory card
-		auto it = m_cache.find(page);
-		MemoryCardPage* cachePage;
-		if (it == m_cache.end())
+		MemoryCardPage* cachePage = m_cache.Find(page);
+		if (cachePage == nullptr)
 		{
-			cachePage = &m_cache[page];
+			cachePage = m_cache.Insert(page);
 			const u32 adrLoad = page * PageSizeRaw;
 			ReadDataWithoutCache(&cachePage->raw[0], adrLoad, PageSize);
-			memcpy(&m_oldDataCache[page].raw[0], &cachePage->raw[0], PageSize);
-		}
-		else
-		{
-			cachePage = &it->second;
+			memcpy(&m_oldDataCache.Insert(page)->raw[0], &cachePage->raw[0], PageSize);
 		}
 
 		// then just write to the cache
@@ -1047,13 +1125,118 @@ void FolderMemoryCard::NextFrame()
 {
 	if (m_framesUntilFlush > 0 && --m_framesUntilFlush == 0)
 	{
-		Flush();
+		if (m_flushThread.joinable())
+		{
+			std::lock_guard<std::mutex> lock(m_flushRequestMutex);
+			m_flushRequested = true;
+			m_flushRequestCv.notify_one();
+		}
+		else
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_mutex);
+			Flush();
+		}
+	}
+}
+
+void FolderMemoryCard::StartFlushThread()
+{
+	if (m_flushThread.joinable())
+	{
+		return;
+	}
+
+	m_flushRequested = false;
+	m_flushThreadExit = false;
+	m_flushThread = std::thread(&FolderMemoryCard::FlushThread, this);
+}
+
+void FolderMemoryCard::StopFlushThread()
+{
+	if (!m_flushThread.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_flushRequestMutex);
+		m_flushThreadExit = true;
+		m_flushRequestCv.notify_one();
+	}
+
+	m_flushThread.join();
+}
+
+void FolderMemoryCard::FlushThread()
+{
+	std::unique_lock<std::mutex> requestLock(m_flushRequestMutex);
+
+	while (true)
+	{
+		m_flushRequestCv.wait(requestLock, [this] { return m_flushRequested || m_flushThreadExit; });
+		if (m_flushThreadExit)
+		{
+			return;
+		}
+
+		m_flushRequested = false;
+		requestLock.unlock();
+
+		// the emulation thread waits for this only if it accesses the card while the flush is running
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_mutex);
+			Flush();
+		}
+
+		requestLock.lock();
+	}
+}
+
+bool FolderMemoryCard::IsFileSystemStructureCached() const
+{
+	const u32 alloc_offset = m_superBlock.data.alloc_offset;
+
+	for (size_t i = 0; i < m_cache.Size(); ++i)
+	{
+		const u32 cluster = m_cache.GetPageNumber(i) / 2;
+
+		// superblock, indirect FAT and FAT are all stored before the first data cluster
+		if (cluster < alloc_offset)
+		{
+			return true;
+		}
+
+		if (m_fileEntryDict.find(cluster - alloc_offset) != m_fileEntryDict.end())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FolderMemoryCard::RemoveUnchangedPagesFromCache()
+{
+	for (size_t i = 0; i < m_cache.Size();)
+	{
+		const u32 page = m_cache.GetPageNumber(i);
+		const MemoryCardPage* oldPage = m_oldDataCache.Find(page);
+
+		// Erase() moves the last page to position i, so only advance if nothing was removed
+		if (oldPage != nullptr && memcmp(&oldPage->raw[0], &m_cache.Find(page)->raw[0], PageSize) == 0)
+		{
+			m_cache.Erase(page);
+		}
+		else
+		{
+			++i;
+		}
 	}
 }
 
 void FolderMemoryCard::Flush()
 {
-	if (m_cache.empty())
+	if (m_cache.Empty())
 	{
 		return;
 	}
@@ -1065,9 +1248,13 @@ void FolderMemoryCard::Flush()
 	Console.WriteLn(L"(FolderMcd) Writing data for slot %u to file system...", m_slot);
 	const u64 timeFlushStart = wxGetLocalTimeMillis().GetValue();
 
+	// If only file data was written, the directory tree is still the one built by the last flush
+	// and doesn't have to be walked and compared again.
+	const bool fileSystemStructureChanged = !IsFormatted() || IsFileSystemStructureCached();
+
 	// Keep a copy of the old file entries so we can figure out which files and directories, if any, have been deleted from the memory card.
 	std::vector<MemoryCardFileEntryTreeNode> oldFileEntryTree;
-	if (IsFormatted())
+	if (fileSystemStructureChanged && IsFormatted())
 	{
 		CopyEntryDictIntoTree(&oldFileEntryTree, m_superBlock.data.rootdir_cluster, m_fileEntryDict[m_superBlock.data.rootdir_cluster].entries[0].entry.data.length);
 	}
@@ -1114,11 +1301,19 @@ void FolderMemoryCard::Flush()
 		}
 	}
 
-	// then all directory and file entries
-	FlushFileEntries();
+	if (fileSystemStructureChanged)
+	{
+		// then all directory and file entries
+		FlushFileEntries();
 
-	// Now we have the new file system, compare it to the old one and "delete" any files that were in it before but aren't anymore.
-	FlushDeletedFilesAndRemoveUnchangedDataFromCache(oldFileEntryTree);
+		// Now we have the new file system, compare it to the old one and "delete" any files that were in it before but aren't anymore.
+		FlushDeletedFilesAndRemoveUnchangedDataFromCache(oldFileEntryTree);
+	}
+	else
+	{
+		// no file can have been added, moved or deleted, so any page that still holds its old contents is unchanged file data
+		RemoveUnchangedPagesFromCache();
+	}
 
 	// and finally, flush everything that hasn't been flushed yet
 	for (uint i = 0; i < pageCount; ++i)
@@ -1128,7 +1323,7 @@ void FolderMemoryCard::Flush()
 
 	m_lastAccessedFile.FlushAll();
 	m_lastAccessedFile.ClearMetadataWriteState();
-	m_oldDataCache.clear();
+	m_oldDataCache.Clear();
 
 	const u64 timeFlushEnd = wxGetLocalTimeMillis().GetValue();
 	Console.WriteLn(L"(FolderMcd) Done! Took %u ms.", timeFlushEnd - timeFlushStart);
@@ -1140,11 +1335,11 @@ void FolderMemoryCard::Flush()
 
 bool FolderMemoryCard::FlushPage(const u32 page)
 {
-	auto it = m_cache.find(page);
-	if (it != m_cache.end())
+	const MemoryCardPage* cachePage = m_cache.Find(page);
+	if (cachePage != nullptr)
 	{
-		WriteWithoutCache(&it->second.raw[0], page * PageSizeRaw, PageSize);
-		m_cache.erase(it);
+		WriteWithoutCache(&cachePage->raw[0], page * PageSizeRaw, PageSize);
+		m_cache.Erase(page);
 		return true;
 	}
 	return false;
@@ -1386,20 +1581,20 @@ void FolderMemoryCard::RemoveUnchangedDataFromCache(const MemoryCardFileEntry* c
 		for (int i = 0; i < 2; ++i)
 		{
 			const u32 page = (cluster + alloc_offset) * 2 + i;
-			auto newIt = m_cache.find(page);
-			if (newIt == m_cache.end())
+			const MemoryCardPage* newPage = m_cache.Find(page);
+			if (newPage == nullptr)
 			{
 				continue;
 			}
-			auto oldIt = m_oldDataCache.find(page);
-			if (oldIt == m_oldDataCache.end())
+			const MemoryCardPage* oldPage = m_oldDataCache.Find(page);
+			if (oldPage == nullptr)
 			{
 				continue;
 			}
 
-			if (memcmp(&oldIt->second.raw[0], &newIt->second.raw[0], PageSize) == 0)
+			if (memcmp(&oldPage->raw[0], &newPage->raw[0], PageSize) == 0)
 			{
-				m_cache.erase(newIt);
+				m_cache.Erase(page);
 			}
 		}
 
@@ -1580,6 +1775,8 @@ const MemoryCardFileEntry* FolderMemoryCard::FindEquivalent(const MemoryCardFile
 
 s32 FolderMemoryCard::EraseBlock(u32 adr)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	const u32 block = adr / BlockSizeRaw;
 
 	u8 eraseData[PageSize];
@@ -1622,6 +1819,8 @@ u32 FolderMemoryCard::GetSizeInClusters() const
 
 void FolderMemoryCard::SetSizeInClusters(u32 clusters)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
 	superBlockUnion newSuperBlock;
 	memcpy(&newSuperBlock.raw[0], &m_superBlock.raw[0], sizeof(newSuperBlock.raw));
 
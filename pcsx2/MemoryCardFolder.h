@@ -18,7 +18,10 @@
 #include <wx/file.h>
 #include <wx/dir.h>
 #include <wx/ffile.h>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "Config.h"
@@ -204,6 +207,38 @@ struct MemoryCardPage
 };
 #pragma pack(pop)
 
+// --------------------------------------------------------------------------------------
+//  MemoryCardPageCache
+// --------------------------------------------------------------------------------------
+// Copies of memory card pages, found through a flat table indexed by page number.
+// The pages themselves are stored back to back, so a cache with few pages stays small.
+class MemoryCardPageCache
+{
+private:
+	static const u32 NotCached = 0xFFFFFFFFu;
+
+	// position of each page in m_pages, or NotCached
+	std::vector<u32> m_index;
+	// page number of each element of m_pages
+	std::vector<u32> m_pageNumbers;
+	std::vector<MemoryCardPage> m_pages;
+
+public:
+	explicit MemoryCardPageCache(u32 pageCount);
+
+	bool Empty() const { return m_pages.empty(); }
+	size_t Size() const { return m_pages.size(); }
+	u32 GetPageNumber(size_t i) const { return m_pageNumbers[i]; }
+
+	// returns the cached copy of page, or nullptr if there is none
+	MemoryCardPage* Find(u32 page);
+	// returns the cached copy of page, adding an uninitialized one if there is none
+	// pointers returned by Find() and Insert() are only valid until the next Insert() or Erase()
+	MemoryCardPage* Insert(u32 page);
+	void Erase(u32 page);
+	void Clear();
+};
+
 struct MemoryCardFileEntryTreeNode
 {
 	MemoryCardFileEntry entry;
@@ -340,14 +375,23 @@ protected:
 	std::map<u32, MemoryCardFileMetadataReference> m_fileMetadataQuickAccess;
 
 	// holds a copy of modified pages of the memory card before they're flushed to the file system
-	std::map<u32, MemoryCardPage> m_cache;
+	MemoryCardPageCache m_cache;
 	// contains the state of how the data looked before the first write to it
 	// used to reduce the amount of disk I/O by not re-writing unchanged data that just happened to be
 	// touched in memory due to how actual physical memory cards have to erase and rewrite in blocks
-	std::map<u32, MemoryCardPage> m_oldDataCache;
+	MemoryCardPageCache m_oldDataCache;
 	// if > 0, the amount of frames until data is flushed to the file system
 	// reset to FramesAfterWriteUntilFlush on each write
 	int m_framesUntilFlush;
+
+	// held while accessing the card, by the emulation thread and by the flush thread while flushing
+	std::recursive_mutex m_mutex;
+	// flushes the card in the background when requested by NextFrame()
+	std::thread m_flushThread;
+	std::mutex m_flushRequestMutex;
+	std::condition_variable m_flushRequestCv;
+	bool m_flushRequested;
+	bool m_flushThreadExit;
 	// used to figure out if contents were changed for savestate-related purposes, see GetCRC()
 	u64 m_timeLastWritten;
 
@@ -371,7 +415,7 @@ protected:
 
 public:
 	FolderMemoryCard();
-	virtual ~FolderMemoryCard() = default;
+	virtual ~FolderMemoryCard();
 
 	void Lock();
 	void Unlock();
@@ -407,6 +451,7 @@ public:
 	void SetSizeInMB(u32 megaBytes);
 
 	// called once per frame, used for flushing data after FramesAfterWriteUntilFlush frames of no writes
+	// the flush itself happens on a separate thread, so this never waits for the file system
 	void NextFrame();
 
 	static void CalculateECC(u8* ecc, const u8* data);
@@ -531,6 +576,18 @@ protected:
 	// flush the whole cache to the internal data and/or host file system
 	void Flush();
 
+	// starts and stops the thread that runs Flush() when requested by NextFrame()
+	void StartFlushThread();
+	void StopFlushThread();
+	void FlushThread();
+
+	// returns true if any page of the system area or of a directory is cached, meaning the
+	// file entries may have changed and have to be re-read and compared with the old ones
+	bool IsFileSystemStructureCached() const;
+
+	// remove every page from m_cache that is identical to its state before the first write to it
+	void RemoveUnchangedPagesFromCache();
+
 	// flush a single page of the cache to the internal data and/or host file system
 	bool FlushPage(const u32 page);
 
@@ -47,6 +47,7 @@ void TraceLogFilters::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapSection("EmuCore/TraceLog");
 
 	SettingsWrapEntry(Enabled);
+	SettingsWrapEntry(Binary);
 
 	// Retaining backwards compat of the trace log enablers isn't really important, and
 	// doing each one by hand would be murder.  So let's cheat and just save it as an int:
@@ -255,6 +256,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapEntry(LimitScalar);
 	SettingsWrapEntry(FramerateNTSC);
 	SettingsWrapEntry(FrameratePAL);
+	SettingsWrapEntry(FrameLimitMaxSpinUs);
 
 	SettingsWrapEntry(FramesToDraw);
 	SettingsWrapEntry(FramesToSkip);
@@ -535,6 +537,30 @@ void Pcsx2Config::FramerateOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapEntry(SkipOnTurbo);
 }
 
+void Pcsx2Config::ThreadPlacementOptions::LoadSave(SettingsWrapper& wrap)
+{
+	SettingsWrapSection("EmuCore/ThreadPlacement");
+
+	static const char* const tbl_PinPolicyNames[] = {"None", "CacheDomain", "PhysicalCore", nullptr};
+
+	wrap.EnumEntry(CURRENT_SETTINGS_SECTION, "EECore", EECore, tbl_PinPolicyNames, EECore);
+	wrap.EnumEntry(CURRENT_SETTINGS_SECTION, "MTGS", MTGS, tbl_PinPolicyNames, MTGS);
+	wrap.EnumEntry(CURRENT_SETTINGS_SECTION, "MTVU", MTVU, tbl_PinPolicyNames, MTVU);
+	wrap.EnumEntry(CURRENT_SETTINGS_SECTION, "GSWorker", GSWorker, tbl_PinPolicyNames, GSWorker);
+	wrap.EnumEntry(CURRENT_SETTINGS_SECTION, "IOReader", IOReader, tbl_PinPolicyNames, IOReader);
+	wrap.EnumEntry(CURRENT_SETTINGS_SECTION, "DEV9Rx", DEV9Rx, tbl_PinPolicyNames, DEV9Rx);
+}
+
+void Pcsx2Config::ThreadPlacementOptions::Apply() const
+{
+	Threading::SetThreadPinPolicy(Threading::ThreadRole::EECore, EECore);
+	Threading::SetThreadPinPolicy(Threading::ThreadRole::MTGS, MTGS);
+	Threading::SetThreadPinPolicy(Threading::ThreadRole::MTVU, MTVU);
+	Threading::SetThreadPinPolicy(Threading::ThreadRole::GSWorker, GSWorker);
+	Threading::SetThreadPinPolicy(Threading::ThreadRole::IOReader, IOReader);
+	Threading::SetThreadPinPolicy(Threading::ThreadRole::DEV9Rx, DEV9Rx);
+}
+
 Pcsx2Config::Pcsx2Config()
 {
 	bitset = 0;
@@ -591,6 +617,7 @@ void Pcsx2Config::LoadSave(SettingsWrapper& wrap)
 	GS.LoadSave(wrap);
 	Gamefixes.LoadSave(wrap);
 	Profiler.LoadSave(wrap);
+	ThreadPlacement.LoadSave(wrap);
 
 	Debugger.LoadSave(wrap);
 	Trace.LoadSave(wrap);
@@ -665,6 +692,7 @@ bool Pcsx2Config::operator==(const Pcsx2Config& right) const
 		OpEqu(Profiler) &&
 		OpEqu(Debugger) &&
 		OpEqu(Framerate) &&
+		OpEqu(ThreadPlacement) &&
 		OpEqu(Trace) &&
 		OpEqu(BaseFilenames) &&
 		OpEqu(GzipIsoIndexTemplate);
@@ -688,6 +716,7 @@ void Pcsx2Config::CopyConfig(const Pcsx2Config& cfg)
 	Trace = cfg.Trace;
 	BaseFilenames = cfg.BaseFilenames;
 	Framerate = cfg.Framerate;
+	ThreadPlacement = cfg.ThreadPlacement;
 	for (u32 i = 0; i < sizeof(Mcd) / sizeof(Mcd[0]); i++)
 	{
 		// Type will be File here, even if it's a folder, so we preserve the old value.
@@ -20,6 +20,7 @@
 #include "Sio.h"
 #include "Sif.h"
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/MemoryWatch.h"
 #include "R5900OpcodeTables.h"
 
 using namespace R3000A;
@@ -278,7 +279,7 @@ int psxIsBreakpointNeeded(u32 addr)
 
 int psxIsMemcheckNeeded(u32 pc)
 {
-	if (CBreakPoints::GetNumMemchecks() == 0)
+	if (CBreakPoints::GetNumMemchecks() == 0 || !MemoryWatch::NeedsInlineChecks(BREAKPOINT_IOP, pc))
 		return 0;
 
 	u32 addr = pc;
@@ -23,6 +23,7 @@
 #include "ps2/pgif.h" // pgif init
 #include "VUmicro.h"
 #include "COP0.h"
+#include "Cache.h"
 #include "MTVU.h"
 
 #include "System/SysThreads.h"
@@ -38,6 +39,7 @@
 #include "GameDatabase.h"
 
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/MemoryWatch.h"
 #include "R5900OpcodeTables.h"
 
 using namespace R5900;	// for R5900 disasm tools
@@ -71,6 +73,15 @@ uptr g_argPtrs[kMaxArgs];
 
 extern SysMainMemory& GetVmMemory();
 
+// Boot timing, from the cpu reset to the first vsync after the game's entry point.
+static u64 s_BootStartTicks = 0;
+static bool s_BootFramePending = false;
+
+static u32 GetBootMilliseconds()
+{
+	return static_cast<u32>((GetCPUTicks() - s_BootStartTicks) * 1000 / GetTickFrequency());
+}
+
 void cpuReset()
 {
 	vu1Thread.WaitVU();
@@ -82,6 +93,8 @@ void cpuReset()
 	memzero(cpuRegs);
 	memzero(fpuRegs);
 	memzero(tlb);
+	resetCache();
+	updateCachedPages();
 
 	cpuRegs.pc				= 0xbfc00000; //set pc reg to stack
 	cpuRegs.CP0.n.Config	= 0x440;
@@ -121,6 +134,9 @@ void cpuReset()
 	LastELF = L"";
 
 	g_eeloadMain = 0, g_eeloadExec = 0, g_osdsys_str = 0;
+
+	s_BootStartTicks = GetCPUTicks();
+	s_BootFramePending = false;
 }
 
 void cpuShutdown()
@@ -547,6 +563,8 @@ void __fastcall eeGameStarting()
 		//Console.WriteLn( Color_Green, "(R5900) ELF Entry point! [addr=0x%08X]", ElfEntry );
 		g_GameStarted = true;
 		g_GameLoading = false;
+		s_BootFramePending = true;
+		Console.WriteLn(Color_StrongGreen, "(Boot) ELF entry point reached %u ms after reset", GetBootMilliseconds());
 		GetCoreThread().GameStartingInThread();
 
 		// GameStartingInThread may issue a reset of the cpu and/or recompilers.  Check for and
@@ -559,6 +577,15 @@ void __fastcall eeGameStarting()
 	}
 }
 
+void eeBootFrame()
+{
+	if (!s_BootFramePending)
+		return;
+
+	s_BootFramePending = false;
+	Console.WriteLn(Color_StrongGreen, "(Boot) First game frame %u ms after reset", GetBootMilliseconds());
+}
+
 // Count arguments, save their starting locations, and replace the space separators with null terminators so they're separate strings
 int ParseArgumentString(u32 arg_block)
 {
@@ -795,7 +822,7 @@ int isBreakpointNeeded(u32 addr)
 
 int isMemcheckNeeded(u32 pc)
 {
-	if (CBreakPoints::GetNumMemchecks() == 0)
+	if (CBreakPoints::GetNumMemchecks() == 0 || !MemoryWatch::NeedsInlineChecks(BREAKPOINT_EE, pc))
 		return 0;
 	
 	u32 addr = pc;
@@ -276,6 +276,7 @@ const u32 EELOAD_SIZE		= 0x20000; // overestimate for searching
 extern u32 g_eeloadMain, g_eeloadExec;
 
 extern void __fastcall eeGameStarting();
+extern void eeBootFrame();
 extern void __fastcall eeloadHook();
 extern void __fastcall eeloadHook2();
 
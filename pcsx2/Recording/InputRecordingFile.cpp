@@ -60,12 +60,48 @@ bool InputRecordingFile::Close()
 	{
 		return false;
 	}
+	if (!Flush())
+		inputRec::consoleLog("Failed to write the last input data to the recording file");
 	fclose(recordingFile);
 	recordingFile = nullptr;
 	filename = "";
+	clearFrameData();
 	return true;
 }
 
+bool InputRecordingFile::Flush()
+{
+	if (recordingFile == nullptr)
+	{
+		return false;
+	}
+
+	framesSinceFlush = 0;
+	if (dirtyBegin < dirtyEnd)
+	{
+		if (fseek(recordingFile, getRecordingBlockSeekPoint(0) + dirtyBegin, SEEK_SET) != 0
+			|| fwrite(&frameData[dirtyBegin], dirtyEnd - dirtyBegin, 1, recordingFile) != 1)
+		{
+			return false;
+		}
+		dirtyBegin = dirtyEnd = 0;
+	}
+
+	// Total frames and undo count sit next to each other
+	if (countersDirty)
+	{
+		if (fseek(recordingFile, seekpointTotalFrames, SEEK_SET) != 0
+			|| fwrite(&totalFrames, 4, 1, recordingFile) != 1
+			|| fwrite(&undoCount, 4, 1, recordingFile) != 1)
+		{
+			return false;
+		}
+		countersDirty = false;
+	}
+
+	return fflush(recordingFile) == 0;
+}
+
 const wxString &InputRecordingFile::GetFilename()
 {
 	return filename;
@@ -94,12 +130,7 @@ bool InputRecordingFile::FromSaveState()
 void InputRecordingFile::IncrementUndoCount()
 {
 	undoCount++;
-	if (recordingFile == nullptr)
-	{
-		return;
-	}
-	fseek(recordingFile, seekpointUndoCount, SEEK_SET);
-	fwrite(&undoCount, 4, 1, recordingFile);
+	countersDirty = true;
 }
 
 bool InputRecordingFile::open(const wxString path, bool newRecording)
@@ -111,13 +142,14 @@ bool InputRecordingFile::open(const wxString path, bool newRecording)
 			filename = path;
 			totalFrames = 0;
 			undoCount = 0;
+			clearFrameData();
 			header.Init();
 			return true;
 		}
 	}
 	else if ((recordingFile = wxFopen(path, L"rb+")) != nullptr)
 	{
-		if (verifyRecordingFileHeader())
+		if (verifyRecordingFileHeader() && readFrameData())
 		{
 			filename = path;
 			return true;
@@ -150,12 +182,13 @@ bool InputRecordingFile::ReadKeyBuffer(u8 &result, const uint &frame, const uint
 		return false;
 	}
 
-	long seek = getRecordingBlockSeekPoint(frame) + controllerInputBytes * port + bufIndex;
-	if (fseek(recordingFile, seek, SEEK_SET) != 0 || fread(&result, 1, 1, recordingFile) != 1)
+	const size_t offset = static_cast<size_t>(frame) * inputBytesPerFrame + controllerInputBytes * port + bufIndex;
+	if (offset >= frameData.size())
 	{
 		return false;
 	}
 
+	result = frameData[offset];
 	return true;
 }
 
@@ -166,8 +199,7 @@ void InputRecordingFile::SetTotalFrames(long frame)
 		return;
 	}
 	totalFrames = frame;
-	fseek(recordingFile, seekpointTotalFrames, SEEK_SET);
-	fwrite(&totalFrames, 4, 1, recordingFile);
+	countersDirty = true;
 }
 
 bool InputRecordingFile::WriteHeader()
@@ -184,7 +216,8 @@ bool InputRecordingFile::WriteHeader()
 	{
 		return false;
 	}
-	return true;
+	countersDirty = false;
+	return Flush();
 }
 
 bool InputRecordingFile::WriteKeyBuffer(const uint &frame, const uint port, const uint bufIndex, const u8 &buf)
@@ -194,14 +227,34 @@ bool InputRecordingFile::WriteKeyBuffer(const uint &frame, const uint port, cons
 		return false;
 	}
 
-	long seek = getRecordingBlockSeekPoint(frame) + 18 * port + bufIndex;
+	// Flushing between frames keeps a crash from losing more than about a second of input
+	if (static_cast<long>(frame) != lastWrittenFrame)
+	{
+		lastWrittenFrame = frame;
+		if (++framesSinceFlush >= flushFrameInterval && !Flush())
+		{
+			return false;
+		}
+	}
 
-	if (fseek(recordingFile, seek, SEEK_SET) != 0 || fwrite(&buf, 1, 1, recordingFile) != 1)
+	const size_t offset = static_cast<size_t>(frame) * inputBytesPerFrame + controllerInputBytes * port + bufIndex;
+	if (offset >= frameData.size())
 	{
-		return false;
+		// Grows a frame at a time, skipped frames are zero like they would be in the file
+		frameData.resize((static_cast<size_t>(frame) + 1) * inputBytesPerFrame, 0);
 	}
 
-	fflush(recordingFile);
+	frameData[offset] = buf;
+	if (dirtyBegin == dirtyEnd)
+	{
+		dirtyBegin = offset;
+		dirtyEnd = offset + 1;
+	}
+	else
+	{
+		dirtyBegin = std::min(dirtyBegin, offset);
+		dirtyEnd = std::max(dirtyEnd, offset + 1);
+	}
 	return true;
 }
 
@@ -210,6 +263,41 @@ long InputRecordingFile::getRecordingBlockSeekPoint(const long &frame)
 	return headerSize + sizeof(bool) + frame * inputBytesPerFrame;
 }
 
+void InputRecordingFile::clearFrameData()
+{
+	frameData.clear();
+	frameData.shrink_to_fit();
+	dirtyBegin = dirtyEnd = 0;
+	countersDirty = false;
+	lastWrittenFrame = -1;
+	framesSinceFlush = 0;
+}
+
+bool InputRecordingFile::readFrameData()
+{
+	clearFrameData();
+
+	const long dataStart = getRecordingBlockSeekPoint(0);
+	if (fseek(recordingFile, 0, SEEK_END) != 0)
+	{
+		return false;
+	}
+
+	const long fileSize = ftell(recordingFile);
+	if (fileSize < dataStart || fseek(recordingFile, dataStart, SEEK_SET) != 0)
+	{
+		return false;
+	}
+
+	frameData.resize(fileSize - dataStart);
+	if (!frameData.empty() && fread(frameData.data(), frameData.size(), 1, recordingFile) != 1)
+	{
+		frameData.clear();
+		return false;
+	}
+	return true;
+}
+
 bool InputRecordingFile::verifyRecordingFileHeader()
 {
 	if (recordingFile == nullptr)
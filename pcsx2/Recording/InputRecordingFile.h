@@ -21,6 +21,8 @@
 
 #include "PadData.h"
 
+#include <vector>
+
 // NOTE / TODOs for Version 2
 // - Move fromSavestate, undoCount, and total frames into the header
 
@@ -47,6 +49,10 @@ struct InputRecordingSavestate
 };
 
 // Handles all operations on the input recording file
+//
+// The input data of every frame is kept in memory while the recording is open, so reading
+// and rewriting frames never touches the file.  What changed is written back in one go by
+// Flush, which happens every flushFrameInterval recorded frames and when the file is closed.
 class InputRecordingFile
 {
 public:
@@ -55,6 +61,8 @@ public:
 	// Closes the underlying input recording file, writing the header and 
 	// prepares for a possible new recording to be started
 	bool Close();
+	// Writes the input data and counters which changed since the last flush to the file
+	bool Flush();
 	// Retrieve the input recording's filename (not the path)
 	const wxString &GetFilename();
 	// Retrieve the input recording's header which contains high-level metadata on the recording
@@ -95,6 +103,8 @@ private:
 	static const int seekpointTotalFrames = sizeof(InputRecordingFileHeader);
 	static const int seekpointUndoCount = sizeof(InputRecordingFileHeader) + 4;
 	static const int seekpointSaveStateHeader = seekpointUndoCount + 4;
+	// Number of newly written frames between flushes, about a second of gameplay
+	static const int flushFrameInterval = 60;
 
 	InputRecordingFileHeader header;
 	wxString filename = "";
@@ -105,9 +115,20 @@ private:
 	long totalFrames = 0;
 	unsigned long undoCount = 0;
 
+	// Everything after the header, frame after frame
+	std::vector<u8> frameData;
+	// Range of frameData which changed since the last flush
+	size_t dirtyBegin = 0;
+	size_t dirtyEnd = 0;
+	bool countersDirty = false;
+	long lastWrittenFrame = -1;
+	int framesSinceFlush = 0;
+
 	// Calculates the position of the current frame in the input recording
 	long getRecordingBlockSeekPoint(const long& frame);
 	bool open(const wxString path, bool newRecording);
+	void clearFrameData();
+	bool readFrameData();
 	bool verifyRecordingFileHeader();
 };
 
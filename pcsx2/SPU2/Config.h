@@ -82,6 +82,9 @@ extern int dplLevel;
 extern u32 OutputModule;
 extern int SndOutLatencyMS;
 extern int SynchMode;
+extern int MixBatchTicks;
+// TimeUpdate drops anything beyond 4800 ticks, keep deferred batches well below that.
+static const int MIXBATCH_MAX = 2400;
 
 #ifndef __POSIX__
 extern wchar_t dspPlugin[];
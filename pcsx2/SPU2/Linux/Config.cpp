@@ -64,6 +64,7 @@ bool _visual_debug_enabled = false; // Windows-only feature
 u32 OutputModule = 0;
 int SndOutLatencyMS = 100;
 int SynchMode = 0; // Time Stretch, Async or Disabled.
+int MixBatchTicks = 0; // Deferred mixing batch size in 48khz ticks, 0 to mix every 12 ticks.
 #ifdef SPU2X_PORTAUDIO
 u32 OutputAPI = 0;
 #endif
@@ -145,6 +146,7 @@ void ReadSettings()
 
 	SndOutLatencyMS = CfgReadInt(L"OUTPUT", L"Latency", 100);
 	SynchMode = CfgReadInt(L"OUTPUT", L"Synch_Mode", 0);
+	MixBatchTicks = CfgReadInt(L"OUTPUT", L"MixBatchTicks", 0);
 	numSpeakers = CfgReadInt(L"OUTPUT", L"SpeakerConfiguration", 0);
 
 #ifdef SPU2X_PORTAUDIO
@@ -160,6 +162,7 @@ void ReadSettings()
 	// -------------
 
 	Clampify(SndOutLatencyMS, LATENCY_MIN, LATENCY_MAX);
+	Clampify(MixBatchTicks, 0, MIXBATCH_MAX);
 
 	if (mods[OutputModule] == nullptr)
 	{
@@ -198,6 +201,7 @@ void WriteSettings()
 	CfgWriteStr(L"OUTPUT", L"Output_Module", mods[OutputModule]->GetIdent());
 	CfgWriteInt(L"OUTPUT", L"Latency", SndOutLatencyMS);
 	CfgWriteInt(L"OUTPUT", L"Synch_Mode", SynchMode);
+	CfgWriteInt(L"OUTPUT", L"MixBatchTicks", MixBatchTicks);
 	CfgWriteInt(L"OUTPUT", L"SpeakerConfiguration", numSpeakers);
 
 #ifdef SPU2X_PORTAUDIO
@@ -77,6 +77,7 @@ extern int dspPluginModule;
 
 extern bool dspPluginEnabled;
 extern int SynchMode;
+extern int MixBatchTicks;
 
 #ifdef SPU2X_PORTAUDIO
 extern u32 OutputAPI;
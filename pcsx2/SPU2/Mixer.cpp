@@ -19,6 +19,7 @@
 void ADMAOutLogWrite(void* lpData, u32 ulSize);
 
 #include "interpolate_table.h"
+#include "VoiceMixLanes.h"
 
 static const s32 tbl_XA_Factor[16][2] =
 	{
@@ -29,24 +30,6 @@ static const s32 tbl_XA_Factor[16][2] =
 		{122, -60}};
 
 
-// Performs a 64-bit multiplication between two values and returns the
-// high 32 bits as a result (discarding the fractional 32 bits).
-// The combined fractional bits of both inputs must be 32 bits for this
-// to work properly.
-//
-// This is meant to be a drop-in replacement for times when the 'div' part
-// of a MulDiv is a constant.  (example: 1<<8, or 4096, etc)
-//
-// [Air] Performance breakdown: This is over 10 times faster than MulDiv in
-//   a *worst case* scenario.  It's also more accurate since it forces the
-//   caller to  extend the inputs so that they make use of all 32 bits of
-//   precision.
-//
-static __forceinline s32 MulShr32(s32 srcval, s32 mulval)
-{
-	return (s64)srcval * mulval >> 32;
-}
-
 __forceinline s32 clamp_mix(s32 x, u8 bitshift)
 {
 	assert(bitshift <= 15);
@@ -132,9 +115,7 @@ static void __forceinline IncrementNextA(V_Core& thiscore, uint voiceidx)
 // invalided when DMA transfers and memory writes are performed.
 PcmCacheEntry* pcm_cache_data = nullptr;
 
-int g_counter_cache_hits = 0;
-int g_counter_cache_misses = 0;
-int g_counter_cache_ignores = 0;
+PcmCacheStats pcm_cache_stats = {};
 
 // LOOP/END sets the ENDX bit and sets NAX to LSA, and the voice is muted if LOOP is not set
 // LOOP seems to only have any effect on the block with LOOP/END set, where it prevents muting the voice
@@ -145,6 +126,65 @@ int g_counter_cache_ignores = 0;
 #define XAFLAG_LOOP (1ul << 1)
 #define XAFLAG_LOOP_START (1ul << 2)
 
+void InvalidatePcmCache(u32 start, u32 end)
+{
+	start = std::max<u32>(start, SPU2_DYN_MEMLINE);
+	end = std::min<u32>(end, 0x100000);
+
+	for (u32 i = start / pcm_WordsPerBlock; i < (end + pcm_WordsPerBlock - 1) / pcm_WordsPerBlock; i++)
+	{
+		if (pcm_cache_data[i].Validated)
+		{
+			pcm_cache_data[i].Validated = false;
+			pcm_cache_stats.Invalidations++;
+		}
+	}
+}
+
+// A voice reads its samples straight from the cache entry of its current block, which must
+// not change under it.
+static __forceinline bool IsPcmBlockInUse(const PcmCacheEntry& line)
+{
+	for (int c = 0; c < 2; c++)
+		for (uint v = 0; v < V_Core::NumVoices; v++)
+			if (Cores[c].Voices[v].SBuffer == line.Sampledata)
+				return true;
+
+	return false;
+}
+
+// Decodes the blocks following a miss while a voice streams through them, so streamed audio
+// takes one miss every pcm_PrefetchBlocks + 1 blocks instead of one per block. The entries
+// are keyed by the prev1/prev2 they were decoded with, like any other, so a voice that does
+// not get there with the same history just misses. Only blocks nobody has cached are filled,
+// and it stops at a loop end since the voice jumps elsewhere from there.
+static __forceinline void PrefetchPcmBlocks(u32 addr, u32 flags, s32 prev1, s32 prev2)
+{
+	for (int i = 0; i < pcm_PrefetchBlocks && !(flags & XAFLAG_LOOP_END); i++)
+	{
+		addr += pcm_WordsPerBlock;
+
+		if (addr >= 0x100000)
+			break;
+
+		PcmCacheEntry& line = pcm_cache_data[addr / pcm_WordsPerBlock];
+
+		if (line.Validated || IsPcmBlockInUse(line))
+			break;
+
+		const s16* memptr = GetMemPtr(addr);
+		flags = *memptr >> 8;
+
+		line.Validated = true;
+		line.Prev1 = prev1;
+		line.Prev2 = prev2;
+
+		XA_decode_block(line.Sampledata, memptr, prev1, prev2);
+
+		pcm_cache_stats.Prefetches++;
+	}
+}
+
 static __forceinline s32 GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 {
 	V_Voice& vc(thiscore.Voices[voiceidx]);
@@ -224,8 +264,7 @@ static __forceinline s32 GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 
 			//ConLog( "* SPU2: Cache Hit! NextA=0x%x, cacheIdx=0x%x\n", vc.NextA, cacheIdx );
 
-			if (IsDevBuild)
-				g_counter_cache_hits++;
+			pcm_cache_stats.Hits++;
 		}
 		else
 		{
@@ -235,17 +274,16 @@ static __forceinline s32 GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 				cacheLine.Validated = true;
 				cacheLine.Prev1 = vc.Prev1;
 				cacheLine.Prev2 = vc.Prev2;
-			}
 
-			if (IsDevBuild)
-			{
-				if (vc.NextA < SPU2_DYN_MEMLINE)
-					g_counter_cache_ignores++;
-				else
-					g_counter_cache_misses++;
+				pcm_cache_stats.Misses++;
 			}
+			else
+				pcm_cache_stats.Ignores++;
 
 			XA_decode_block(vc.SBuffer, memptr, vc.Prev1, vc.Prev2);
+
+			if (vc.NextA >= SPU2_DYN_MEMLINE)
+				PrefetchPcmBlocks(vc.NextA & 0xFFFF8, vc.LoopFlags, vc.Prev1, vc.Prev2);
 		}
 	}
 
@@ -291,15 +329,6 @@ static __forceinline void GetNextDataDummy(V_Core& thiscore, uint voiceidx)
 /////////////////////////////////////////////////////////////////////////////////////////
 //                                                                                     //
 
-// Data is expected to be 16 bit signed (typical stuff!).
-// volume is expected to be 32 bit signed (31 bits with reverse phase)
-// Data is shifted up by 1 bit to give the output an effective 16 bit range.
-static __forceinline s32 ApplyVolume(s32 data, s32 volume)
-{
-	//return (volume * data) >> 15;
-	return MulShr32(data << 1, volume);
-}
-
 static __forceinline StereoOut32 ApplyVolume(const StereoOut32& data, const V_VolumeLR& volume)
 {
 	return StereoOut32(
@@ -553,7 +582,8 @@ static __forceinline void spu2M_WriteFast(u32 addr, s16 value)
 }
 
 
-static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
+// Returns the voice output after ADSR, before the L/R volume is applied (see MixCoreVoices).
+static __forceinline s32 MixVoice(uint coreidx, uint voiceidx)
 {
 	V_Core& thiscore(Cores[coreidx]);
 	V_Voice& vc(thiscore.Voices[voiceidx]);
@@ -574,7 +604,6 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 
 	UpdatePitch(coreidx, voiceidx);
 
-	StereoOut32 voiceOut(0, 0);
 	s32 Value = 0;
 
 	if (vc.ADSR.Phase > 0)
@@ -624,8 +653,6 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 
 		if (IsDevBuild)
 			DebugCores[coreidx].Voices[voiceidx].displayPeak = std::max(DebugCores[coreidx].Voices[voiceidx].displayPeak, (s32)vc.OutX);
-
-		voiceOut = ApplyVolume(StereoOut32(Value, Value), vc.Volume);
 	}
 	else
 	{
@@ -639,7 +666,7 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 	else if (voiceidx == 3)
 		spu2M_WriteFast(((0 == coreidx) ? 0x600 : 0xe00) + OutPos, Value);
 
-	return voiceOut;
+	return Value;
 }
 
 const VoiceMixSet VoiceMixSet::Empty((StereoOut32()), (StereoOut32())); // Don't use SteroOut32::Empty because C++ doesn't make any dep/order checks on global initializers.
@@ -647,18 +674,32 @@ const VoiceMixSet VoiceMixSet::Empty((StereoOut32()), (StereoOut32())); // Don't
 static __forceinline void MixCoreVoices(VoiceMixSet& dest, const uint coreidx)
 {
 	V_Core& thiscore(Cores[coreidx]);
+	VoiceMixLanes lanes;
+
+	static_assert(VoiceMixLanes::NumVoices == V_Core::NumVoices, "Voice lanes don't match the core");
 
 	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
 	{
-		StereoOut32 VVal(MixVoice(coreidx, voiceidx));
+		const V_Voice& vc(thiscore.Voices[voiceidx]);
+		const V_VoiceGates& gates(thiscore.VoiceGates[voiceidx]);
 
 		// Note: Results from MixVoice are ranged at 16 bits.
 
-		dest.Dry.Left += VVal.Left & thiscore.VoiceGates[voiceidx].DryL;
-		dest.Dry.Right += VVal.Right & thiscore.VoiceGates[voiceidx].DryR;
-		dest.Wet.Left += VVal.Left & thiscore.VoiceGates[voiceidx].WetL;
-		dest.Wet.Right += VVal.Right & thiscore.VoiceGates[voiceidx].WetR;
+		lanes.Value[voiceidx] = MixVoice(coreidx, voiceidx);
+		lanes.VolL[voiceidx] = vc.Volume.Left.Value;
+		lanes.VolR[voiceidx] = vc.Volume.Right.Value;
+		lanes.DryL[voiceidx] = gates.DryL;
+		lanes.DryR[voiceidx] = gates.DryR;
+		lanes.WetL[voiceidx] = gates.WetL;
+		lanes.WetR[voiceidx] = gates.WetR;
 	}
+
+	const VoiceMixSums sums = MixVoiceLanes(lanes);
+
+	dest.Dry.Left += sums.DryL;
+	dest.Dry.Right += sums.DryR;
+	dest.Wet.Left += sums.WetL;
+	dest.Wet.Right += sums.WetR;
 }
 
 StereoOut32 V_Core::Mix(const VoiceMixSet& inVoices, const StereoOut32& Input, const StereoOut32& Ext)
@@ -831,21 +872,19 @@ __forceinline
 	if (OutPos >= 0x200)
 		OutPos = 0;
 
-	if (IsDevBuild)
+	p_cachestat_counter++;
+	if (p_cachestat_counter > (48000 * 10))
 	{
-		p_cachestat_counter++;
-		if (p_cachestat_counter > (48000 * 10))
+		p_cachestat_counter = 0;
+		if (MsgCache())
 		{
-			p_cachestat_counter = 0;
-			if (MsgCache())
-				ConLog(" * SPU2 > CacheStats > Hits: %d  Misses: %d  Ignores: %d\n",
-					   g_counter_cache_hits,
-					   g_counter_cache_misses,
-					   g_counter_cache_ignores);
-
-			g_counter_cache_hits =
-				g_counter_cache_misses =
-					g_counter_cache_ignores = 0;
+			const PcmCacheStats& s = pcm_cache_stats;
+			const u32 lookups = std::max<u32>(s.Hits + s.Misses, 1);
+
+			ConLog(" * SPU2 > CacheStats > Hits: %u (%u%%)  Misses: %u  Ignores: %u  Prefetches: %u  Invalidations: %u\n",
+				   s.Hits, s.Hits * 100 / lookups, s.Misses, s.Ignores, s.Prefetches, s.Invalidations);
 		}
+
+		pcm_cache_stats = {};
 	}
 }
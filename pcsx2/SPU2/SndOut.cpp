@@ -15,6 +15,10 @@
 
 #include "PrecompiledHeader.h"
 #include "Global.h"
+#include "soundtouch/source/SoundStretch/WavFile.h"
+#include "common/Path.h"
+
+#include <chrono>
 
 
 StereoOut32 StereoOut32::Empty(0, 0);
@@ -79,6 +83,97 @@ public:
 
 } NullOut;
 
+// Offline output: drains the buffer into a wav file as soon as a packet is written, at
+// whatever speed the emulator runs, with no timestretching. Used for headless audio
+// regression and to measure mixing throughput.
+class FileOutModule : public SndOutModule
+{
+	WavOutFile* m_file = nullptr;
+	StereoOut16 m_packet[SndOutPacketSize];
+
+	u64 m_samples = 0;
+	std::chrono::steady_clock::time_point m_start;
+
+public:
+	s32 Init()
+	{
+		EmuFolders::Snapshots.Mkdir();
+		const wxString filename = Path::Combine(EmuFolders::Snapshots, wxFileName(L"audio_render.wav"));
+
+		try
+		{
+			m_file = new WavOutFile(wxFopen(filename, L"wb"), SampleRate, 16, 2);
+		}
+		catch (std::runtime_error&)
+		{
+			Console.Error(L"* SPU2: Could not create %s.", WX_STR(filename));
+			return -1;
+		}
+
+		m_samples = 0;
+		m_start = std::chrono::steady_clock::now();
+
+		return 0;
+	}
+
+	void Close()
+	{
+		if (m_file == nullptr)
+			return;
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+
+		if (m_samples > 0 && seconds > 0)
+		{
+			const double audio = (double)m_samples / SampleRate;
+			ConLog("* SPU2: Rendered %.1f seconds of audio in %.1f seconds (%.2fx realtime)\n", audio, seconds, audio / seconds);
+		}
+
+		safe_delete(m_file);
+	}
+
+	// Called by SndBuffer right after a packet was written.
+	void Drain()
+	{
+		while (SndBuffer::_GetApproximateDataInBuffer() >= SndOutPacketSize)
+		{
+			SndBuffer::ReadSamples(m_packet);
+
+			m_file->write((s16*)m_packet, SndOutPacketSize * 2);
+			m_samples += SndOutPacketSize;
+		}
+	}
+
+	s32 Test() const { return 0; }
+	void Configure(uptr parent) {}
+	int GetEmptySampleCount() { return 0; }
+
+	const wchar_t* GetIdent() const
+	{
+		return L"fileout";
+	}
+
+	const wchar_t* GetLongName() const
+	{
+		return L"Render to File (snapshots/audio_render.wav, no timestretch)";
+	}
+
+	void ReadSettings()
+	{
+	}
+
+	void SetApiSettings(wxString api)
+	{
+	}
+
+	void WriteSettings() const
+	{
+	}
+
+} FileOutMod;
+
+SndOutModule* const FileOut = &FileOutMod;
+
 SndOutModule* mods[] =
 	{
 		&NullOut,
@@ -91,6 +186,7 @@ SndOutModule* mods[] =
 #if defined(__linux__) || defined(__APPLE__)
 		SDLOut,
 #endif
+		&FileOutMod,
 		nullptr // signals the end of our list
 };
 
@@ -108,8 +204,8 @@ int FindOutputModuleById(const wchar_t* omodid)
 
 StereoOut32* SndBuffer::m_buffer;
 s32 SndBuffer::m_size;
-__aligned(4) volatile s32 SndBuffer::m_rpos;
-__aligned(4) volatile s32 SndBuffer::m_wpos;
+std::atomic<s32> SndBuffer::m_rpos;
+std::atomic<s32> SndBuffer::m_wpos;
 
 bool SndBuffer::m_underrun_freeze;
 StereoOut32* SndBuffer::sndTempBuffer = nullptr;
@@ -172,7 +268,9 @@ void SndBuffer::_InitFail()
 int SndBuffer::_GetApproximateDataInBuffer()
 {
 	// WARNING: not necessarily 100% up to date by the time it's used, but it will have to do.
-	return (m_wpos + m_size - m_rpos) % m_size;
+	// Both are acquired: the reader must see the samples behind m_wpos, and the writer must
+	// not overwrite samples the reader hasn't finished with.
+	return (m_wpos.load(std::memory_order_acquire) + m_size - m_rpos.load(std::memory_order_acquire)) % m_size;
 }
 
 void SndBuffer::_WriteSamples_Internal(StereoOut32* bData, int nSamples)
@@ -180,29 +278,33 @@ void SndBuffer::_WriteSamples_Internal(StereoOut32* bData, int nSamples)
 	// WARNING: This assumes the write will NOT wrap around,
 	// and also assumes there's enough free space in the buffer.
 
-	memcpy(m_buffer + m_wpos, bData, nSamples * sizeof(StereoOut32));
-	m_wpos = (m_wpos + nSamples) % m_size;
+	const s32 wpos = m_wpos.load(std::memory_order_relaxed);
+
+	memcpy(m_buffer + wpos, bData, nSamples * sizeof(StereoOut32));
+	m_wpos.store((wpos + nSamples) % m_size, std::memory_order_release);
 }
 
 void SndBuffer::_DropSamples_Internal(int nSamples)
 {
-	m_rpos = (m_rpos + nSamples) % m_size;
+	m_rpos.store((m_rpos.load(std::memory_order_relaxed) + nSamples) % m_size, std::memory_order_release);
 }
 
 void SndBuffer::_ReadSamples_Internal(StereoOut32* bData, int nSamples)
 {
 	// WARNING: This assumes the read will NOT wrap around,
 	// and also assumes there's enough data in the buffer.
-	memcpy(bData, m_buffer + m_rpos, nSamples * sizeof(StereoOut32));
+	memcpy(bData, m_buffer + m_rpos.load(std::memory_order_relaxed), nSamples * sizeof(StereoOut32));
 	_DropSamples_Internal(nSamples);
 }
 
 void SndBuffer::_WriteSamples_Safe(StereoOut32* bData, int nSamples)
 {
 	// WARNING: This code assumes there's only ONE writing process.
-	if ((m_size - m_wpos) < nSamples)
+	const s32 wpos = m_wpos.load(std::memory_order_relaxed);
+
+	if ((m_size - wpos) < nSamples)
 	{
-		int b1 = m_size - m_wpos;
+		int b1 = m_size - wpos;
 		int b2 = nSamples - b1;
 
 		_WriteSamples_Internal(bData, b1);
@@ -217,9 +319,11 @@ void SndBuffer::_WriteSamples_Safe(StereoOut32* bData, int nSamples)
 void SndBuffer::_ReadSamples_Safe(StereoOut32* bData, int nSamples)
 {
 	// WARNING: This code assumes there's only ONE reading process.
-	if ((m_size - m_rpos) < nSamples)
+	const s32 rpos = m_rpos.load(std::memory_order_relaxed);
+
+	if ((m_size - rpos) < nSamples)
 	{
-		int b1 = m_size - m_rpos;
+		int b1 = m_size - rpos;
 		int b2 = nSamples - b1;
 
 		_ReadSamples_Internal(bData, b1);
@@ -259,7 +363,8 @@ void SndBuffer::ReadSamples(T* bData)
 		pxAssume(nSamples <= SndOutPacketSize);
 
 		// WARNING: This code assumes there's only ONE reading process.
-		int b1 = m_size - m_rpos;
+		const s32 rpos = m_rpos.load(std::memory_order_relaxed);
+		int b1 = m_size - rpos;
 
 		if (b1 > nSamples)
 			b1 = nSamples;
@@ -268,7 +373,7 @@ void SndBuffer::ReadSamples(T* bData)
 		{
 			// First part
 			for (int i = 0; i < b1; i++)
-				bData[i].AdjustFrom(m_buffer[i + m_rpos]);
+				bData[i].AdjustFrom(m_buffer[i + rpos]);
 
 			// Second part
 			int b2 = nSamples - b1;
@@ -279,7 +384,7 @@ void SndBuffer::ReadSamples(T* bData)
 		{
 			// First part
 			for (int i = 0; i < b1; i++)
-				bData[i].ResampleFrom(m_buffer[i + m_rpos]);
+				bData[i].ResampleFrom(m_buffer[i + rpos]);
 
 			// Second part
 			int b2 = nSamples - b1;
@@ -498,6 +603,11 @@ void SndBuffer::Write(const StereoOut32& Sample)
 		}
 	}
 #endif
+	else if (mods[OutputModule] == FileOut)
+	{
+		_WriteSamples(sndTempBuffer, SndOutPacketSize);
+		FileOutMod.Drain();
+	}
 	else
 	{
 		if (SynchMode == 0) // TimeStrech on
@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include <atomic>
+
 // Number of stereo samples per SndOut block.
 // All drivers must work in units of this size when communicating with
 // SndOut.
@@ -578,8 +580,10 @@ private:
 	static StereoOut32* m_buffer;
 	static s32 m_size;
 
-	static __aligned(4) volatile s32 m_rpos;
-	static __aligned(4) volatile s32 m_wpos;
+	// Single producer (the SPU2 mixer) / single consumer (the output module) ring:
+	// only the writer stores m_wpos and only the reader stores m_rpos.
+	static std::atomic<s32> m_rpos;
+	static std::atomic<s32> m_wpos;
 
 	static float lastEmergencyAdj;
 	static float cTempo;
@@ -612,6 +616,8 @@ private:
 
 	static int _GetApproximateDataInBuffer();
 
+	friend class FileOutModule;
+
 public:
 	static void UpdateTempoChangeAsyncMixing();
 	static void Init();
@@ -672,6 +678,7 @@ extern SndOutModule* PortaudioOut;
 #endif
 extern SndOutModule* const SDLOut;
 extern SndOutModule* mods[];
+extern SndOutModule* const FileOut;
 
 // =====================================================================================================
 
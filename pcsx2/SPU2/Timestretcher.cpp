@@ -18,6 +18,7 @@
 #include "SoundTouch.h"
 #include <wx/datetime.h>
 #include <algorithm>
+#include <immintrin.h>
 
 //Uncomment the next line to use the old time stretcher
 //#define SPU2X_USE_OLD_STRETCHER
@@ -464,12 +465,16 @@ s32 SndBuffer::timeStretchOverrun()
 	return SndOutPacketSize * 2;
 }
 
+// Same math as the StereoOutFloat/StereoOut32 conversions, two stereo samples at a time.
 static void CvtPacketToFloat(StereoOut32* srcdest)
 {
-	StereoOutFloat* dest = (StereoOutFloat*)srcdest;
-	const StereoOut32* src = (StereoOut32*)srcdest;
-	for (uint i = 0; i < SndOutPacketSize; ++i, ++dest, ++src)
-		*dest = (StereoOutFloat)*src;
+	static_assert((SndOutPacketSize & 1) == 0, "Packet must hold an even number of samples");
+
+	const __m128 scale = _mm_set1_ps(2147483647.0f);
+	__m128i* p = (__m128i*)srcdest;
+
+	for (uint i = 0; i < SndOutPacketSize / 2; ++i)
+		_mm_storeu_ps((float*)&p[i], _mm_div_ps(_mm_cvtepi32_ps(_mm_loadu_si128(&p[i])), scale));
 }
 
 // Parameter note: Size should always be a multiple of 128, thanks!
@@ -477,11 +482,16 @@ static void CvtPacketToInt(StereoOut32* srcdest, uint size)
 {
 	//pxAssume( (size & 127) == 0 );
 
-	const StereoOutFloat* src = (StereoOutFloat*)srcdest;
-	StereoOut32* dest = srcdest;
+	const __m128 scale = _mm_set1_ps(2147483647.0f);
+	__m128i* p = (__m128i*)srcdest;
+
+	uint i = 0;
+
+	for (; i < size / 2; ++i)
+		_mm_storeu_si128(&p[i], _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps((float*)&p[i]), scale)));
 
-	for (uint i = 0; i < size; ++i, ++dest, ++src)
-		*dest = (StereoOut32)*src;
+	if (size & 1)
+		srcdest[size - 1] = (StereoOut32)((StereoOutFloat*)srcdest)[size - 1];
 }
 
 void SndBuffer::timeStretchWrite()
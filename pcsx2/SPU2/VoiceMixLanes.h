@@ -0,0 +1,156 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2020  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <immintrin.h>
+
+// Performs a 64-bit multiplication between two values and returns the
+// high 32 bits as a result (discarding the fractional 32 bits).
+// The combined fractional bits of both inputs must be 32 bits for this
+// to work properly.
+//
+// This is meant to be a drop-in replacement for times when the 'div' part
+// of a MulDiv is a constant.  (example: 1<<8, or 4096, etc)
+//
+// [Air] Performance breakdown: This is over 10 times faster than MulDiv in
+//   a *worst case* scenario.  It's also more accurate since it forces the
+//   caller to  extend the inputs so that they make use of all 32 bits of
+//   precision.
+//
+static __forceinline s32 MulShr32(s32 srcval, s32 mulval)
+{
+	return (s64)srcval * mulval >> 32;
+}
+
+// Data is expected to be 16 bit signed (typical stuff!).
+// volume is expected to be 32 bit signed (31 bits with reverse phase)
+// Data is shifted up by 1 bit to give the output an effective 16 bit range.
+static __forceinline s32 ApplyVolume(s32 data, s32 volume)
+{
+	//return (volume * data) >> 15;
+	return MulShr32(data << 1, volume);
+}
+
+// The sample fetch, pitch and ADSR of a voice depend on the previous voice (pitch modulation)
+// and on SPU2 memory, so they stay scalar. What's left is the same for every voice: apply the
+// L/R volume and sum the gated results into the dry and wet busses, so MixVoice only produces
+// the voice value and the rest is done on all the voices of a core at once, structure-of-arrays.
+// Everything is integer math with wrapping adds, so the result is identical to mixing the voices
+// one by one with ApplyVolume.
+struct alignas(32) VoiceMixLanes
+{
+	static const uint NumVoices = 24;
+
+	s32 Value[NumVoices];
+	s32 VolL[NumVoices];
+	s32 VolR[NumVoices];
+	s32 DryL[NumVoices];
+	s32 DryR[NumVoices];
+	s32 WetL[NumVoices];
+	s32 WetR[NumVoices];
+};
+
+struct VoiceMixSums
+{
+	s32 DryL, DryR, WetL, WetR;
+};
+
+#if defined(__AVX2__)
+
+// MulShr32 on 8 lanes
+static __forceinline __m256i MulShr32(__m256i a, __m256i b)
+{
+	__m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 32);
+	__m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+	return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+static __forceinline s32 SumLanes(__m256i v)
+{
+	__m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	s = _mm_hadd_epi32(s, s);
+	s = _mm_hadd_epi32(s, s);
+
+	return _mm_cvtsi128_si32(s);
+}
+
+static __forceinline VoiceMixSums MixVoiceLanes(const VoiceMixLanes& lanes)
+{
+	__m256i dryl = _mm256_setzero_si256();
+	__m256i dryr = _mm256_setzero_si256();
+	__m256i wetl = _mm256_setzero_si256();
+	__m256i wetr = _mm256_setzero_si256();
+
+	for (uint i = 0; i < VoiceMixLanes::NumVoices; i += 8)
+	{
+		// Data is shifted up by 1 bit to give the output an effective 16 bit range (see ApplyVolume)
+		__m256i v = _mm256_slli_epi32(_mm256_load_si256((const __m256i*)&lanes.Value[i]), 1);
+		__m256i l = MulShr32(v, _mm256_load_si256((const __m256i*)&lanes.VolL[i]));
+		__m256i r = MulShr32(v, _mm256_load_si256((const __m256i*)&lanes.VolR[i]));
+
+		dryl = _mm256_add_epi32(dryl, _mm256_and_si256(l, _mm256_load_si256((const __m256i*)&lanes.DryL[i])));
+		dryr = _mm256_add_epi32(dryr, _mm256_and_si256(r, _mm256_load_si256((const __m256i*)&lanes.DryR[i])));
+		wetl = _mm256_add_epi32(wetl, _mm256_and_si256(l, _mm256_load_si256((const __m256i*)&lanes.WetL[i])));
+		wetr = _mm256_add_epi32(wetr, _mm256_and_si256(r, _mm256_load_si256((const __m256i*)&lanes.WetR[i])));
+	}
+
+	return {SumLanes(dryl), SumLanes(dryr), SumLanes(wetl), SumLanes(wetr)};
+}
+
+#else
+
+// MulShr32 on 4 lanes
+static __forceinline __m128i MulShr32(__m128i a, __m128i b)
+{
+	__m128i even = _mm_srli_epi64(_mm_mul_epi32(a, b), 32);
+	__m128i odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+	return _mm_blend_epi16(even, odd, 0xcc);
+}
+
+static __forceinline s32 SumLanes(__m128i v)
+{
+	v = _mm_hadd_epi32(v, v);
+	v = _mm_hadd_epi32(v, v);
+
+	return _mm_cvtsi128_si32(v);
+}
+
+static __forceinline VoiceMixSums MixVoiceLanes(const VoiceMixLanes& lanes)
+{
+	__m128i dryl = _mm_setzero_si128();
+	__m128i dryr = _mm_setzero_si128();
+	__m128i wetl = _mm_setzero_si128();
+	__m128i wetr = _mm_setzero_si128();
+
+	for (uint i = 0; i < VoiceMixLanes::NumVoices; i += 4)
+	{
+		// Data is shifted up by 1 bit to give the output an effective 16 bit range (see ApplyVolume)
+		__m128i v = _mm_slli_epi32(_mm_load_si128((const __m128i*)&lanes.Value[i]), 1);
+		__m128i l = MulShr32(v, _mm_load_si128((const __m128i*)&lanes.VolL[i]));
+		__m128i r = MulShr32(v, _mm_load_si128((const __m128i*)&lanes.VolR[i]));
+
+		dryl = _mm_add_epi32(dryl, _mm_and_si128(l, _mm_load_si128((const __m128i*)&lanes.DryL[i])));
+		dryr = _mm_add_epi32(dryr, _mm_and_si128(r, _mm_load_si128((const __m128i*)&lanes.DryR[i])));
+		wetl = _mm_add_epi32(wetl, _mm_and_si128(l, _mm_load_si128((const __m128i*)&lanes.WetL[i])));
+		wetr = _mm_add_epi32(wetr, _mm_and_si128(r, _mm_load_si128((const __m128i*)&lanes.WetR[i])));
+	}
+
+	return {SumLanes(dryl), SumLanes(dryr), SumLanes(wetl), SumLanes(wetr)};
+}
+
+#endif
@@ -59,6 +59,7 @@ float VolumeAdjustLFE;
 // OUTPUT
 int SndOutLatencyMS = 100;
 int SynchMode = 0; // Time Stretch, Async or Disabled.
+int MixBatchTicks = 0; // Deferred mixing batch size in 48khz ticks, 0 to mix every 12 ticks.
 
 u32 OutputModule = 0;
 
@@ -102,6 +103,7 @@ void ReadSettings()
 	VolumeAdjustLFE = powf(10, VolumeAdjustLFEdb / 10);
 
 	SynchMode = CfgReadInt(L"OUTPUT", L"Synch_Mode", 0);
+	MixBatchTicks = CfgReadInt(L"OUTPUT", L"MixBatchTicks", 0);
 	numSpeakers = CfgReadInt(L"OUTPUT", L"SpeakerConfiguration", 0);
 	dplLevel = CfgReadInt(L"OUTPUT", L"DplDecodingLevel", 0);
 	SndOutLatencyMS = CfgReadInt(L"OUTPUT", L"Latency", 100);
@@ -111,6 +113,8 @@ void ReadSettings()
 	else if (SndOutLatencyMS < LATENCY_MIN)
 		SndOutLatencyMS = LATENCY_MIN;
 
+	Clampify(MixBatchTicks, 0, MIXBATCH_MAX);
+
 	wchar_t omodid[128];
 
 	// Portaudio occasionally has issues selecting the proper default audio device.
@@ -166,6 +170,7 @@ void WriteSettings()
 	CfgWriteStr(L"OUTPUT", L"Output_Module", mods[OutputModule]->GetIdent());
 	CfgWriteInt(L"OUTPUT", L"Latency", SndOutLatencyMS);
 	CfgWriteInt(L"OUTPUT", L"Synch_Mode", SynchMode);
+	CfgWriteInt(L"OUTPUT", L"MixBatchTicks", MixBatchTicks);
 	CfgWriteInt(L"OUTPUT", L"SpeakerConfiguration", numSpeakers);
 	CfgWriteInt(L"OUTPUT", L"DplDecodingLevel", dplLevel);
 
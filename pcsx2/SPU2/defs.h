@@ -608,3 +608,20 @@ struct PcmCacheEntry
 };
 
 extern PcmCacheEntry* pcm_cache_data;
+
+// Number of blocks decoded ahead of a voice after a cache miss.
+static const int pcm_PrefetchBlocks = 4;
+
+struct PcmCacheStats
+{
+	u32 Hits;
+	u32 Misses;
+	u32 Ignores;       // blocks in the dynamic range, never cached
+	u32 Prefetches;    // blocks decoded ahead of a voice
+	u32 Invalidations; // cached blocks dropped by memory writes and DMA
+};
+
+extern PcmCacheStats pcm_cache_stats;
+
+// Drops the cached blocks overlapping the [start, end) range of SPU2 memory (in words).
+extern void InvalidatePcmCache(u32 start, u32 end);
@@ -67,6 +67,9 @@ void SPU2readDMA4Mem(u16* pMem, u32 size) // size now in 16bit units
 
 	FileLog("[%10d] SPU2 readDMA4Mem size %x\n", Cycles, size << 1);
 	Cores[0].DoDMAread(pMem, size);
+
+	if (MixBatchTicks > 0)
+		SPU2UpdateAsyncInterval();
 }
 
 void SPU2writeDMA4Mem(u16* pMem, u32 size) // size now in 16bit units
@@ -76,6 +79,9 @@ void SPU2writeDMA4Mem(u16* pMem, u32 size) // size now in 16bit units
 	FileLog("[%10d] SPU2 writeDMA4Mem size %x at address %x\n", Cycles, size << 1, Cores[0].TSA);
 
 	Cores[0].DoDMAwrite(pMem, size);
+
+	if (MixBatchTicks > 0)
+		SPU2UpdateAsyncInterval();
 }
 
 void SPU2interruptDMA4()
@@ -102,6 +108,9 @@ void SPU2readDMA7Mem(u16* pMem, u32 size)
 
 	FileLog("[%10d] SPU2 readDMA7Mem size %x\n", Cycles, size << 1);
 	Cores[1].DoDMAread(pMem, size);
+
+	if (MixBatchTicks > 0)
+		SPU2UpdateAsyncInterval();
 }
 
 void SPU2writeDMA7Mem(u16* pMem, u32 size)
@@ -111,6 +120,9 @@ void SPU2writeDMA7Mem(u16* pMem, u32 size)
 	FileLog("[%10d] SPU2 writeDMA7Mem size %x at address %x\n", Cycles, size << 1, Cores[1].TSA);
 
 	Cores[1].DoDMAwrite(pMem, size);
+
+	if (MixBatchTicks > 0)
+		SPU2UpdateAsyncInterval();
 }
 
 s32 SPU2reset(PS2Modes isRunningPSXMode)
@@ -474,6 +486,9 @@ void SPU2write(u32 rmem, u16 value)
 		SPU2writeLog("write", rmem, value);
 		SPU2_FastWrite(rmem, value);
 	}
+
+	if (MixBatchTicks > 0)
+		SPU2UpdateAsyncInterval();
 }
 
 // returns a non zero value if successful
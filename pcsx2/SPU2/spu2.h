@@ -40,6 +40,8 @@ bool SPU2setupRecording(const std::string* filename);
 void SPU2endRecording();
 
 void SPU2async(u32 cycles);
+u32 SPU2GetAsyncInterval(); // IOP cycles until the next SPU2async
+void SPU2UpdateAsyncInterval();
 s32 SPU2freeze(FreezeAction mode, freezeData* data);
 void SPU2configure();
 
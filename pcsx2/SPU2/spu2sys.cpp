@@ -86,7 +86,11 @@ __forceinline void spu2M_Write(u32 addr, s16 value)
 	if (addr >= SPU2_DYN_MEMLINE)
 	{
 		const int cacheIdx = addr / pcm_WordsPerBlock;
-		pcm_cache_data[cacheIdx].Validated = false;
+		if (pcm_cache_data[cacheIdx].Validated)
+		{
+			pcm_cache_data[cacheIdx].Validated = false;
+			pcm_cache_stats.Invalidations++;
+		}
 
 		if (MsgToConsole() && MsgCache())
 			ConLog("* SPU2: PcmCache Block Clear at 0x%x (cacheIdx=0x%x)\n", addr, cacheIdx);
@@ -355,6 +359,57 @@ uint TickInterval = 768;
 static const int SanityInterval = 4800;
 extern void UpdateDebugDialog();
 
+// Number of ticks mixed and number of TimeUpdate calls that mixed anything, for the
+// average batch size (dev builds only).
+static u32 p_mixstat_ticks = 0;
+static u32 p_mixstat_batches = 0;
+
+// True when mixing the core late would be observable: its IRQ is armed (voices, reverb and
+// the input area can reach IRQA), an AutoDMA stream is running (its MADR moves and its
+// completion IRQ is raised as the input area is mixed), or a DMA is still counting down to
+// its completion IRQ.
+static bool CoreNeedsTimelyMix(const V_Core& core)
+{
+	return core.IRQEnable || core.AutoDMACtrl || core.AdmaInProgress || core.InputDataLeft || core.InputDataTransferred || core.DMAICounter > 0;
+}
+
+u32 SPU2GetAsyncInterval()
+{
+	static const u32 DefaultTicks = 12;
+
+	// Register reads/writes and DMA always catch up with TimeUpdate before they touch the
+	// SPU2. Other than that, the IOP can only see the SPU2 move on through IRQs and through
+	// the MADR and completion IRQs of DMA transfers, which are raised from TimeUpdate.
+	// When no core has any of those going, mixing can be deferred and done in larger blocks
+	// without changing anything observable.
+	if (MixBatchTicks <= (int)DefaultTicks || CoreNeedsTimelyMix(Cores[0]) || CoreNeedsTimelyMix(Cores[1]))
+		return TickInterval * DefaultTicks;
+
+	// Never hold back more than a quarter of the output latency, so the SndBuffer isn't
+	// left waiting for a batch, nor anywhere near what TimeUpdate would drop as bogus.
+	static_assert(MIXBATCH_MAX <= SanityInterval / 2, "Mix batches would trip the TimeUpdate sanity check");
+	const u32 ticks = std::min<u32>({(u32)MixBatchTicks, (u32)MIXBATCH_MAX, (u32)SndOutLatencyMS * 48 / 4});
+
+	return TickInterval * std::max(ticks, DefaultTicks);
+}
+
+// Pulls the next SPU2async in when deferred mixing just ended (IRQ enabled, DMA started).
+void SPU2UpdateAsyncInterval()
+{
+	const u32 interval = SPU2GetAsyncInterval();
+
+	if (((psxCounters[6].sCycleT + psxCounters[6].CycleT) - psxRegs.cycle) > interval)
+	{
+		psxCounters[6].sCycleT = psxRegs.cycle;
+		psxCounters[6].CycleT = interval;
+
+		psxNextCounter -= (psxRegs.cycle - psxNextsCounter);
+		psxNextsCounter = psxRegs.cycle;
+		if (psxCounters[6].CycleT < psxNextCounter)
+			psxNextCounter = psxCounters[6].CycleT;
+	}
+}
+
 __forceinline bool StartQueuedVoice(uint coreidx, uint voiceidx)
 {
 	V_Voice& vc(Cores[coreidx].Voices[voiceidx]);
@@ -419,6 +474,20 @@ __forceinline void TimeUpdate(u32 cClocks)
 	else
 		TickInterval = 768; // Reset to default, in case the user hotswitched from async to something else.
 
+	if (IsDevBuild && dClocks >= TickInterval)
+	{
+		p_mixstat_ticks += dClocks / TickInterval;
+		p_mixstat_batches++;
+
+		if (p_mixstat_ticks > (48000 * 10))
+		{
+			if (MsgToConsole())
+				ConLog(" * SPU2 > MixStats > Average batch: %.1f ticks\n", (float)p_mixstat_ticks / p_mixstat_batches);
+
+			p_mixstat_ticks = p_mixstat_batches = 0;
+		}
+	}
+
 	//Update Mixing Progress
 	while (dClocks >= TickInterval)
 	{
@@ -34,6 +34,8 @@
 #include "iR5900.h"
 #include "System.h"
 #include "DebugTools/Debug.h"
+#include "DebugTools/TraceRing.h"
+#include "common/StringUtil.h"
 
 using namespace R5900;
 
@@ -71,22 +73,78 @@ void SysTraceLog::DoWrite(const char* msg) const
 	fflush(emuLog);
 }
 
+bool SysTraceLog::DoWriteBinary(const char* fmt, va_list list) const
+{
+	if (!EmuConfig.Trace.Binary)
+		return false;
+
+	if (!TraceRing::IsOpen())
+	{
+		// Next to emuLog.txt, opened on first use so that text only sessions don't get one.
+		static bool s_open_failed = false;
+		if (s_open_failed)
+			return false;
+
+		wxFileName path(emuLogName.IsEmpty() ? L"emuLog.txt" : emuLogName);
+		path.SetFullName(L"emuLog.trace.gz");
+		if (!TraceRing::Open(StringUtil::wxStringToUTF8String(path.GetFullPath())))
+		{
+			Console.Error("Failed to open the binary trace log, falling back to text.");
+			s_open_failed = true;
+			return false;
+		}
+	}
+
+	u32 prefix[2];
+	const u32 prefix_count = GetPrefixArgs(prefix);
+	return TraceRing::Write(*this, fmt, prefix, prefix_count, list);
+}
+
 void SysTraceLog_EE::ApplyPrefix(FastFormatAscii& ascii) const
 {
 	ascii.Write("%-4s(%8.8lx %8.8lx): ", ((SysTraceLogDescriptor*)m_Descriptor)->Prefix, cpuRegs.pc, cpuRegs.cycle);
 }
 
+std::string SysTraceLog_EE::GetPrefixFormat() const
+{
+	return StringUtil::StdStringFromFormat("%-4s(%%8.8x %%8.8x): ", ((SysTraceLogDescriptor*)m_Descriptor)->Prefix);
+}
+
+u32 SysTraceLog_EE::GetPrefixArgs(u32* args) const
+{
+	args[0] = cpuRegs.pc;
+	args[1] = cpuRegs.cycle;
+	return 2;
+}
+
 void SysTraceLog_IOP::ApplyPrefix(FastFormatAscii& ascii) const
 {
 	ascii.Write("%-4s(%8.8lx %8.8lx): ", ((SysTraceLogDescriptor*)m_Descriptor)->Prefix, psxRegs.pc, psxRegs.cycle);
 }
 
+std::string SysTraceLog_IOP::GetPrefixFormat() const
+{
+	return StringUtil::StdStringFromFormat("%-4s(%%8.8x %%8.8x): ", ((SysTraceLogDescriptor*)m_Descriptor)->Prefix);
+}
+
+u32 SysTraceLog_IOP::GetPrefixArgs(u32* args) const
+{
+	args[0] = psxRegs.pc;
+	args[1] = psxRegs.cycle;
+	return 2;
+}
+
 void SysTraceLog_VIFcode::ApplyPrefix(FastFormatAscii& ascii) const
 {
 	_parent::ApplyPrefix(ascii);
 	ascii.Write("vifCode_");
 }
 
+std::string SysTraceLog_VIFcode::GetPrefixFormat() const
+{
+	return _parent::GetPrefixFormat() + "vifCode_";
+}
+
 // --------------------------------------------------------------------------------------
 //  SysConsoleLogPack  (descriptions)
 // --------------------------------------------------------------------------------------
@@ -186,6 +186,7 @@ void SysCoreThread::ApplySettings(const Pcsx2Config& src)
 	m_resetVsyncTimers = (src.GS != EmuConfig.GS);
 
 	EmuConfig.CopyConfig(src);
+	EmuConfig.ThreadPlacement.Apply();
 }
 
 // --------------------------------------------------------------------------------------
@@ -251,6 +252,7 @@ void SysCoreThread::DoCpuReset()
 //
 void SysCoreThread::VsyncInThread()
 {
+	Threading::SampleThreadPlacement();
 	ApplyLoadedPatches(PPT_CONTINUOUSLY);
 	ApplyLoadedPatches(PPT_COMBINED_0_1);
 }
@@ -299,6 +301,9 @@ void SysCoreThread::ExecuteTaskInThread()
 	Threading::EnableHiresScheduler(); // Note that *something* in SPU2 and GS also set the timer resolution to 1ms.
 	m_sem_event.WaitWithoutYield();
 
+	EmuConfig.ThreadPlacement.Apply();
+	Threading::PlaceCurrentThread(Threading::ThreadRole::EECore);
+
 	m_mxcsr_saved.bitmask = _mm_getcsr();
 
 	PCSX2_PAGEFAULT_PROTECT
@@ -362,6 +367,7 @@ void SysCoreThread::OnCleanupInThread()
 
 	_mm_setcsr(m_mxcsr_saved.bitmask);
 	Threading::DisableHiresScheduler();
+	Threading::ReleaseCurrentThread();
 	_parent::OnCleanupInThread();
 
 	m_ExecMode = ExecMode_NoThreadYet;
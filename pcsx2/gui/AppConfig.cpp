@@ -23,6 +23,7 @@
 
 #include <wx/stdpaths.h>
 #include "DebugTools/Debug.h"
+#include "DebugTools/TraceRing.h"
 #include <memory>
 #include <algorithm>
 
@@ -352,6 +353,12 @@ wxString GetUiKeysFilename()
 	return GetSettingsFolder().Combine(fname).GetFullPath();
 }
 
+wxString GetGameDatabaseCacheFilename()
+{
+	wxFileName fname(L"GameIndex.cache");
+	return GetSettingsFolder().Combine(fname).GetFullPath();
+}
+
 wxDirName& AppConfig::FolderOptions::operator[](FoldersEnum_t folderidx)
 {
 	switch (folderidx)
@@ -1025,6 +1032,8 @@ void RelocateLogfile()
 		Console.WriteLn(L"\nRelocating Logfile...\n\tFrom: %s\n\tTo  : %s\n", WX_STR(emuLogName), WX_STR(newlogname));
 		wxGetApp().DisableDiskLogging();
 
+		// Reopened next to the new log on the next binary trace write.
+		TraceRing::Close();
 		fclose(emuLog);
 		emuLog = NULL;
 	}
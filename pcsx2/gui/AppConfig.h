@@ -68,6 +68,7 @@ extern wxDirName		InstallFolder;
 extern wxString  GetVmSettingsFilename();
 extern wxString  GetUiSettingsFilename();
 extern wxString  GetUiKeysFilename();
+extern wxString  GetGameDatabaseCacheFilename();
 
 enum InstallationModeType
 {
@@ -62,11 +62,23 @@ AppGameDatabase& AppGameDatabase::LoadFromFile(const wxString& _file)
 
 	const u64 qpc_Start = GetCPUTicks();
 
-	std::ifstream fileStream = getFileAsStream(file);
-	if (!this->initDatabase(fileStream))
+	// The YAML is only parsed when the cache was built from a different copy of it.
+	const wxFileName source(file);
+	const u64 sourceSize = source.GetSize().GetValue();
+	const s64 sourceTime = source.GetModificationTime().GetValue().GetValue();
+	const wxString cacheFile = GetGameDatabaseCacheFilename();
+
+	if (!this->openCache(cacheFile, sourceSize, sourceTime))
 	{
-		Console.Error(L"[GameDB] Database could not be loaded successfully");
-		return *this;
+		std::ifstream fileStream = getFileAsStream(file);
+		if (!this->initDatabase(fileStream))
+		{
+			Console.Error(L"[GameDB] Database could not be loaded successfully");
+			return *this;
+		}
+
+		if (!this->writeCache(cacheFile, sourceSize, sourceTime))
+			Console.Warning(L"[GameDB] Could not write the database cache [%s]", WX_STR(cacheFile));
 	}
 
 	const u64 qpc_end = GetCPUTicks();
@@ -19,7 +19,7 @@
 
 #include "AppConfig.h"
 
-class AppGameDatabase : public YamlGameDatabaseImpl
+class AppGameDatabase : public BinaryGameDatabaseImpl
 {
 public:
 	AppGameDatabase() {}
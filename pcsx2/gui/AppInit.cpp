@@ -23,6 +23,7 @@
 #include "common/IniInterface.h"
 #include "common/StringUtil.h"
 #include "DebugTools/Debug.h"
+#include "DebugTools/TraceRing.h"
 #include "Dialogs/ModalPopups.h"
 
 #include "Debugger/DisassemblyDialog.h"
@@ -751,6 +752,7 @@ void Pcsx2App::CleanUp()
 	m_RecentIsoList = NULL;
 
 	DisableDiskLogging();
+	TraceRing::Close();
 
 	if (emuLog != NULL)
 	{
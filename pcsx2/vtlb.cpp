@@ -78,34 +78,14 @@ vtlb_private::VTLBVirtual::VTLBVirtual(VTLBPhysical phys, u32 paddr, u32 vaddr)
 
 __inline int CheckCache(u32 addr)
 {
-	u32 mask;
-
 	if(((cpuRegs.CP0.n.Config >> 16) & 0x1) == 0) 
 	{
 		//DevCon.Warning("Data Cache Disabled! %x", cpuRegs.CP0.n.Config);
 		return false;//
 	}
 
-	for(int i = 1; i < 48; i++)
-	{
-		if (((tlb[i].EntryLo1 & 0x38) >> 3) == 0x3) {
-			mask  = tlb[i].PageMask;
-			
-			if ((addr >= tlb[i].PFN1) && (addr <= tlb[i].PFN1 + mask)) {
-				//DevCon.Warning("Yay! Cache check cache addr=%x, mask=%x, addr+mask=%x, VPN2=%x PFN0=%x", addr, mask, (addr & mask), tlb[i].VPN2, tlb[i].PFN0); 
-				return true;
-			}
-		}
-		if (((tlb[i].EntryLo0 & 0x38) >> 3) == 0x3) {
-			mask  = tlb[i].PageMask;
-			
-			if ((addr >= tlb[i].PFN0) && (addr <= tlb[i].PFN0 + mask)) {
-				//DevCon.Warning("Yay! Cache check cache addr=%x, mask=%x, addr+mask=%x, VPN2=%x PFN0=%x", addr, mask, (addr & mask), tlb[i].VPN2, tlb[i].PFN0); 
-				return true;
-			}
-		}
-	}
-	return false;
+	// Kept up to date by MapTLB
+	return cachedPageMap[addr >> 12];
 }
 // --------------------------------------------------------------------------------------
 // Interpreter Implementations of VTLB Memory Operations.
@@ -120,24 +100,21 @@ DataType __fastcall vtlb_memRead(u32 addr)
 
 	if (!vmv.isHandler(addr))
 	{
-		if (!CHECK_EEREC) 
+		if(CHECK_CACHE && CheckCache(addr)) 
 		{
-			if(CHECK_CACHE && CheckCache(addr)) 
+			switch( DataSize )
 			{
-				switch( DataSize )
-				{
-					case 8: 
-						return readCache8(addr);
-						break;
-					case 16: 
-						return readCache16(addr);
-						break;
-					case 32: 
-						return readCache32(addr);
-						break;
-
-					jNO_DEFAULT;
-				}
+				case 8: 
+					return readCache8(addr);
+					break;
+				case 16: 
+					return readCache16(addr);
+					break;
+				case 32: 
+					return readCache32(addr);
+					break;
+
+				jNO_DEFAULT;
 			}
 		}
 
@@ -170,11 +147,9 @@ RETURNS_R64 vtlb_memRead64(u32 mem)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC) {
-			if(CHECK_CACHE && CheckCache(mem)) 
-			{
-				return readCache64(mem);
-			}
+		if(CHECK_CACHE && CheckCache(mem)) 
+		{
+			return readCache64(mem);
 		}
 
 		return r64_load(reinterpret_cast<const void*>(vmv.assumePtr(mem)));
@@ -194,12 +169,9 @@ RETURNS_R128 vtlb_memRead128(u32 mem)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC) 
+		if(CHECK_CACHE && CheckCache(mem)) 
 		{
-			if(CHECK_CACHE && CheckCache(mem)) 
-			{
-				return readCache128(mem);
-			}
+			return readCache128(mem);
 		}
 
 		return r128_load(reinterpret_cast<const void*>(vmv.assumePtr(mem)));
@@ -222,22 +194,19 @@ void __fastcall vtlb_memWrite(u32 addr, DataType data)
 
 	if (!vmv.isHandler(addr))
 	{		
-		if (!CHECK_EEREC) 
+		if(CHECK_CACHE && CheckCache(addr)) 
 		{
-			if(CHECK_CACHE && CheckCache(addr)) 
+			switch( DataSize )
 			{
-				switch( DataSize )
-				{
-				case 8: 
-					writeCache8(addr, data);
-					return;
-				case 16:
-					writeCache16(addr, data);
-					return;
-				case 32:
-					writeCache32(addr, data);
-					return;
-				}
+			case 8: 
+				writeCache8(addr, data);
+				return;
+			case 16:
+				writeCache16(addr, data);
+				return;
+			case 32:
+				writeCache32(addr, data);
+				return;
 			}
 		}
 
@@ -258,13 +227,10 @@ void __fastcall vtlb_memWrite64(u32 mem, const mem64_t* value)
 
 	if (!vmv.isHandler(mem))
 	{		
-		if (!CHECK_EEREC) 
+		if(CHECK_CACHE && CheckCache(mem)) 
 		{
-			if(CHECK_CACHE && CheckCache(mem)) 
-			{
-				writeCache64(mem, *value);
-				return;
-			}
+			writeCache64(mem, *value);
+			return;
 		}
 
 		*(mem64_t*)vmv.assumePtr(mem) = *value;
@@ -285,13 +251,10 @@ void __fastcall vtlb_memWrite128(u32 mem, const mem128_t *value)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC) 
+		if(CHECK_CACHE && CheckCache(mem)) 
 		{
-			if(CHECK_CACHE && CheckCache(mem)) 
-			{
-				writeCache128(mem, value);
-				return;
-			}
+			writeCache128(mem, value);
+			return;
 		}
 
 		CopyQWC((void*)vmv.assumePtr(mem), value);
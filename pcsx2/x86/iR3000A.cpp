@@ -39,6 +39,7 @@
 
 #include "common/Perf.h"
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/MemoryWatch.h"
 
 using namespace x86Emitter;
 
@@ -103,6 +104,7 @@ static u32 psxdump = 0;
 // =====================================================================================================
 
 static void __fastcall iopRecRecompile(const u32 startpc);
+static void psxRecEventTest();
 
 // Recompiled code buffer for EE recompiler dispatchers!
 static u8 __pagealigned iopRecDispatchers[__pagesize];
@@ -797,6 +799,8 @@ void recResetIOP()
 	recBlocks.Reset();
 	g_psxMaxRecMem = 0;
 
+	MemoryWatch::Reset(BREAKPOINT_IOP, *recMem, recMem->GetPtrEnd());
+
 	recPtr = *recMem;
 	psxbranch = 0;
 }
@@ -1003,7 +1007,13 @@ static void iPsxBranchTest(u32 newpc, u32 cpuBranch)
 		xSUB(ptr32[&iopCycleEE], eax);
 		xJLE(iopExitRecompiledCode);
 
-		xFastCall((void*)iopEventTest);
+		xFastCall((void*)psxRecEventTest);
+		if (CBreakPoints::GetNumMemchecks() != 0)
+		{
+			// get out of here
+			xCMP(ptr8[&iopBreakpoint], 0);
+			xJNE(iopExitRecompiledCode);
+		}
 
 		if (newpc != 0xffffffff)
 		{
@@ -1025,7 +1035,13 @@ static void iPsxBranchTest(u32 newpc, u32 cpuBranch)
 		xSUB(eax, ptr32[&g_iopNextEventCycle]);
 		xForwardJS<u8> nointerruptpending;
 
-		xFastCall((void*)iopEventTest);
+		xFastCall((void*)psxRecEventTest);
+		if (CBreakPoints::GetNumMemchecks() != 0)
+		{
+			// get out of here
+			xCMP(ptr8[&iopBreakpoint], 0);
+			xJNE(iopExitRecompiledCode);
+		}
 
 		if (newpc != 0xffffffff)
 		{
@@ -1150,6 +1166,36 @@ void __fastcall psxDynarecMemLogcheck(u32 start, bool store)
 		DevCon.WriteLn("Hit load breakpoint @0x%x", start);
 }
 
+// Handles the watched pages which faulted since the last event test, see MemoryWatch.h.
+static void psxRecEventTest()
+{
+	iopEventTest();
+
+	MemoryWatch::Fault fault;
+	while (MemoryWatch::TakeFault(BREAKPOINT_IOP, fault))
+	{
+		// The block reported the access itself.
+		if (MemoryWatch::NeedsInlineChecks(BREAKPOINT_IOP, fault.pc))
+			continue;
+
+		const u32 hwpc = HWADDR(fault.pc);
+		if (BASEBLOCKEX* block = recBlocks.Get(hwpc))
+		{
+			const u32 startpc = fault.pc - (hwpc - block->startpc);
+			MemoryWatch::SetInlineChecks(BREAKPOINT_IOP, startpc, startpc + block->size * 4);
+			recClearIOP(startpc, block->size);
+		}
+
+		const MemCheckResult result = MemoryWatch::GetFaultResult(BREAKPOINT_IOP, fault);
+		if (result & MEMCHECK_LOG)
+			psxDynarecMemLogcheck(fault.addr, fault.write);
+		if (result & MEMCHECK_BREAK)
+			psxDynarecMemcheck();
+	}
+
+	MemoryWatch::Rearm(BREAKPOINT_IOP);
+}
+
 void psxRecMemcheck(u32 op, u32 bits, bool store)
 {
 	_psxFlushCall(FLUSH_EVERYTHING | FLUSH_PC);
@@ -201,13 +201,12 @@ void recCOP1_Unknown()
 **********************************************************/
 
 // Suikoden 3 uses it a lot
-void recCACHE() //Interpreter only!
+// Only does something when the data cache is emulated, in which case the interpreter's
+// version keeps the cache's state right.
+void recCACHE()
 {
-	//xMOV(ptr32[&cpuRegs.code], (u32)cpuRegs.code );
-	//xMOV(ptr32[&cpuRegs.pc], (u32)pc );
-	//iFlushCall(FLUSH_EVERYTHING);
-	//xFastCall((void*)(uptr)R5900::Interpreter::OpcodeImpl::CACHE );
-	//branch = 2;
+	if (CHECK_CACHE)
+		recCall(R5900::Interpreter::OpcodeImpl::CACHE);
 }
 
 void recTGE()
@@ -33,6 +33,7 @@
 #include "Elfheader.h"
 
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/MemoryWatch.h"
 #include "Patch.h"
 
 #if !PCSX2_SEH
@@ -111,6 +112,7 @@ static u32 dumplog = 0;
 #endif
 
 static void iBranchTest(u32 newpc = 0xffffffff);
+static void recCheckMemoryWatch();
 static void ClearRecLUT(BASEBLOCK* base, int count);
 static u32 scaleblockcycles();
 static void recExitExecution();
@@ -372,6 +374,7 @@ static DynGenFunc* DispatchPageReset    = NULL;
 static void recEventTest()
 {
 	_cpuEventTest_Shared();
+	recCheckMemoryWatch();
 
 	if (iopBreakpoint)
 	{
@@ -658,6 +661,7 @@ static void recResetRaw()
 
 	recBlocks.Reset();
 	mmap_ResetBlockTracking();
+	MemoryWatch::Reset(BREAKPOINT_EE, *recMem, recMem->GetPtrEnd());
 
 	x86SetPtr(*recMem);
 
@@ -1330,6 +1334,36 @@ void __fastcall dynarecMemLogcheck(u32 start, bool store)
 		DevCon.WriteLn("Hit load breakpoint @0x%x", start);
 }
 
+// Handles the watched pages which faulted since the last event test.  Blocks which ran
+// into a watched page are recompiled with inline checks, see MemoryWatch.h.
+static void recCheckMemoryWatch()
+{
+	MemoryWatch::Fault fault;
+	while (MemoryWatch::TakeFault(BREAKPOINT_EE, fault))
+	{
+		// The block reported the access itself.
+		if (MemoryWatch::NeedsInlineChecks(BREAKPOINT_EE, fault.pc))
+			continue;
+
+		const u32 hwpc = HWADDR(fault.pc);
+		if (BASEBLOCKEX* block = recBlocks.Get(hwpc))
+		{
+			const u32 startpc = fault.pc - (hwpc - block->startpc);
+			MemoryWatch::SetInlineChecks(BREAKPOINT_EE, startpc, startpc + block->size * 4);
+			recClear(startpc, block->size);
+		}
+
+		const MemCheckResult result = MemoryWatch::GetFaultResult(BREAKPOINT_EE, fault);
+		if (result & MEMCHECK_LOG)
+			dynarecMemLogcheck(fault.addr, fault.write);
+		// Leaves the recompiled code, the pages are protected again by the next event test.
+		if (result & MEMCHECK_BREAK)
+			dynarecMemcheck();
+	}
+
+	MemoryWatch::Rearm(BREAKPOINT_EE);
+}
+
 void recMemcheck(u32 op, u32 bits, bool store)
 {
 	iFlushCall(FLUSH_EVERYTHING | FLUSH_PC);
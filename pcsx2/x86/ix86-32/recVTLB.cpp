@@ -18,6 +18,7 @@
 
 #include "Common.h"
 #include "vtlb.h"
+#include "Cache.h"
 
 #include "iCore.h"
 #include "iR5900.h"
@@ -244,6 +245,98 @@ namespace vtlb_private
 				break;
 		}
 	}
+
+	// ------------------------------------------------------------------------
+	// Sign or zero extends an 8 or 16 bit result returned in eax by a C++ function.
+	static void DynGen_ExtendResult(u32 bits, bool sign)
+	{
+		if (bits == 8)
+		{
+			if (sign)
+				xMOVSX(eax, al);
+			else
+				xMOVZX(eax, al);
+		}
+		else if (bits == 16)
+		{
+			if (sign)
+				xMOVSX(eax, ax);
+			else
+				xMOVZX(eax, ax);
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	// The vtlb memory function doing the same access as the recompiled code, which goes
+	// through the EE cache for cached pages.
+	static void* DynGen_CachedAccessFunc(u32 bits, bool write)
+	{
+		switch (bits)
+		{
+			case   8: return write ? (void*)vtlb_memWrite<mem8_t>  : (void*)vtlb_memRead<mem8_t>;
+			case  16: return write ? (void*)vtlb_memWrite<mem16_t> : (void*)vtlb_memRead<mem16_t>;
+			case  32: return write ? (void*)vtlb_memWrite<mem32_t> : (void*)vtlb_memRead<mem32_t>;
+			case  64: return write ? (void*)vtlb_memWrite64        : (void*)vtlb_memRead64;
+			case 128: return write ? (void*)vtlb_memWrite128       : (void*)vtlb_memRead128;
+			jNO_DEFAULT
+		}
+		return nullptr;
+	}
+
+	// ------------------------------------------------------------------------
+	// With EE cache emulation, accesses to pages that the TLB maps as cached have to go
+	// through the cache model.  Emits a test of cachedPageMap in front of the given fast
+	// path, which sends those to the vtlb memory functions instead.  Everything else only
+	// pays for the test.
+	//
+	// In: arg1reg: address (unless addr_const is given), arg2reg: data or data pointer
+	// Out: eax or xmm0, like the indirect handlers.  Clobbers eax and arg3reg.
+	template <typename FastPath>
+	static void DynGen_CachedAccess(u32 bits, bool sign, bool write, const FastPath& fastPath, const u32* addr_const = nullptr)
+	{
+		if (!CHECK_CACHE)
+		{
+			fastPath();
+			return;
+		}
+
+		if (addr_const)
+		{
+			xCMP(ptr8[&cachedPageMap[*addr_const >> 12]], 0);
+		}
+		else
+		{
+			xMOV(eax, arg1regd);
+			xSHR(eax, 12);
+			xCMP(ptr8[xComplexAddress(arg3reg, cachedPageMap, rax)], 0);
+		}
+		xForwardJNZ32 cached;
+
+		fastPath();
+		xForwardJump32 done;
+
+		cached.SetTarget();
+		void* func = DynGen_CachedAccessFunc(bits, write);
+		if (addr_const)
+		{
+			if (write)
+				xFastCall(func, *addr_const, arg2reg);
+			else
+				xFastCall(func, *addr_const);
+		}
+		else
+		{
+			if (write)
+				xFastCall(func, arg1reg, arg2reg);
+			else
+				xFastCall(func, arg1reg);
+		}
+
+		if (!write)
+			DynGen_ExtendResult(bits, sign);
+
+		done.SetTarget();
+	}
 } // namespace vtlb_private
 
 // ------------------------------------------------------------------------
@@ -390,11 +483,14 @@ int vtlb_DynGenRead64(u32 bits, int gpr)
 {
 	pxAssume(bits == 64 || bits == 128);
 
-	u32* writeback = DynGen_PrepRegs();
-
 	int reg = gpr == -1 ? _allocTempXMMreg(XMMT_INT, 0) : _allocGPRtoXMMreg(0, gpr, MODE_WRITE); // Handler returns in xmm0
-	DynGen_IndirectDispatch(0, bits);
-	DynGen_DirectRead64(bits);
+
+	u32* writeback;
+	DynGen_CachedAccess(bits, false, false, [&]() {
+		writeback = DynGen_PrepRegs();
+		DynGen_IndirectDispatch(0, bits);
+		DynGen_DirectRead64(bits);
+	});
 
 	vtlb_SetWriteback(writeback); // return target for indirect's call/ret
 	return reg;
@@ -408,10 +504,12 @@ void vtlb_DynGenRead32(u32 bits, bool sign)
 {
 	pxAssume(bits <= 32);
 
-	u32* writeback = DynGen_PrepRegs();
-
-	DynGen_IndirectDispatch(0, bits, sign && bits < 32);
-	DynGen_DirectRead(bits, sign);
+	u32* writeback;
+	DynGen_CachedAccess(bits, sign, false, [&]() {
+		writeback = DynGen_PrepRegs();
+		DynGen_IndirectDispatch(0, bits, sign && bits < 32);
+		DynGen_DirectRead(bits, sign);
+	});
 
 	vtlb_SetWriteback(writeback);
 }
@@ -428,19 +526,31 @@ int vtlb_DynGenRead64_Const(u32 bits, u32 addr_const, int gpr)
 	if (!vmv.isHandler(addr_const))
 	{
 		void* ppf = reinterpret_cast<void*>(vmv.assumePtr(addr_const));
-		reg = gpr == -1 ? _allocTempXMMreg(XMMT_INT, -1) : _allocGPRtoXMMreg(-1, gpr, MODE_WRITE);
-		switch (bits)
+		if (CHECK_CACHE)
 		{
-			case 64:
-				xMOVQZX(xRegisterSSE(reg), ptr64[ppf]);
-				break;
+			// Both paths leave the value in xmm0, as the cache's path is a call.
+			iFlushCall(FLUSH_FULLVTLB);
+			reg = gpr == -1 ? _allocTempXMMreg(XMMT_INT, 0) : _allocGPRtoXMMreg(0, gpr, MODE_WRITE);
+		}
+		else
+		{
+			reg = gpr == -1 ? _allocTempXMMreg(XMMT_INT, -1) : _allocGPRtoXMMreg(-1, gpr, MODE_WRITE);
+		}
 
-			case 128:
-				xMOVAPS(xRegisterSSE(reg), ptr128[ppf]);
-				break;
+		DynGen_CachedAccess(bits, false, false, [&]() {
+			switch (bits)
+			{
+				case 64:
+					xMOVQZX(xRegisterSSE(reg), ptr64[ppf]);
+					break;
 
-			jNO_DEFAULT
-		}
+				case 128:
+					xMOVAPS(xRegisterSSE(reg), ptr128[ppf]);
+					break;
+
+				jNO_DEFAULT
+			}
+		}, &addr_const);
 	}
 	else
 	{
@@ -477,26 +587,31 @@ void vtlb_DynGenRead32_Const(u32 bits, bool sign, u32 addr_const)
 	if (!vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
-		switch (bits)
-		{
-			case 8:
-				if (sign)
-					xMOVSX(eax, ptr8[(u8*)ppf]);
-				else
-					xMOVZX(eax, ptr8[(u8*)ppf]);
-				break;
-
-			case 16:
-				if (sign)
-					xMOVSX(eax, ptr16[(u16*)ppf]);
-				else
-					xMOVZX(eax, ptr16[(u16*)ppf]);
-				break;
+		if (CHECK_CACHE)
+			iFlushCall(FLUSH_FULLVTLB);
 
-			case 32:
-				xMOV(eax, ptr32[(u32*)ppf]);
-				break;
-		}
+		DynGen_CachedAccess(bits, sign, false, [&]() {
+			switch (bits)
+			{
+				case 8:
+					if (sign)
+						xMOVSX(eax, ptr8[(u8*)ppf]);
+					else
+						xMOVZX(eax, ptr8[(u8*)ppf]);
+					break;
+
+				case 16:
+					if (sign)
+						xMOVSX(eax, ptr16[(u16*)ppf]);
+					else
+						xMOVZX(eax, ptr16[(u16*)ppf]);
+					break;
+
+				case 32:
+					xMOV(eax, ptr32[(u32*)ppf]);
+					break;
+			}
+		}, &addr_const);
 	}
 	else
 	{
@@ -546,10 +661,12 @@ void vtlb_DynGenRead32_Const(u32 bits, bool sign, u32 addr_const)
 
 void vtlb_DynGenWrite(u32 sz)
 {
-	u32* writeback = DynGen_PrepRegs();
-
-	DynGen_IndirectDispatch(1, sz);
-	DynGen_DirectWrite(sz);
+	u32* writeback;
+	DynGen_CachedAccess(sz, false, true, [&]() {
+		writeback = DynGen_PrepRegs();
+		DynGen_IndirectDispatch(1, sz);
+		DynGen_DirectWrite(sz);
+	});
 
 	vtlb_SetWriteback(writeback);
 }
@@ -568,30 +685,35 @@ void vtlb_DynGenWrite_Const(u32 bits, u32 addr_const)
 	{
 		// TODO: x86Emitter can't use dil
 		auto ppf = vmv.assumePtr(addr_const);
-		switch (bits)
-		{
-			//8 , 16, 32 : data on arg2
-			case 8:
-				xMOV(edx, arg2regd);
-				xMOV(ptr[(void*)ppf], dl);
-				break;
-
-			case 16:
-				xMOV(ptr[(void*)ppf], xRegister16(arg2reg));
-				break;
-
-			case 32:
-				xMOV(ptr[(void*)ppf], arg2regd);
-				break;
-
-			case 64:
-				iMOV64_Smart(ptr[(void*)ppf], ptr[arg2reg]);
-				break;
+		if (CHECK_CACHE)
+			iFlushCall(FLUSH_FULLVTLB);
 
-			case 128:
-				iMOV128_SSE(ptr[(void*)ppf], ptr[arg2reg]);
-				break;
-		}
+		DynGen_CachedAccess(bits, false, true, [&]() {
+			switch (bits)
+			{
+				//8 , 16, 32 : data on arg2
+				case 8:
+					xMOV(edx, arg2regd);
+					xMOV(ptr[(void*)ppf], dl);
+					break;
+
+				case 16:
+					xMOV(ptr[(void*)ppf], xRegister16(arg2reg));
+					break;
+
+				case 32:
+					xMOV(ptr[(void*)ppf], arg2regd);
+					break;
+
+				case 64:
+					iMOV64_Smart(ptr[(void*)ppf], ptr[arg2reg]);
+					break;
+
+				case 128:
+					iMOV128_SSE(ptr[(void*)ppf], ptr[arg2reg]);
+					break;
+			}
+		}, &addr_const);
 	}
 	else
 	{
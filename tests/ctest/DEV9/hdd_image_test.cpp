@@ -0,0 +1,263 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "DEV9/ATA/HddImage.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+	const u32 BlockSize = HddSparseImage::BlockSize;
+	const u64 BlockCountOffset = 24;
+	const u64 MapOffset = 512;
+
+	class HddImageTest : public ::testing::Test
+	{
+	protected:
+		std::vector<ghc::filesystem::path> files;
+
+		ghc::filesystem::path TempFile(const char* name)
+		{
+			ghc::filesystem::path path = ghc::filesystem::current_path() / name;
+			ghc::filesystem::remove(path);
+			files.push_back(path);
+			return path;
+		}
+
+		void TearDown() override
+		{
+			for (const ghc::filesystem::path& path : files)
+				ghc::filesystem::remove(path);
+		}
+
+		static void Patch(const ghc::filesystem::path& path, u64 offset, u32 value)
+		{
+			std::fstream file = ghc::filesystem::fstream(path, std::ios::in | std::ios::out | std::ios::binary);
+			file.seekp(offset, std::ios::beg);
+			file.write((const char*)&value, sizeof(value));
+			ASSERT_FALSE(file.fail());
+		}
+
+		static std::vector<u8> Pattern(u32 length, u8 seed)
+		{
+			std::vector<u8> data(length);
+			for (u32 i = 0; i < length; i++)
+				data[i] = (u8)(i * 7 + seed);
+			return data;
+		}
+	};
+} // namespace
+
+TEST_F(HddImageTest, ReadWriteAcrossBlocks)
+{
+	const ghc::filesystem::path path = TempFile("hdd_image_test.sphdd");
+	ASSERT_TRUE(HddSparseImage::Create(path, 4 * BlockSize));
+
+	//Straddles the boundary between blocks 0 and 1, and ends inside block 2
+	const std::vector<u8> data = Pattern(BlockSize + 512, 1);
+	const u64 offset = BlockSize - 256;
+	{
+		HddSparseImage image;
+		ASSERT_TRUE(image.Open(path, false));
+		EXPECT_EQ(image.GetSize(), 4 * BlockSize);
+		ASSERT_TRUE(image.Write(offset, data.data(), (u32)data.size()));
+		ASSERT_TRUE(image.Flush());
+	}
+
+	std::unique_ptr<HddImage> image = HddImage::Open(path, true);
+	ASSERT_NE(image, nullptr);
+
+	std::vector<u8> read(data.size());
+	ASSERT_TRUE(image->Read(offset, read.data(), (u32)read.size()));
+	EXPECT_EQ(read, data);
+
+	//Untouched parts read as zeros
+	std::vector<u8> zeros(BlockSize);
+	ASSERT_TRUE(image->Read(3 * BlockSize, zeros.data(), BlockSize));
+	EXPECT_EQ(zeros, std::vector<u8>(BlockSize, 0));
+	ASSERT_TRUE(image->Read(0, zeros.data(), 256));
+	EXPECT_EQ(std::vector<u8>(zeros.begin(), zeros.begin() + 256), std::vector<u8>(256, 0));
+
+	//Three blocks touched, three blocks stored
+	EXPECT_EQ(ghc::filesystem::file_size(path), 4096 + 3 * BlockSize);
+
+	EXPECT_FALSE(image->Read(4 * BlockSize - 1, read.data(), 2));
+}
+
+TEST_F(HddImageTest, CopyOnWriteOverBase)
+{
+	const ghc::filesystem::path basePath = TempFile("hdd_image_test.base.raw");
+	const ghc::filesystem::path path = TempFile("hdd_image_test.sphdd");
+
+	const std::vector<u8> baseData = Pattern(2 * BlockSize, 3);
+	{
+		std::fstream base = ghc::filesystem::fstream(basePath, std::ios::out | std::ios::binary);
+		base.write((const char*)baseData.data(), baseData.size());
+	}
+	ASSERT_TRUE(HddSparseImage::Create(path, baseData.size(), basePath));
+
+	const std::vector<u8> data = Pattern(16, 200);
+	{
+		HddSparseImage image;
+		ASSERT_TRUE(image.Open(path, false));
+		ASSERT_TRUE(image.Write(BlockSize + 100, data.data(), (u32)data.size()));
+		ASSERT_TRUE(image.Flush());
+	}
+
+	HddSparseImage image;
+	ASSERT_TRUE(image.Open(path, true));
+
+	//The written block keeps the base contents around the write
+	std::vector<u8> expected = baseData;
+	std::copy(data.begin(), data.end(), expected.begin() + BlockSize + 100);
+	std::vector<u8> read(expected.size());
+	ASSERT_TRUE(image.Read(0, read.data(), (u32)read.size()));
+	EXPECT_EQ(read, expected);
+
+	//And the base is left alone
+	std::vector<u8> base(baseData.size());
+	std::fstream baseFile = ghc::filesystem::fstream(basePath, std::ios::in | std::ios::binary);
+	baseFile.read((char*)base.data(), base.size());
+	EXPECT_EQ(base, baseData);
+
+	EXPECT_FALSE(image.Write(0, data.data(), (u32)data.size()));
+}
+
+TEST_F(HddImageTest, ConvertSkipsZeroBlocks)
+{
+	const ghc::filesystem::path rawPath = TempFile("hdd_image_test.raw");
+	const ghc::filesystem::path path = TempFile("hdd_image_test.sphdd");
+
+	//Only block 2 of 5 holds data, the last block is partial
+	std::vector<u8> rawData(4 * BlockSize + 512, 0);
+	const std::vector<u8> data = Pattern(BlockSize, 5);
+	std::copy(data.begin(), data.end(), rawData.begin() + 2 * BlockSize);
+	{
+		std::fstream raw = ghc::filesystem::fstream(rawPath, std::ios::out | std::ios::binary);
+		raw.write((const char*)rawData.data(), rawData.size());
+	}
+
+	u64 lastDone = 0;
+	u64 reportedTotal = 0;
+	ASSERT_TRUE(HddSparseImage::Convert(rawPath, path, [&](u64 done, u64 total) {
+		lastDone = done;
+		reportedTotal = total;
+		return true;
+	}));
+	EXPECT_EQ(reportedTotal, rawData.size());
+	EXPECT_EQ(lastDone, 4 * BlockSize);
+
+	EXPECT_EQ(ghc::filesystem::file_size(path), 4096 + BlockSize);
+
+	HddSparseImage image;
+	ASSERT_TRUE(image.Open(path, true));
+	EXPECT_EQ(image.GetSize(), rawData.size());
+	std::vector<u8> read(rawData.size());
+	ASSERT_TRUE(image.Read(0, read.data(), (u32)read.size()));
+	EXPECT_EQ(read, rawData);
+}
+
+TEST_F(HddImageTest, ConvertCanBeCanceled)
+{
+	const ghc::filesystem::path rawPath = TempFile("hdd_image_test.raw");
+	const ghc::filesystem::path path = TempFile("hdd_image_test.sphdd");
+	{
+		const std::vector<u8> rawData = Pattern(2 * BlockSize, 9);
+		std::fstream raw = ghc::filesystem::fstream(rawPath, std::ios::out | std::ios::binary);
+		raw.write((const char*)rawData.data(), rawData.size());
+	}
+
+	EXPECT_FALSE(HddSparseImage::Convert(rawPath, path, [](u64 done, u64) { return done == 0; }));
+	EXPECT_FALSE(ghc::filesystem::exists(path));
+}
+
+TEST_F(HddImageTest, OpenRejectsTruncatedMap)
+{
+	const ghc::filesystem::path path = TempFile("hdd_image_test.sphdd");
+	ASSERT_TRUE(HddSparseImage::Create(path, 4 * BlockSize));
+	ghc::filesystem::resize_file(path, MapOffset + 8);
+
+	HddSparseImage image;
+	EXPECT_FALSE(image.Open(path, true));
+}
+
+TEST_F(HddImageTest, OpenRejectsBadBlockCount)
+{
+	const ghc::filesystem::path path = TempFile("hdd_image_test.sphdd");
+	ASSERT_TRUE(HddSparseImage::Create(path, 4 * BlockSize));
+	Patch(path, BlockCountOffset, 5);
+
+	HddSparseImage image;
+	EXPECT_FALSE(image.Open(path, true));
+}
+
+TEST_F(HddImageTest, OpenRejectsMapEntryPastData)
+{
+	const ghc::filesystem::path path = TempFile("hdd_image_test.sphdd");
+	ASSERT_TRUE(HddSparseImage::Create(path, 4 * BlockSize));
+	{
+		HddSparseImage image;
+		ASSERT_TRUE(image.Open(path, false));
+		const std::vector<u8> data = Pattern(16, 0);
+		ASSERT_TRUE(image.Write(0, data.data(), (u32)data.size()));
+	}
+
+	//One block is stored, block 1 claims the second
+	Patch(path, MapOffset + sizeof(u32), 2);
+	HddSparseImage image;
+	EXPECT_FALSE(image.Open(path, true));
+
+	Patch(path, MapOffset + sizeof(u32), 1);
+	EXPECT_TRUE(image.Open(path, true));
+}
+
+TEST_F(HddImageTest, OpenRejectsBaseLoops)
+{
+	const ghc::filesystem::path pathA = TempFile("hdd_image_test_a.sphdd");
+	const ghc::filesystem::path pathB = TempFile("hdd_image_test_b.sphdd");
+
+	//A uses B as its base and B uses A, created in two steps as A must exist first
+	ASSERT_TRUE(HddSparseImage::Create(pathA, BlockSize));
+	ASSERT_TRUE(HddSparseImage::Create(pathB, BlockSize, pathA));
+	ghc::filesystem::remove(pathA);
+	ASSERT_TRUE(HddSparseImage::Create(pathA, BlockSize, pathB));
+
+	HddSparseImage image;
+	EXPECT_FALSE(image.Open(pathA, true));
+	EXPECT_EQ(HddImage::Open(pathB, true), nullptr);
+
+	//Including an image that is its own base
+	const ghc::filesystem::path pathC = TempFile("hdd_image_test_c.sphdd");
+	ASSERT_TRUE(HddSparseImage::Create(pathC, BlockSize, pathC));
+	EXPECT_EQ(HddImage::Open(pathC, true), nullptr);
+}
+
+TEST_F(HddImageTest, OpenRejectsDeepBaseChains)
+{
+	ghc::filesystem::path below = TempFile("hdd_image_test_0.sphdd");
+	ASSERT_TRUE(HddSparseImage::Create(below, BlockSize));
+
+	for (u32 i = 1; i <= HddSparseImage::MaxBaseDepth; i++)
+	{
+		//The top of the chain is one level deeper than allowed
+		EXPECT_NE(HddImage::Open(below, true), nullptr);
+
+		const std::string name = "hdd_image_test_" + std::to_string(i) + ".sphdd";
+		const ghc::filesystem::path above = TempFile(name.c_str());
+		ASSERT_TRUE(HddSparseImage::Create(above, BlockSize, below));
+		below = above;
+	}
+	EXPECT_EQ(HddImage::Open(below, true), nullptr);
+}
@@ -0,0 +1,131 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "DEV9/SimpleQueue.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(SimpleRingQueueTest, FullAndEmpty)
+{
+	SimpleRingQueue<u32, 8> queue;
+	u32 value;
+
+	EXPECT_TRUE(queue.IsQueueEmpty());
+	EXPECT_FALSE(queue.Dequeue(&value));
+
+	for (u32 i = 0; i < 8; i++)
+	{
+		EXPECT_TRUE(queue.Enqueue(i));
+		EXPECT_EQ(queue.GetDepth(), i + 1);
+	}
+	EXPECT_FALSE(queue.Enqueue(8));
+	EXPECT_EQ(queue.GetDepth(), 8u);
+
+	// One slot frees up one entry
+	EXPECT_TRUE(queue.Dequeue(&value));
+	EXPECT_EQ(value, 0u);
+	EXPECT_TRUE(queue.Enqueue(8));
+	EXPECT_FALSE(queue.Enqueue(9));
+
+	for (u32 i = 1; i <= 8; i++)
+	{
+		EXPECT_TRUE(queue.Dequeue(&value));
+		EXPECT_EQ(value, i);
+	}
+	EXPECT_TRUE(queue.IsQueueEmpty());
+	EXPECT_FALSE(queue.Dequeue(&value));
+}
+
+TEST(SimpleRingQueueTest, WrapAround)
+{
+	SimpleRingQueue<u32, 4> queue;
+	u32 next_in = 0, next_out = 0;
+
+	// Odd fill levels, so the entries keep landing on different slots
+	for (int round = 0; round < 100; round++)
+	{
+		for (int i = 0; i < 3; i++)
+			ASSERT_TRUE(queue.Enqueue(next_in++));
+		for (int i = 0; i < 2; i++)
+		{
+			u32 value;
+			ASSERT_TRUE(queue.Dequeue(&value));
+			ASSERT_EQ(value, next_out++);
+		}
+		u32 value;
+		ASSERT_TRUE(queue.Dequeue(&value));
+		ASSERT_EQ(value, next_out++);
+	}
+	EXPECT_TRUE(queue.IsQueueEmpty());
+}
+
+TEST(SimpleRingQueueTest, DequeueBatch)
+{
+	SimpleRingQueue<u32, 8> queue;
+	u32 batch[8];
+
+	EXPECT_EQ(queue.DequeueBatch(batch, 8), 0u);
+
+	// Push the positions past the end of the buffer first
+	for (u32 i = 0; i < 6; i++)
+		queue.Enqueue(100 + i);
+	EXPECT_EQ(queue.DequeueBatch(batch, 6), 6u);
+
+	// This batch straddles the end of the buffer
+	for (u32 i = 0; i < 7; i++)
+		EXPECT_TRUE(queue.Enqueue(i));
+
+	EXPECT_EQ(queue.DequeueBatch(batch, 3), 3u);
+	for (u32 i = 0; i < 3; i++)
+		EXPECT_EQ(batch[i], i);
+	EXPECT_EQ(queue.GetDepth(), 4u);
+
+	// Only what's queued is returned
+	EXPECT_EQ(queue.DequeueBatch(batch, 8), 4u);
+	for (u32 i = 0; i < 4; i++)
+		EXPECT_EQ(batch[i], i + 3);
+	EXPECT_TRUE(queue.IsQueueEmpty());
+
+	EXPECT_EQ(queue.DequeueBatch(batch, 0), 0u);
+}
+
+TEST(SimpleRingQueueTest, TwoThreads)
+{
+	static constexpr u32 Count = 200000;
+	SimpleRingQueue<u32, 16> queue;
+
+	std::thread producer([&queue] {
+		for (u32 i = 0; i < Count; i++)
+		{
+			while (!queue.Enqueue(i))
+				std::this_thread::yield();
+		}
+	});
+
+	u32 expected = 0;
+	u32 batch[5];
+	while (expected < Count)
+	{
+		const u32 count = queue.DequeueBatch(batch, 5);
+		if (count == 0)
+			std::this_thread::yield();
+		for (u32 i = 0; i < count; i++)
+			ASSERT_EQ(batch[i], expected++);
+	}
+
+	producer.join();
+	EXPECT_TRUE(queue.IsQueueEmpty());
+}
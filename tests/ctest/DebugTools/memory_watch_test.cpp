@@ -0,0 +1,155 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "DebugTools/MemoryWatch.h"
+#include "Memory.h"
+#include "IopMem.h"
+#include <gtest/gtest.h>
+
+// Breakpoints.cpp drags the debugger UI in, these are the parts MemoryWatch uses.
+static std::vector<MemCheck> s_memchecks;
+
+MemCheck::MemCheck()
+	: start(0)
+	, end(0)
+	, cond(MEMCHECK_READWRITE)
+	, result(MEMCHECK_BOTH)
+	, cpu(BREAKPOINT_EE)
+	, lastPC(0)
+	, lastAddr(0)
+	, lastSize(0)
+{
+	numHits = 0;
+}
+
+const std::vector<MemCheck> CBreakPoints::GetMemChecks()
+{
+	return s_memchecks;
+}
+
+u32 __fastcall standardizeBreakpointAddressEE(u32 addr)
+{
+	return addr & 0x7FFFFFFF;
+}
+
+namespace
+{
+	class MemoryWatchTest : public ::testing::Test
+	{
+	protected:
+		// Stands in for the recompilers' code cache
+		u8 code[64];
+
+		void SetUp() override
+		{
+			eeMem = (EEVM_MemoryAllocMess*)_aligned_malloc(sizeof(EEVM_MemoryAllocMess), __pagesize);
+			iopMem = (IopVM_MemoryAllocMess*)_aligned_malloc(sizeof(IopVM_MemoryAllocMess), __pagesize);
+			EmuConfig.Cpu.Recompiler.EnableEE = true;
+			EmuConfig.Cpu.Recompiler.EnableIOP = true;
+		}
+
+		void TearDown() override
+		{
+			s_memchecks.clear();
+			MemoryWatch::Reset(BREAKPOINT_EE, code, code + sizeof(code));
+			MemoryWatch::Reset(BREAKPOINT_IOP, code, code + sizeof(code));
+			_aligned_free(eeMem);
+			_aligned_free(iopMem);
+			eeMem = nullptr;
+			iopMem = nullptr;
+		}
+
+		static void AddMemCheck(BreakPointCpu cpu, u32 start, u32 end, MemCheckCondition cond)
+		{
+			MemCheck check;
+			check.cpu = cpu;
+			check.start = start;
+			check.end = end;
+			check.cond = cond;
+			check.result = MEMCHECK_BOTH;
+			s_memchecks.push_back(check);
+		}
+	};
+} // namespace
+
+TEST_F(MemoryWatchTest, IopLoadIsCheckedInline)
+{
+	// A read check on IOP ram, and a block which loads from it
+	AddMemCheck(BREAKPOINT_IOP, 0x00001000, 0x00001004, MEMCHECK_READ);
+	MemoryWatch::Reset(BREAKPOINT_IOP, code, code + sizeof(code));
+
+	// The recompiled load goes through iopMemRead32, a page fault couldn't be traced back to
+	// it, so every block has to check its accesses from the start.
+	EXPECT_TRUE(MemoryWatch::NeedsInlineChecks(BREAKPOINT_IOP, 0x00020000));
+	EXPECT_TRUE(MemoryWatch::NeedsInlineChecks(BREAKPOINT_IOP, 0xBFC00000));
+
+	// And the page isn't protected behind the helpers' backs
+	const PageProtectionMode access = MemoryWatch::GetPageAccess(BREAKPOINT_IOP, 1, PageAccess_ReadWrite());
+	EXPECT_TRUE(access.CanRead());
+	EXPECT_TRUE(access.CanWrite());
+	EXPECT_FALSE(MemoryWatch::HandlePageFault((uptr)&iopMem->Main[0x1000], (uptr)code));
+
+	// The EE isn't affected
+	EXPECT_FALSE(MemoryWatch::NeedsInlineChecks(BREAKPOINT_EE, 0x00100000));
+}
+
+TEST_F(MemoryWatchTest, IopInterpreterChecksEverything)
+{
+	EmuConfig.Cpu.Recompiler.EnableIOP = false;
+	AddMemCheck(BREAKPOINT_IOP, 0x00001000, 0x00001004, MEMCHECK_WRITE);
+	MemoryWatch::Reset(BREAKPOINT_IOP, code, code + sizeof(code));
+
+	EXPECT_TRUE(MemoryWatch::NeedsInlineChecks(BREAKPOINT_IOP, 0x00020000));
+}
+
+TEST_F(MemoryWatchTest, EeRamIsWatchedWithPages)
+{
+	AddMemCheck(BREAKPOINT_EE, 0x00101000, 0x00101010, MEMCHECK_WRITE);
+	AddMemCheck(BREAKPOINT_EE, 0x80203000, 0x80203004, MEMCHECK_READ);
+	MemoryWatch::Reset(BREAKPOINT_EE, code, code + sizeof(code));
+
+	EXPECT_FALSE(MemoryWatch::NeedsInlineChecks(BREAKPOINT_EE, 0x00100000));
+
+	PageProtectionMode access = MemoryWatch::GetPageAccess(BREAKPOINT_EE, 0x101, PageAccess_ReadWrite());
+	EXPECT_TRUE(access.CanRead());
+	EXPECT_FALSE(access.CanWrite());
+	access = MemoryWatch::GetPageAccess(BREAKPOINT_EE, 0x203, PageAccess_ReadWrite());
+	EXPECT_TRUE(access.IsNone());
+	access = MemoryWatch::GetPageAccess(BREAKPOINT_EE, 0x102, PageAccess_ReadWrite());
+	EXPECT_TRUE(access.CanWrite());
+
+	// Blocks only switch to inline checks once they hit a watched page
+	MemoryWatch::SetInlineChecks(BREAKPOINT_EE, 0x00100000, 0x00100040);
+	EXPECT_TRUE(MemoryWatch::NeedsInlineChecks(BREAKPOINT_EE, 0x0010003C));
+	EXPECT_FALSE(MemoryWatch::NeedsInlineChecks(BREAKPOINT_EE, 0x00100040));
+}
+
+TEST_F(MemoryWatchTest, EeFaultOutsideRecompiledCodeIsNotReported)
+{
+	AddMemCheck(BREAKPOINT_EE, 0x00101000, 0x00101010, MEMCHECK_WRITE);
+	MemoryWatch::Reset(BREAKPOINT_EE, code, code + sizeof(code));
+
+	// A DMA or HLE helper writing the page: it's let through without a hit
+	u8 helper[16];
+	EXPECT_TRUE(MemoryWatch::HandlePageFault((uptr)&eeMem->Main[0x101008], (uptr)helper));
+	MemoryWatch::Fault fault;
+	EXPECT_FALSE(MemoryWatch::TakeFault(BREAKPOINT_EE, fault));
+	EXPECT_TRUE(MemoryWatch::GetPageAccess(BREAKPOINT_EE, 0x101, PageAccess_ReadWrite()).CanWrite());
+
+	// Until it's protected again
+	MemoryWatch::Rearm(BREAKPOINT_EE);
+	EXPECT_FALSE(MemoryWatch::GetPageAccess(BREAKPOINT_EE, 0x101, PageAccess_ReadWrite()).CanWrite());
+}
@@ -0,0 +1,197 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// No PrecompiledHeader.h, TraceFormat is built without the rest of pcsx2.
+
+#include "pcsx2/DebugTools/TraceFormat.h"
+#include <gtest/gtest.h>
+#include <cstdarg>
+#include <cstring>
+#include <zlib.h>
+
+using namespace TraceFormat;
+
+namespace
+{
+	// Builds a trace file the same way TraceRing does, with the argument encoding shared with it.
+	class TraceWriter
+	{
+		std::vector<u8> m_data;
+		std::vector<std::vector<Spec>> m_specs;
+
+		void Entry(u32 id, const void* payload, u32 payload_size)
+		{
+			const EntryHeader header = {Align(sizeof(EntryHeader) + payload_size), id};
+			const size_t pos = m_data.size();
+			m_data.resize(pos + header.size, 0);
+			memcpy(&m_data[pos], &header, sizeof(header));
+			memcpy(&m_data[pos + sizeof(header)], payload, payload_size);
+		}
+
+	public:
+		TraceWriter()
+		{
+			const FileHeader header = {{'P', 'S', '2', 'T', 'R', 'A', 'C', 'E'}, Version, 0};
+			m_data.resize(sizeof(header));
+			memcpy(m_data.data(), &header, sizeof(header));
+		}
+
+		u32 Define(const char* fmt)
+		{
+			const u32 id = static_cast<u32>(m_specs.size());
+			m_specs.push_back(ParseFormat(fmt));
+
+			std::vector<u8> payload(sizeof(id) + strlen(fmt) + 1, 0);
+			memcpy(payload.data(), &id, sizeof(id));
+			memcpy(payload.data() + sizeof(id), fmt, strlen(fmt));
+			Entry(DefineFormat, payload.data(), static_cast<u32>(payload.size()));
+			return id;
+		}
+
+		void Switch(u32 thread)
+		{
+			Entry(SwitchThread, &thread, sizeof(thread));
+		}
+
+		void Record(u32 id, const u32* prefix_args, u32 prefix_count, ...)
+		{
+			std::vector<u8> record(sizeof(EntryHeader));
+			va_list list;
+			va_start(list, prefix_count);
+			EncodeArgs(m_specs[id], prefix_args, prefix_count, list, record);
+			va_end(list);
+
+			ASSERT_EQ(record.size() % 8, 0u);
+			const EntryHeader header = {static_cast<u32>(record.size()), id};
+			memcpy(record.data(), &header, sizeof(header));
+			m_data.insert(m_data.end(), record.begin(), record.end());
+		}
+
+		// Writes the file out and returns what the decoder makes of it.
+		std::string Decode(bool* success = nullptr)
+		{
+			const char* path = "trace_format_test.trace.gz";
+			gzFile file = gzopen(path, "wb");
+			EXPECT_NE(file, nullptr);
+			gzwrite(file, m_data.data(), static_cast<unsigned>(m_data.size()));
+			gzclose(file);
+
+			FILE* out = tmpfile();
+			const bool result = TraceFormat::Decode(path, out);
+			remove(path);
+			if (success)
+				*success = result;
+
+			std::string text(static_cast<size_t>(ftell(out)), 0);
+			rewind(out);
+			if (!text.empty())
+			{
+				EXPECT_EQ(fread(&text[0], 1, text.size(), out), text.size());
+			}
+			fclose(out);
+			return text;
+		}
+
+		void Truncate(size_t bytes)
+		{
+			m_data.resize(m_data.size() - bytes);
+		}
+	};
+} // namespace
+
+TEST(TraceFormatTest, ParseFormat)
+{
+	const std::vector<Spec> specs = ParseFormat("%d %5u %llx %zu %-*.*s %% %f %Lg %p %ls %c %n");
+	const ArgKind kinds[] = {ArgKind::Int, ArgKind::UInt, ArgKind::UInt64, ArgKind::SizeT, ArgKind::String,
+		ArgKind::Double, ArgKind::LongDouble, ArgKind::Pointer, ArgKind::Pointer, ArgKind::Int, ArgKind::Count};
+	ASSERT_EQ(specs.size(), std::size(kinds));
+	for (size_t i = 0; i < specs.size(); i++)
+		EXPECT_EQ(specs[i].kind, kinds[i]) << "spec " << i;
+
+	EXPECT_TRUE(specs[4].star_width);
+	EXPECT_TRUE(specs[4].star_precision);
+	EXPECT_EQ(specs[1].begin, 3u);
+	EXPECT_EQ(specs[1].end, 6u);
+	EXPECT_EQ(specs[9].conversion, 'c');
+}
+
+TEST(TraceFormatTest, RoundTrip)
+{
+	TraceWriter writer;
+	const u32 numbers = writer.Define("%d %u %x %08X %lld %llx %zu %c 100%%");
+	const u32 strings = writer.Define("[%s] [%-6s] [%.2s] [%*d] [%-*.*s]");
+	const u32 floats = writer.Define("%f %.3e %g %5.1Lf");
+
+	writer.Record(numbers, nullptr, 0, -5, 4000000000u, 0xbeefu, 0x1234u, -123456789012ll, 0xfedcba9876543210ull, static_cast<size_t>(42), 'q');
+	writer.Record(strings, nullptr, 0, "hello", "ab", "xyz", 6, -17, 8, 3, "abcdef");
+	writer.Record(strings, nullptr, 0, "", "", "", 0, 0, 0, 0, "");
+	writer.Record(floats, nullptr, 0, 3.25, -0.000125, 1e100, static_cast<long double>(2.5));
+
+	EXPECT_EQ(writer.Decode(),
+		"-5 4000000000 beef 00001234 -123456789012 fedcba9876543210 42 q 100%\n"
+		"[hello] [ab    ] [xy] [   -17] [abc     ]\n"
+		"[] [      ] [] [0] []\n"
+		"3.250000 -1.250e-04 1e+100   2.5\n");
+}
+
+TEST(TraceFormatTest, PrefixArgs)
+{
+	TraceWriter writer;
+	const u32 id = writer.Define("[%08x] %s=%d");
+
+	const u32 pc = 0x80001234;
+	writer.Record(id, &pc, 1, "v0", 7);
+
+	EXPECT_EQ(writer.Decode(), "[80001234] v0=7\n");
+}
+
+TEST(TraceFormatTest, LongStringsAreTruncated)
+{
+	TraceWriter writer;
+	const u32 id = writer.Define("%s|");
+
+	const std::string text(MaxStringLength + 100, 'a');
+	writer.Record(id, nullptr, 0, text.c_str());
+
+	EXPECT_EQ(writer.Decode(), std::string(MaxStringLength, 'a') + "|\n");
+}
+
+TEST(TraceFormatTest, ThreadSwitches)
+{
+	TraceWriter writer;
+	const u32 id = writer.Define("%u");
+
+	writer.Switch(0);
+	writer.Record(id, nullptr, 0, 1u);
+	writer.Switch(2);
+	writer.Record(id, nullptr, 0, 2u);
+	writer.Switch(2);
+	writer.Record(id, nullptr, 0, 3u);
+
+	EXPECT_EQ(writer.Decode(), "1\n---- thread 2 ----\n2\n3\n");
+}
+
+TEST(TraceFormatTest, TruncatedFile)
+{
+	TraceWriter writer;
+	const u32 id = writer.Define("%u %u");
+	writer.Record(id, nullptr, 0, 1u, 2u);
+	writer.Record(id, nullptr, 0, 3u, 4u);
+	writer.Truncate(4);
+
+	bool success = true;
+	EXPECT_EQ(writer.Decode(&success), "1 2\n");
+	EXPECT_FALSE(success);
+}
@@ -0,0 +1,96 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "GS/Renderers/Null/GSDeviceNull.h"
+#include <gtest/gtest.h>
+
+static constexpr size_t SurfaceSize(int w, int h)
+{
+	return static_cast<size_t>(w) * h * 4;
+}
+
+TEST(DevicePoolTest, ReusesSameSizeClass)
+{
+	GSDeviceNull dev;
+
+	GSTexture* t = dev.CreateRenderTarget(640, 448);
+	dev.Recycle(t);
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), SurfaceSize(640, 448));
+
+	// Other size classes don't take it
+	GSTexture* other = dev.CreateRenderTarget(640, 512);
+	EXPECT_NE(other, t);
+	GSTexture* depth = dev.CreateDepthStencil(640, 448);
+	EXPECT_NE(depth, t);
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), SurfaceSize(640, 448));
+
+	GSTexture* again = dev.CreateRenderTarget(640, 448);
+	EXPECT_EQ(again, t);
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), 0u);
+
+	delete again;
+	delete other;
+	delete depth;
+}
+
+TEST(DevicePoolTest, TrimEvictsLeastRecentlyRecycled)
+{
+	GSDeviceNull dev;
+
+	GSTexture* a = dev.CreateTexture(256, 256);
+	GSTexture* b = dev.CreateRenderTarget(512, 256);
+	GSTexture* c = dev.CreateTexture(256, 256);
+
+	dev.Recycle(a);
+	dev.AgePool();
+	dev.Recycle(b);
+	dev.AgePool();
+	dev.Recycle(c);
+
+	const size_t total = SurfaceSize(256, 256) * 2 + SurfaceSize(512, 256);
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), total);
+
+	// a is the oldest, across buckets
+	dev.TrimPool(total - 1);
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), total - SurfaceSize(256, 256));
+	GSTexture* reused = dev.CreateTexture(256, 256);
+	EXPECT_EQ(reused, c);
+	delete reused;
+
+	// Only b is left
+	dev.TrimPool(SurfaceSize(512, 256));
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), SurfaceSize(512, 256));
+	dev.TrimPool(0);
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), 0u);
+}
+
+TEST(DevicePoolTest, CountLimit)
+{
+	GSDeviceNull dev;
+
+	std::vector<GSTexture*> textures;
+	for (int i = 0; i < 310; i++)
+		textures.push_back(dev.CreateTexture(64, 64));
+
+	for (GSTexture* t : textures)
+		dev.Recycle(t);
+
+	// The pool holds 300 surfaces at most
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), SurfaceSize(64, 64) * 300);
+
+	dev.PurgePool();
+	EXPECT_EQ(dev.GetPoolMemoryUsage(), 0u);
+}
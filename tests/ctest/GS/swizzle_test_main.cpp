@@ -58,9 +58,9 @@ static void swizzleH(const uint8* table, uint32* dst, const uint8* src, int bpp,
 	}
 }
 
-static void expand16(uint32* dst, const uint16* src, const GIFRegTEXA& texa)
+static void expand16(uint32* dst, const uint16* src, const GIFRegTEXA& texa, int count = 128)
 {
-	for (int i = 0; i < 128; i++)
+	for (int i = 0; i < count; i++)
 	{
 		int r = (src[i] << 3) & 0x0000F8;
 		int g = (src[i] << 6) & 0x00F800;
@@ -510,3 +510,166 @@ TEST(WriteTest, Write4HL)
 		assertEqual(expected, data, "Write4HL", 8, 8, 32);
 	});
 }
+
+/// Scalar ReadCLUT_T32_I8, the low halves of the colors are at [0, 256), the high halves at [256, 512)
+static void readCLUT32(uint32* dst, const uint16* clut, int offset)
+{
+	for (int i = 0; i < 256; i++)
+	{
+		int src = std::min((i & ~15) + offset, 240) + (i & 15);
+		dst[i] = clut[src] | (clut[src + 256] << 16);
+	}
+}
+
+static void fillCLUT(uint16* clut, int count, unsigned int seed)
+{
+	srand(seed);
+	for (int i = 0; i < count; i++)
+		clut[i] = (i % 7 == 0) ? 0 : rand();
+}
+
+TEST(ClutTest, Expand16)
+{
+	alignas(32) uint16 src[256];
+	fillCLUT(src, 256, 1);
+
+	for (int aem = 0; aem < 2; aem++)
+	{
+		for (int w : {16, 256})
+		{
+			GIFRegTEXA texa = {0};
+			texa.TA0 = 0x12;
+			texa.TA1 = 0x9A;
+			texa.AEM = aem;
+
+			alignas(32) uint32 expected[256] = {};
+			alignas(32) uint32 actual[256] = {};
+			expand16(expected, src, texa, w);
+			GSClut::Expand16(src, actual, w, texa);
+			for (int i = 0; i < 256; i++)
+				ASSERT_EQ(expected[i], actual[i]) << "Expand16 entry " << i << ", width " << w << ", AEM " << aem;
+		}
+	}
+}
+
+TEST(ClutTest, ReadCLUT32)
+{
+	alignas(32) uint16 clut[512];
+	fillCLUT(clut, 512, 2);
+
+	// Also covers ReadCLUT_T32_I4, which reads each row of 16 colors
+	for (int offset : {0, 16, 80, 240})
+	{
+		alignas(32) uint32 expected[256];
+		alignas(32) uint32 actual[256];
+		readCLUT32(expected, clut, offset);
+		GSClut::ReadCLUT_T32_I8(clut, actual, offset);
+		for (int i = 0; i < 256; i++)
+			ASSERT_EQ(expected[i], actual[i]) << "ReadCLUT_T32_I8 entry " << i << ", offset " << offset;
+	}
+}
+
+static void expectClut(const GSClut& clut, const uint32* expected, int count, const char* name)
+{
+	const uint32* actual = clut;
+	for (int i = 0; i < count; i++)
+		ASSERT_EQ(expected[i], actual[i]) << name << " entry " << i;
+}
+
+static void expectClut32I4(GSClut& clut, int csa)
+{
+	GIFRegTEX0 TEX0 = {0};
+	TEX0.PSM = PSM_PSMT4;
+	TEX0.CPSM = PSM_PSMCT32;
+	TEX0.CSA = csa;
+	GIFRegTEXA TEXA = {0};
+	clut.Read32(TEX0, TEXA);
+
+	const uint16* buffer = clut.GetBuffer();
+	uint32 expected[16];
+	for (int i = 0; i < 16; i++)
+		expected[i] = buffer[csa * 16 + i] | (buffer[csa * 16 + i + 256] << 16);
+	expectClut(clut, expected, 16, "Read32 T32 I4");
+}
+
+static void expectClut16I8(GSClut& clut, const GIFRegTEXA& TEXA)
+{
+	GIFRegTEX0 TEX0 = {0};
+	TEX0.PSM = PSM_PSMT8;
+	TEX0.CPSM = PSM_PSMCT16;
+	clut.Read32(TEX0, TEXA);
+
+	uint32 expected[256];
+	expand16(expected, clut.GetBuffer(), TEXA, 256);
+	expectClut(clut, expected, 256, "Read32 T16 I8");
+}
+
+TEST(ClutTest, ReadCacheHit)
+{
+	GSClut clut(nullptr);
+	fillCLUT(clut.GetBuffer(), 1024, 3);
+
+	// Switching back and forth between palettes which are all cached
+	for (int round = 0; round < 3; round++)
+	{
+		for (int csa = 0; csa < 8; csa++)
+			expectClut32I4(clut, csa);
+	}
+}
+
+TEST(ClutTest, ReadCacheMiss)
+{
+	GSClut clut(nullptr);
+	uint16* buffer = clut.GetBuffer();
+	fillCLUT(buffer, 1024, 4);
+
+	expectClut32I4(clut, 1);
+	expectClut32I4(clut, 2);
+
+	// Same registers, different colors, in either half of a 32 bit entry
+	buffer[16 + 3] ^= 0x1234;
+	expectClut32I4(clut, 2);
+	expectClut32I4(clut, 1);
+	buffer[16 + 256 + 15] ^= 0x8001;
+	expectClut32I4(clut, 2);
+	expectClut32I4(clut, 1);
+
+	// And back to colors which were cached before
+	buffer[16 + 3] ^= 0x1234;
+	buffer[16 + 256 + 15] ^= 0x8001;
+	expectClut32I4(clut, 2);
+	expectClut32I4(clut, 1);
+
+	// The same colors with another TEXA don't come out the same
+	GIFRegTEXA TEXA = {0};
+	TEXA.TA0 = 0x10;
+	TEXA.TA1 = 0x80;
+	expectClut16I8(clut, TEXA);
+	TEXA.AEM = 1;
+	expectClut16I8(clut, TEXA);
+	TEXA.TA1 = 0x7F;
+	expectClut16I8(clut, TEXA);
+	TEXA.AEM = 0;
+	expectClut16I8(clut, TEXA);
+}
+
+TEST(ClutTest, ReadCacheEviction)
+{
+	GSClut clut(nullptr);
+	uint16* buffer = clut.GetBuffer();
+	fillCLUT(buffer, 1024, 5);
+
+	// More palettes than cache entries, so some of them share an entry
+	GIFRegTEXA TEXA = {0};
+	TEXA.TA0 = 0x40;
+	for (int round = 0; round < 2; round++)
+	{
+		for (int i = 0; i < 40; i++)
+		{
+			buffer[0] = i;
+			TEXA.TA1 = i;
+			expectClut16I8(clut, TEXA);
+			expectClut32I4(clut, i & 15);
+		}
+	}
+}
@@ -22,12 +22,13 @@
 
 GSLocalMemory::psm_t GSLocalMemory::m_psm[64];
 
+// GSClut allocates its buffers with these
 void* vmalloc(size_t size, bool code)
 {
-	abort();
+	return _aligned_malloc(size, 4096);
 }
 
 void vmfree(void* ptr, size_t size)
 {
-	abort();
+	_aligned_free(ptr);
 }
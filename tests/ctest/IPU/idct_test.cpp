@@ -0,0 +1,105 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "Common.h"
+#include "IPU/IPU.h"
+#include "IPU/mpeg2lib/Mpeg.h"
+#include <gtest/gtest.h>
+#include <random>
+
+struct alignas(16) Block
+{
+	s16 coeffs[64];
+};
+
+static void ExpectSameIdct(const Block& input)
+{
+	Block expected = input;
+	mpeg2_idct_reference(expected.coeffs);
+
+	// Add path: the IDCT output as is
+	Block block = input;
+	alignas(16) s16 dest[64];
+	mpeg2_idct_add(0, block.coeffs, dest, 8);
+
+	for (int i = 0; i < 64; i++)
+	{
+		ASSERT_EQ(expected.coeffs[i], dest[i]) << "add, coefficient " << i;
+		ASSERT_EQ(0, block.coeffs[i]) << "add, block not cleared at " << i;
+	}
+
+	// Copy path: clamped to 0-255
+	block = input;
+	alignas(16) u8 pixels[64];
+	mpeg2_idct_copy(block.coeffs, pixels, 8);
+
+	for (int i = 0; i < 64; i++)
+	{
+		ASSERT_EQ(std::min(std::max<int>(expected.coeffs[i], 0), 255), pixels[i]) << "copy, pixel " << i;
+		ASSERT_EQ(0, block.coeffs[i]) << "copy, block not cleared at " << i;
+	}
+}
+
+TEST(IdctTest, MatchesReference)
+{
+	std::mt19937 rng(0);
+	std::uniform_int_distribution<int> coeff(-2048, 2047);
+	std::uniform_int_distribution<int> index(0, 63);
+
+	for (int round = 0; round < 100000; round++)
+	{
+		Block block = {};
+
+		// Mostly sparse blocks like real streams, sometimes dense ones
+		const int count = (round & 7) ? 1 + (round & 15) : 64;
+		for (int i = 0; i < count; i++)
+			block.coeffs[index(rng)] = coeff(rng);
+
+		ExpectSameIdct(block);
+		if (HasFatalFailure())
+			return;
+	}
+}
+
+TEST(IdctTest, MatchesReferenceFullRange)
+{
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> coeff(-0x8000, 0x7fff);
+
+	for (int round = 0; round < 20000; round++)
+	{
+		Block block;
+		for (s16& c : block.coeffs)
+			c = coeff(rng);
+
+		ExpectSameIdct(block);
+		if (HasFatalFailure())
+			return;
+	}
+}
+
+TEST(IdctTest, DcOnly)
+{
+	for (int dc = -2048; dc < 2048; dc++)
+	{
+		Block block = {};
+		block.coeffs[0] = dc;
+
+		ExpectSameIdct(block);
+		if (HasFatalFailure())
+			return;
+	}
+}
@@ -0,0 +1,41 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This file defines functions that are linked to by files used in idct tests but not actually used in idct tests, in order to make linkers happy
+
+#include "PrecompiledHeader.h"
+#include "Common.h"
+
+__pagealigned u8 eeHw[Ps2MemSize::Hardware];
+
+RETURNS_R64 vtlb_memRead64(u32 mem)
+{
+	abort();
+}
+
+RETURNS_R128 vtlb_memRead128(u32 mem)
+{
+	abort();
+}
+
+void __fastcall vtlb_memWrite64(u32 mem, const mem64_t* value)
+{
+	abort();
+}
+
+void __fastcall vtlb_memWrite128(u32 mem, const mem128_t* value)
+{
+	abort();
+}
@@ -0,0 +1,50 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Converts a binary trace log written with EmuCore/TraceLog Binary=enabled back to the
+// text which would have been written to emuLog.txt.
+//
+//   tracedecode emuLog.trace.gz [output.txt]
+
+#include "pcsx2/DebugTools/TraceFormat.h"
+
+#include <cstdio>
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "Usage: %s <trace file> [output file]\n", argv[0]);
+		return 1;
+	}
+
+	FILE* out = stdout;
+	if (argc == 3)
+	{
+		out = fopen(argv[2], "w");
+		if (!out)
+		{
+			fprintf(stderr, "Failed to open %s for writing\n", argv[2]);
+			return 1;
+		}
+	}
+
+	const bool result = TraceFormat::Decode(argv[1], out);
+
+	if (out != stdout)
+		fclose(out);
+
+	return result ? 0 : 1;
+}